@@ -0,0 +1,34 @@
+/**
+ * @file link_ack.cpp
+ * @brief S2B_ACK payload parsing.
+ */
+
+#include "link_ack.h"
+#include "link_wire.h"
+
+namespace s2t {
+namespace link {
+
+AckStatus ack_parse(const uint8_t* payload, std::size_t payload_len, Ack* out)
+{
+    if (!payload || !out) {
+        return AckStatus::ERR_NULL;
+    }
+    if (payload_len != ACK_PAYLOAD_SIZE_BYTES) {
+        return AckStatus::ERR_LENGTH;
+    }
+    if (payload[1] != ACK_LAYOUT_VERSION) {
+        return AckStatus::ERR_LAYOUT_VERSION;
+    }
+
+    out->acked_msg_type = payload[0];
+    out->acked_seq = static_cast<uint16_t>(get_u16_le(payload + 2));
+    out->spine_rx_time_us = get_u32_le(payload + 4);
+    out->spine_tx_time_us = get_u32_le(payload + 8);
+    out->echo = static_cast<uint64_t>(get_u32_le(payload + 12)) |
+                (static_cast<uint64_t>(get_u32_le(payload + 16)) << 32);
+    return AckStatus::OK;
+}
+
+} // namespace link
+} // namespace s2t
@@ -0,0 +1,47 @@
+#ifndef LINK_ACK_H
+#define LINK_ACK_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file link_ack.h
+ * @brief Decoder for S2B_ACK, the Spine's reply to B2S_HEARTBEAT and B2S_HELLO.
+ *
+ * The Spine acknowledges each HEARTBEAT and HELLO it dispatches with the
+ * request's type and seq, its own receive and transmit timestamps
+ * (time_us_32, wrapping) and the first ACK_ECHO_BYTES of the request
+ * payload. Round-trip tools put their send timestamp there. Layout
+ * mirrors spine/spine_ack.h (layout version 1) and must change with it;
+ * contract v0.2 names S2B_ACK but does not fix its payload, so this is
+ * provisional.
+ */
+
+namespace s2t {
+namespace link {
+
+static constexpr uint8_t ACK_LAYOUT_VERSION = 1;
+static constexpr std::size_t ACK_PAYLOAD_SIZE_BYTES = 20;
+static constexpr std::size_t ACK_ECHO_BYTES = 8;
+
+enum class AckStatus : uint32_t {
+    OK = 0,
+    ERR_NULL,
+    ERR_LENGTH,
+    ERR_LAYOUT_VERSION
+};
+
+struct Ack {
+    uint8_t  acked_msg_type;
+    uint16_t acked_seq;
+    uint32_t spine_rx_time_us;   // request dispatched (Spine clock)
+    uint32_t spine_tx_time_us;   // ACK encoded (Spine clock)
+    uint64_t echo;               // request payload bytes 0..7, little-endian
+};
+
+AckStatus ack_parse(const uint8_t* payload, std::size_t payload_len, Ack* out);
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_ACK_H
@@ -0,0 +1,229 @@
+/**
+ * @file link_clock_sync.cpp
+ * @brief Min-delay filtered offset/drift fit for the Spine clock.
+ */
+
+#include "link_clock_sync.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "link_timing_constants.h"
+
+namespace s2t {
+namespace link {
+
+static constexpr double PPB_PER_UNIT = 1e9;
+
+static uint64_t abs_diff_ns(int64_t a, int64_t b)
+{
+    return (a > b) ? static_cast<uint64_t>(a - b) : static_cast<uint64_t>(b - a);
+}
+
+bool clock_spine_to_brain_ns(const ClockEstimate& estimate, uint32_t spine_us,
+                             uint64_t* brain_ns, uint64_t* error_bound_ns)
+{
+    if (estimate.point_count == 0 || !brain_ns) {
+        return false;
+    }
+
+    // Nearest unwrapping of the 32-bit tick around the reference.
+    const int64_t dt_us = static_cast<int32_t>(spine_us - static_cast<uint32_t>(estimate.ref_spine_us));
+    const int64_t dt_ns = dt_us * static_cast<int64_t>(NS_PER_US);
+    const int64_t brain = static_cast<int64_t>(estimate.ref_brain_ns) + dt_ns +
+                          dt_ns / 1000 * estimate.drift_ppb / 1000000;
+    if (brain < 0) {
+        return false;
+    }
+
+    *brain_ns = static_cast<uint64_t>(brain);
+    if (error_bound_ns) {
+        const uint64_t span_ns = static_cast<uint64_t>(dt_ns < 0 ? -dt_ns : dt_ns);
+        *error_bound_ns = estimate.error_bound_ns +
+                          span_ns / 1000 * (estimate.drift_error_ppb + CLOCK_SYNC_WANDER_PPB) / 1000000;
+    }
+    return true;
+}
+
+ClockSync::ClockSync()
+{
+    std::memset(&counters_, 0, sizeof(counters_));
+    reset();
+}
+
+void ClockSync::reset()
+{
+    point_count_ = 0;
+    point_next_ = 0;
+    epoch_samples_ = 0;
+    have_spine_ = false;
+    last_spine_us_ = 0;
+    std::memset(&epoch_best_, 0, sizeof(epoch_best_));
+    std::memset(&estimate_, 0, sizeof(estimate_));
+}
+
+uint64_t ClockSync::unwrap_spine_us(uint32_t spine_us)
+{
+    if (!have_spine_) {
+        have_spine_ = true;
+        last_spine_us_ = spine_us;
+        return last_spine_us_;
+    }
+    const int64_t step = static_cast<int32_t>(spine_us - static_cast<uint32_t>(last_spine_us_));
+    last_spine_us_ = static_cast<uint64_t>(static_cast<int64_t>(last_spine_us_) + step);
+    return last_spine_us_;
+}
+
+bool ClockSync::add_exchange(uint64_t brain_send_ns, uint32_t spine_rx_us, uint32_t spine_tx_us,
+                             uint64_t brain_recv_ns)
+{
+    const uint64_t hold_ns = static_cast<uint64_t>(spine_tx_us - spine_rx_us) * NS_PER_US;
+    if (brain_recv_ns < brain_send_ns || hold_ns > brain_recv_ns - brain_send_ns) {
+        counters_.rejected_count++;
+        return false;
+    }
+    counters_.exchange_count++;
+
+    const uint64_t rtt_ns = brain_recv_ns - brain_send_ns;
+    const uint64_t brain_mid_ns = brain_send_ns + rtt_ns / 2;
+
+    Point point;
+    point.delay_ns = rtt_ns - hold_ns;
+    point.spine_ns = unwrap_spine_us(spine_rx_us) * NS_PER_US + hold_ns / 2;
+    point.offset_ns = static_cast<int64_t>(brain_mid_ns) - static_cast<int64_t>(point.spine_ns);
+
+    if (estimate_.point_count > 0) {
+        uint64_t predicted_ns = 0;
+        const bool mapped = clock_spine_to_brain_ns(estimate_, spine_rx_us, &predicted_ns, nullptr);
+        const int64_t observed_ns = static_cast<int64_t>(brain_mid_ns) - static_cast<int64_t>(hold_ns / 2);
+        if (!mapped || abs_diff_ns(observed_ns, static_cast<int64_t>(predicted_ns)) >
+                           static_cast<uint64_t>(CLOCK_SYNC_STEP_RESET_NS) + point.delay_ns) {
+            // The Spine clock restarted; nothing before this exchange applies.
+            counters_.reset_count++;
+            reset();
+            point.spine_ns = unwrap_spine_us(spine_rx_us) * NS_PER_US + hold_ns / 2;
+            point.offset_ns = static_cast<int64_t>(brain_mid_ns) - static_cast<int64_t>(point.spine_ns);
+        }
+    }
+
+    if (epoch_samples_ == 0 || point.delay_ns < epoch_best_.delay_ns) {
+        epoch_best_ = point;
+    }
+    if (++epoch_samples_ < CLOCK_SYNC_EPOCH_SAMPLES) {
+        return false;
+    }
+
+    points_[point_next_] = epoch_best_;
+    point_next_ = (point_next_ + 1) % CLOCK_SYNC_FIT_POINTS;
+    if (point_count_ < CLOCK_SYNC_FIT_POINTS) {
+        point_count_++;
+    }
+    epoch_samples_ = 0;
+    refit();
+    return true;
+}
+
+void ClockSync::refit()
+{
+    uint64_t delays_ns[CLOCK_SYNC_FIT_POINTS] = {};
+    for (uint32_t i = 0; i < point_count_; ++i) {
+        delays_ns[i] = points_[i].delay_ns;
+    }
+    std::sort(delays_ns, delays_ns + point_count_);
+    const uint64_t min_delay_ns = delays_ns[0];
+    const uint64_t median_delay_ns = delays_ns[(point_count_ - 1) / 2];
+
+    // The median keeps half the window in the fit when jitter dwarfs the
+    // best delay, so the drift span never collapses to one point.
+    uint64_t gate_ns = ((min_delay_ns > NS_PER_US) ? min_delay_ns : NS_PER_US) * CLOCK_SYNC_DELAY_GATE;
+    gate_ns = (median_delay_ns > gate_ns) ? median_delay_ns : gate_ns;
+
+    // Walk newest to oldest: the reference is the newest point that passes
+    // the gate, the oldest one bounds the drift error.
+    bool used[CLOCK_SYNC_FIT_POINTS] = {};
+    uint32_t used_count = 0;
+    uint32_t newest = 0;
+    uint32_t oldest = 0;
+    for (uint32_t k = 0; k < point_count_; ++k) {
+        const uint32_t i = (point_next_ + CLOCK_SYNC_FIT_POINTS - 1 - k) % CLOCK_SYNC_FIT_POINTS;
+        if (points_[i].delay_ns > gate_ns) {
+            continue;
+        }
+        used[i] = true;
+        if (used_count++ == 0) {
+            newest = i;
+        }
+        oldest = i;
+    }
+    const uint64_t ref_spine_ns = points_[newest].spine_ns;
+    const uint64_t span_ns = ref_spine_ns - points_[oldest].spine_ns;
+
+    // Whole microseconds so ClockEstimate can carry the reference as a tick.
+    const uint64_t ref_us = ref_spine_ns / NS_PER_US;
+    const int64_t ref_ns = static_cast<int64_t>(ref_us * NS_PER_US);
+
+    // Offsets are taken relative to the newest point so doubles keep ns
+    // resolution however long either clock has been running.
+    const int64_t offset_base = points_[(point_next_ + CLOCK_SYNC_FIT_POINTS - 1) % CLOCK_SYNC_FIT_POINTS].offset_ns;
+    double mean_x = 0.0;
+    double mean_y = 0.0;
+    for (uint32_t i = 0; i < point_count_; ++i) {
+        if (used[i]) {
+            mean_x += static_cast<double>(static_cast<int64_t>(points_[i].spine_ns) - ref_ns);
+            mean_y += static_cast<double>(points_[i].offset_ns - offset_base);
+        }
+    }
+    mean_x /= used_count;
+    mean_y /= used_count;
+
+    double slope = 0.0;
+    const bool fit_drift = used_count >= 2 && span_ns >= CLOCK_SYNC_MIN_DRIFT_SPAN_NS;
+    if (fit_drift) {
+        double sxx = 0.0;
+        double sxy = 0.0;
+        for (uint32_t i = 0; i < point_count_; ++i) {
+            if (used[i]) {
+                const double dx = static_cast<double>(static_cast<int64_t>(points_[i].spine_ns) - ref_ns) - mean_x;
+                const double dy = static_cast<double>(points_[i].offset_ns - offset_base) - mean_y;
+                sxx += dx * dx;
+                sxy += dx * dy;
+            }
+        }
+        slope = sxy / sxx;
+        const double max_slope = static_cast<double>(CLOCK_SYNC_MAX_DRIFT_PPB) / PPB_PER_UNIT;
+        slope = (slope > max_slope) ? max_slope : (slope < -max_slope) ? -max_slope : slope;
+    }
+
+    // Fitted offset at the reference tick (x = 0).
+    const double fit_at_ref = mean_y - slope * mean_x;
+
+    // Fit error bound at point i (see header).
+    auto point_bound_ns = [&](uint32_t i) {
+        const double x = static_cast<double>(static_cast<int64_t>(points_[i].spine_ns) - ref_ns);
+        const double residual = static_cast<double>(points_[i].offset_ns - offset_base) - (fit_at_ref + slope * x);
+        return points_[i].delay_ns / 2 + static_cast<uint64_t>(std::ceil(std::fabs(residual))) +
+               CLOCK_SYNC_TICK_ALLOWANCE_NS;
+    };
+    const uint64_t error_ns = point_bound_ns(newest);
+
+    uint64_t drift_error_ppb = static_cast<uint64_t>(CLOCK_SYNC_MAX_DRIFT_PPB);
+    if (fit_drift) {
+        const double bound = static_cast<double>(point_bound_ns(newest) + point_bound_ns(oldest));
+        const double ppb = std::ceil(bound / static_cast<double>(span_ns) * PPB_PER_UNIT);
+        drift_error_ppb = (ppb < static_cast<double>(CLOCK_SYNC_MAX_DRIFT_PPB))
+                              ? static_cast<uint64_t>(ppb)
+                              : static_cast<uint64_t>(CLOCK_SYNC_MAX_DRIFT_PPB);
+    }
+
+    estimate_.ref_spine_us = ref_us;
+    estimate_.ref_brain_ns = static_cast<uint64_t>(ref_ns + offset_base + static_cast<int64_t>(std::llround(fit_at_ref)));
+    estimate_.drift_ppb = static_cast<int64_t>(std::llround(slope * PPB_PER_UNIT));
+    estimate_.drift_error_ppb = drift_error_ppb;
+    estimate_.error_bound_ns = error_ns;
+    estimate_.min_delay_ns = min_delay_ns;
+    estimate_.point_count = used_count;
+}
+
+} // namespace link
+} // namespace s2t
@@ -0,0 +1,129 @@
+#ifndef LINK_CLOCK_SYNC_H
+#define LINK_CLOCK_SYNC_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file link_clock_sync.h
+ * @brief Spine tick -> Brain CLOCK_MONOTONIC mapping from HEARTBEAT/ACK exchanges.
+ *
+ * Each B2S_HEARTBEAT carries its Brain send time t1; the Spine's S2B_ACK
+ * returns it with the Spine dispatch and send times t2, t3 (time_us_32).
+ * With t4 the Brain receive time, one exchange gives the NTP pair
+ *
+ *   spine = (t2 + t3) / 2,  brain = (t1 + t4) / 2,  delay = (t4 - t1) - (t3 - t2)
+ *
+ * which is exact for a symmetric path and off by at most delay / 2
+ * otherwise. Queueing only ever adds delay, so the estimator keeps the
+ * minimum-delay exchange of every CLOCK_SYNC_EPOCH_SAMPLES and fits
+ * offset and drift (least squares) through the last CLOCK_SYNC_FIT_POINTS
+ * of those, skipping points whose delay exceeds both
+ * CLOCK_SYNC_DELAY_GATE times the window's best and the window median.
+ *
+ * Error bound: with a constant drift, the fit error is linear in time and
+ * at every point used is at most delay / 2 + |residual| (+ tick
+ * truncation). So the bound at the reference point is that point's own,
+ * and the drift error is at most the sum of the two extreme points'
+ * bounds over their distance. A conversion dt away from the reference
+ * adds dt * (drift_error_ppb + CLOCK_SYNC_WANDER_PPB). Until the fit
+ * spans CLOCK_SYNC_MIN_DRIFT_SPAN_NS, drift is reported as 0 with
+ * CLOCK_SYNC_MAX_DRIFT_PPB of error.
+ *
+ * Spine ticks are 32-bit microseconds and wrap every ~71 minutes; they are
+ * unwrapped against the reference, so a converted tick must lie within
+ * +-35 minutes of it. A Spine reboot shows up as an offset step larger
+ * than CLOCK_SYNC_STEP_RESET_NS and restarts the estimate.
+ *
+ * ClockSync has one owner (the tty reader). ClockEstimate is plain data
+ * and can be copied to other threads or processes (link_telemetry_shm).
+ */
+
+namespace s2t {
+namespace link {
+
+static constexpr uint32_t CLOCK_SYNC_EPOCH_SAMPLES = 8;
+static constexpr uint32_t CLOCK_SYNC_FIT_POINTS = 32;
+static constexpr uint32_t CLOCK_SYNC_DELAY_GATE = 2;
+// Fits spanning less Spine time than this report zero drift.
+static constexpr uint64_t CLOCK_SYNC_MIN_DRIFT_SPAN_NS = 2000000000ULL;
+// Crystal drift beyond this means bad data, not a clock.
+static constexpr int64_t CLOCK_SYNC_MAX_DRIFT_PPB = 500000;
+// Unmodelled drift change (temperature) allowed for when extrapolating.
+static constexpr uint64_t CLOCK_SYNC_WANDER_PPB = 1000;
+static constexpr int64_t CLOCK_SYNC_STEP_RESET_NS = 50000000;
+// t2 and t3 are truncated to whole microseconds.
+static constexpr uint64_t CLOCK_SYNC_TICK_ALLOWANCE_NS = 2000;
+
+/**
+ * Current mapping. brain_ns = ref_brain_ns + dt * (1 + drift_ppb / 1e9)
+ * with dt = spine time - ref_spine_us, in ns.
+ */
+struct ClockEstimate {
+    uint64_t ref_spine_us;      // unwrapped Spine time of the reference point
+    uint64_t ref_brain_ns;      // Brain CLOCK_MONOTONIC at ref_spine_us
+    int64_t  drift_ppb;         // Spine slow (+) or fast (-) relative to the Brain
+    uint64_t drift_error_ppb;   // bound on |drift_ppb - true drift|
+    uint64_t error_bound_ns;    // at the reference point
+    uint64_t min_delay_ns;      // best exchange in the fit window
+    uint32_t point_count;       // fit points in use; 0 = no estimate yet
+    uint32_t reserved;
+};
+
+struct ClockSyncCounters {
+    uint64_t exchange_count;
+    uint64_t rejected_count;    // inconsistent timestamps
+    uint64_t reset_count;       // offset steps (Spine reboot)
+};
+
+/**
+ * Convert a Spine time_us_32 value to Brain CLOCK_MONOTONIC ns.
+ * Returns false if `estimate` has no fit points yet.
+ */
+bool clock_spine_to_brain_ns(const ClockEstimate& estimate, uint32_t spine_us,
+                             uint64_t* brain_ns, uint64_t* error_bound_ns);
+
+class ClockSync {
+public:
+    ClockSync();
+
+    void reset();
+
+    /**
+     * Feed one exchange. Returns true if it closed an epoch and the
+     * estimate changed.
+     */
+    bool add_exchange(uint64_t brain_send_ns, uint32_t spine_rx_us, uint32_t spine_tx_us,
+                      uint64_t brain_recv_ns);
+
+    const ClockEstimate& estimate() const { return estimate_; }
+    const ClockSyncCounters& counters() const { return counters_; }
+
+private:
+    struct Point {
+        uint64_t spine_ns;      // unwrapped
+        int64_t  offset_ns;     // brain - spine
+        uint64_t delay_ns;
+    };
+
+    uint64_t unwrap_spine_us(uint32_t spine_us);
+    void refit();
+
+    Point points_[CLOCK_SYNC_FIT_POINTS];
+    uint32_t point_count_;
+    uint32_t point_next_;
+
+    Point epoch_best_;
+    uint32_t epoch_samples_;
+
+    bool have_spine_;
+    uint64_t last_spine_us_;
+
+    ClockEstimate estimate_;
+    ClockSyncCounters counters_;
+};
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_CLOCK_SYNC_H
@@ -0,0 +1,220 @@
+/**
+ * @file link_clock_sync_bench.cpp
+ * @brief ClockSync against a simulated drifting Spine clock. No hardware.
+ *
+ * Usage:
+ *   link_clock_sync_bench [--drift-ppm N] [--period-ms N] [--base-delay-us N]
+ *                         [--jitter-us N] [--hours N] [--reboot-at-s N] [--seed N]
+ *
+ * Simulated time only, so hours of exchanges run in seconds. The Spine
+ * clock runs --drift-ppm slow (negative: fast) and starts ten seconds
+ * before its 32-bit microsecond wrap. Each direction of an exchange takes
+ * --base-delay-us plus an exponential queueing delay with mean
+ * --jitter-us, drawn independently, so paths are asymmetric.
+ *
+ * After every exchange the bench converts a random Spine tick from the
+ * last second with the current estimate and compares it to the true
+ * Brain time. It reports the worst and p99 conversion error, the bound
+ * the estimator claimed, the fitted drift and every conversion whose
+ * error exceeded its bound. Exit status 1 if any did.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "link_clock_sync.h"
+#include "link_timing_constants.h"
+
+using namespace s2t::link;
+
+static constexpr uint64_t NS_PER_MS = NS_PER_US * US_PER_MS;
+static constexpr uint64_t SPINE_WRAP_US = 1ULL << 32;
+static constexpr uint64_t START_BEFORE_WRAP_US = 10ULL * 1000000ULL;
+static constexpr uint64_t BRAIN_START_NS = 86400ULL * NS_PER_S;   // a day of uptime
+static constexpr uint32_t MIN_HOLD_US = 5;
+static constexpr uint32_t MAX_HOLD_US = 200;
+
+/**
+ * Spine clock as a function of Brain time: restarts at `epoch_brain_ns`
+ * from `start_spine_ns` and runs at `rate` Spine ns per Brain ns.
+ */
+struct SimSpine {
+    double rate;
+    uint64_t epoch_brain_ns;
+    uint64_t start_spine_ns;
+
+    uint64_t spine_ns(uint64_t brain_ns) const
+    {
+        return start_spine_ns +
+               static_cast<uint64_t>(static_cast<double>(brain_ns - epoch_brain_ns) * rate);
+    }
+
+    uint32_t tick(uint64_t brain_ns) const
+    {
+        return static_cast<uint32_t>((spine_ns(brain_ns) / NS_PER_US) % SPINE_WRAP_US);
+    }
+
+    // Brain time at which the Spine reads `spine_ns_value`.
+    double brain_at(uint64_t spine_ns_value) const
+    {
+        return static_cast<double>(epoch_brain_ns) +
+               static_cast<double>(spine_ns_value - start_spine_ns) / rate;
+    }
+};
+
+static void print_usage(const char* argv0)
+{
+    std::fprintf(stderr,
+                 "usage: %s [--drift-ppm N] [--period-ms N] [--base-delay-us N] [--jitter-us N]\n"
+                 "       [--hours N] [--reboot-at-s N] [--seed N]\n",
+                 argv0);
+}
+
+int main(int argc, char** argv)
+{
+    double drift_ppm = 30.0;
+    double period_ms = B2S_HEARTBEAT_PERIOD_MS;
+    double base_delay_us = 150.0;
+    double jitter_us = 400.0;
+    double hours = 2.0;
+    double reboot_at_s = -1.0;
+    unsigned long seed = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return 2;
+        }
+        const char* value = argv[i + 1];
+        if (std::strcmp(argv[i], "--drift-ppm") == 0) {
+            drift_ppm = std::atof(value);
+        } else if (std::strcmp(argv[i], "--period-ms") == 0) {
+            period_ms = std::atof(value);
+        } else if (std::strcmp(argv[i], "--base-delay-us") == 0) {
+            base_delay_us = std::atof(value);
+        } else if (std::strcmp(argv[i], "--jitter-us") == 0) {
+            jitter_us = std::atof(value);
+        } else if (std::strcmp(argv[i], "--hours") == 0) {
+            hours = std::atof(value);
+        } else if (std::strcmp(argv[i], "--reboot-at-s") == 0) {
+            reboot_at_s = std::atof(value);
+        } else if (std::strcmp(argv[i], "--seed") == 0) {
+            seed = std::strtoul(value, nullptr, 10);
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+    if (period_ms <= 0.0 || base_delay_us < 0.0 || jitter_us <= 0.0 || hours <= 0.0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    std::mt19937_64 rng(seed);
+    std::exponential_distribution<double> queueing(1.0 / (jitter_us * NS_PER_US));
+    std::uniform_int_distribution<uint32_t> hold_us(MIN_HOLD_US, MAX_HOLD_US);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    SimSpine spine;
+    spine.rate = 1.0 - drift_ppm * 1e-6;
+    spine.epoch_brain_ns = BRAIN_START_NS;
+    spine.start_spine_ns = (SPINE_WRAP_US - START_BEFORE_WRAP_US) * NS_PER_US;
+
+    const uint64_t period_ns = static_cast<uint64_t>(period_ms * NS_PER_MS);
+    const uint64_t end_ns = BRAIN_START_NS + static_cast<uint64_t>(hours * 3600.0 * NS_PER_S);
+    uint64_t reboot_ns = (reboot_at_s >= 0.0)
+                                   ? BRAIN_START_NS + static_cast<uint64_t>(reboot_at_s * NS_PER_S)
+                                   : UINT64_MAX;
+    const uint64_t base_ns = static_cast<uint64_t>(base_delay_us * NS_PER_US);
+
+    ClockSync clock;
+    std::vector<uint64_t> errors_ns;
+    uint64_t worst_error_ns = 0;
+    uint64_t worst_bound_ns = 0;
+    uint64_t bound_sum_ns = 0;
+    uint64_t violation_count = 0;
+    uint64_t first_estimate_ns = 0;
+
+    for (uint64_t t1 = BRAIN_START_NS; t1 < end_ns; t1 += period_ns) {
+        if (t1 >= reboot_ns) {
+            spine.epoch_brain_ns = reboot_ns;
+            spine.start_spine_ns = 0;
+            reboot_ns = UINT64_MAX;
+        }
+
+        const uint64_t d_forward = base_ns + static_cast<uint64_t>(queueing(rng));
+        const uint64_t hold = static_cast<uint64_t>(hold_us(rng)) * NS_PER_US;
+        const uint64_t d_back = base_ns + static_cast<uint64_t>(queueing(rng));
+        const uint64_t t2_brain = t1 + d_forward;
+        const uint64_t t3_brain = t2_brain + hold;
+        const uint64_t t4 = t3_brain + d_back;
+
+        clock.add_exchange(t1, spine.tick(t2_brain), spine.tick(t3_brain), t4);
+
+        const ClockEstimate& est = clock.estimate();
+        if (est.point_count == 0) {
+            continue;
+        }
+        if (first_estimate_ns == 0) {
+            first_estimate_ns = t4 - BRAIN_START_NS;
+        }
+
+        // A tick from the last second (since the reboot, if sooner).
+        const uint64_t window_lo = std::max(t4 - std::min<uint64_t>(t4, NS_PER_S), spine.epoch_brain_ns);
+        const uint64_t probe_brain = window_lo + static_cast<uint64_t>(unit(rng) * static_cast<double>(t4 - window_lo));
+        const uint64_t probe_spine_ns = spine.spine_ns(probe_brain) / NS_PER_US * NS_PER_US;
+        const uint32_t probe_tick = static_cast<uint32_t>((probe_spine_ns / NS_PER_US) % SPINE_WRAP_US);
+
+        uint64_t mapped_ns = 0;
+        uint64_t bound_ns = 0;
+        if (!clock_spine_to_brain_ns(est, probe_tick, &mapped_ns, &bound_ns)) {
+            continue;
+        }
+        const double truth = spine.brain_at(probe_spine_ns);
+        const uint64_t error_ns = static_cast<uint64_t>(std::ceil(std::fabs(static_cast<double>(mapped_ns) - truth)));
+
+        errors_ns.push_back(error_ns);
+        bound_sum_ns += bound_ns;
+        worst_error_ns = std::max(worst_error_ns, error_ns);
+        worst_bound_ns = std::max(worst_bound_ns, bound_ns);
+        if (error_ns > bound_ns) {
+            violation_count++;
+        }
+    }
+
+    const ClockEstimate& est = clock.estimate();
+    const ClockSyncCounters& cc = clock.counters();
+    uint64_t p99_ns = 0;
+    if (!errors_ns.empty()) {
+        const std::size_t rank = (errors_ns.size() * 99 + 99) / 100 - 1;
+        std::nth_element(errors_ns.begin(), errors_ns.begin() + static_cast<std::ptrdiff_t>(rank), errors_ns.end());
+        p99_ns = errors_ns[rank];
+    }
+
+    std::printf("link.clock_bench.exchange_count=%llu link.clock_bench.reset_count=%llu "
+                "link.clock_bench.first_estimate_ms=%llu link.clock_bench.true_drift_ppb=%lld "
+                "link.clock_bench.fit_drift_ppb=%lld link.clock_bench.min_delay_us=%llu\n",
+                static_cast<unsigned long long>(cc.exchange_count),
+                static_cast<unsigned long long>(cc.reset_count),
+                static_cast<unsigned long long>(first_estimate_ns / NS_PER_MS),
+                static_cast<long long>(std::llround(drift_ppm * 1000.0 / (1.0 - drift_ppm * 1e-6))),
+                static_cast<long long>(est.drift_ppb),
+                static_cast<unsigned long long>(est.min_delay_ns / NS_PER_US));
+    std::printf("link.clock_bench.conversion_count=%zu link.clock_bench.error_p99_us=%.1f "
+                "link.clock_bench.error_max_us=%.1f link.clock_bench.bound_mean_us=%.1f "
+                "link.clock_bench.bound_max_us=%.1f link.clock_bench.bound_violation_count=%llu\n",
+                errors_ns.size(),
+                static_cast<double>(p99_ns) / NS_PER_US,
+                static_cast<double>(worst_error_ns) / NS_PER_US,
+                errors_ns.empty() ? 0.0 : static_cast<double>(bound_sum_ns) / errors_ns.size() / NS_PER_US,
+                static_cast<double>(worst_bound_ns) / NS_PER_US,
+                static_cast<unsigned long long>(violation_count));
+
+    return (violation_count == 0 && !errors_ns.empty()) ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file link_event_log.cpp
+ * @brief S2B_EVENT_LOG payload parsing and the event table.
+ */
+
+#include "link_event_log.h"
+#include "link_wire.h"
+
+#include <cstdio>
+
+namespace s2t {
+namespace link {
+
+namespace {
+
+struct EventInfo {
+    uint16_t id;
+    const char* name;
+    const char* arg0_name;   // nullptr: argument unused
+    const char* arg1_name;
+};
+
+// Mirrors spine::EventId.
+constexpr EventInfo EVENT_TABLE[] = {
+    { 1, "BOOT",          "hold_timeout_us", nullptr },
+    { 2, "STATE_CHANGE",  "from_state",      "to_state" },
+    { 3, "FORCED_SAFE",   "fault_code",      "forced_safe_count" },
+    { 4, "HOLD_TIMEOUT",  "latency_us",      "state" },
+    { 5, "TASK_OVERRUN",  "task_index",      "run_us" },
+    { 6, "MAILBOX_DROP",  "packet_len",      "slots_in_use" },
+    { 7, "UNKNOWN_MSG",   "msg_type",        "seq" },
+    { 8, "MISADDRESSED",  "src",             "dst" },
+    { 9, "EVENT_LOG_DUMP", "dump_number",    nullptr },
+};
+
+const EventInfo* find_event(uint16_t event_id)
+{
+    for (const EventInfo& info : EVENT_TABLE) {
+        if (info.id == event_id) {
+            return &info;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+EventLogStatus event_log_parse(const uint8_t* payload, std::size_t payload_len, EventLogFrame* out)
+{
+    if (!payload || !out) {
+        return EventLogStatus::ERR_NULL;
+    }
+    if (payload_len < EVENT_LOG_FRAME_HEADER_BYTES) {
+        return EventLogStatus::ERR_TOO_SHORT;
+    }
+    if (payload[0] != EVENT_LOG_LAYOUT_VERSION) {
+        return EventLogStatus::ERR_LAYOUT_VERSION;
+    }
+    if (payload[1] >= EVENT_LOG_CORE_COUNT) {
+        return EventLogStatus::ERR_CORE;
+    }
+
+    const std::size_t count = payload[2];
+    if (count > EVENT_LOG_MAX_RECORDS_PER_FRAME ||
+        payload_len != EVENT_LOG_FRAME_HEADER_BYTES + count * EVENT_LOG_RECORD_BYTES) {
+        return EventLogStatus::ERR_RECORD_COUNT;
+    }
+
+    out->core = payload[1];
+    out->record_count = static_cast<uint8_t>(count);
+    out->flags = payload[3];
+    out->first_index = get_u32_le(payload + 4);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const uint8_t* r = payload + EVENT_LOG_FRAME_HEADER_BYTES + i * EVENT_LOG_RECORD_BYTES;
+        EventLogRecord& rec = out->records[i];
+        rec.index = out->first_index + static_cast<uint32_t>(i);
+        rec.time_us = get_u32_le(r + 0);
+        rec.event_id = static_cast<uint16_t>(get_u16_le(r + 4));
+        rec.arg0 = get_u32_le(r + 8);
+        rec.arg1 = get_u32_le(r + 12);
+    }
+    return EventLogStatus::OK;
+}
+
+const char* event_log_event_name(uint16_t event_id)
+{
+    const EventInfo* info = find_event(event_id);
+    return info ? info->name : nullptr;
+}
+
+void event_log_format(const EventLogRecord& record, char* buf, std::size_t cap)
+{
+    if (!buf || cap == 0) {
+        return;
+    }
+
+    const EventInfo* info = find_event(record.event_id);
+    if (!info) {
+        std::snprintf(buf, cap, "EVENT_0x%04x arg0=%u arg1=%u",
+                      record.event_id, record.arg0, record.arg1);
+    } else if (!info->arg0_name) {
+        std::snprintf(buf, cap, "%s", info->name);
+    } else if (!info->arg1_name) {
+        std::snprintf(buf, cap, "%s %s=%u", info->name, info->arg0_name, record.arg0);
+    } else {
+        std::snprintf(buf, cap, "%s %s=%u %s=%u", info->name,
+                      info->arg0_name, record.arg0, info->arg1_name, record.arg1);
+    }
+}
+
+} // namespace link
+} // namespace s2t
@@ -0,0 +1,79 @@
+#ifndef LINK_EVENT_LOG_H
+#define LINK_EVENT_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bs_protocol.h"
+
+/**
+ * @file link_event_log.h
+ * @brief Decoder for S2B_EVENT_LOG, the Spine event ring dump.
+ *
+ * The Spine records fixed binary events (timestamp, ID, two arguments) and
+ * never formats them. This is the other half: payload parsing and the
+ * event vocabulary. IDs and layout mirror spine/spine_event_log.h
+ * (layout version 1) and must change with it.
+ *
+ * A dump is requested with B2S_EVENT_LOG_REQUEST (empty payload) and
+ * arrives as one run of frames per Spine core, oldest record first; the
+ * last frame of each core carries EVENT_LOG_FLAG_LAST_FRAME.
+ */
+
+namespace s2t {
+namespace link {
+
+static constexpr uint8_t EVENT_LOG_LAYOUT_VERSION = 1;
+
+static constexpr std::size_t EVENT_LOG_FRAME_HEADER_BYTES = 8;
+static constexpr std::size_t EVENT_LOG_RECORD_BYTES       = 16;
+static constexpr std::size_t EVENT_LOG_MAX_RECORDS_PER_FRAME =
+    (protocol::MAX_PAYLOAD_SIZE_BYTES - EVENT_LOG_FRAME_HEADER_BYTES) / EVENT_LOG_RECORD_BYTES;
+
+static constexpr uint8_t EVENT_LOG_FLAG_LAST_FRAME = 0x01;  // end of this core's ring
+static constexpr uint8_t EVENT_LOG_FLAG_GAP        = 0x02;  // records lost before this frame
+
+static constexpr uint8_t EVENT_LOG_CORE_COUNT = 2;
+
+enum class EventLogStatus : uint32_t {
+    OK = 0,
+    ERR_NULL,
+    ERR_TOO_SHORT,
+    ERR_LAYOUT_VERSION,
+    ERR_CORE,
+    ERR_RECORD_COUNT     // count disagrees with the payload length
+};
+
+struct EventLogRecord {
+    uint32_t index;      // ring index (free-running per core)
+    uint32_t time_us;    // Spine time_us_32()
+    uint16_t event_id;
+    uint32_t arg0;
+    uint32_t arg1;
+};
+
+struct EventLogFrame {
+    uint8_t core;
+    uint8_t flags;
+    uint8_t record_count;
+    uint32_t first_index;
+    EventLogRecord records[EVENT_LOG_MAX_RECORDS_PER_FRAME];
+};
+
+EventLogStatus event_log_parse(const uint8_t* payload, std::size_t payload_len, EventLogFrame* out);
+
+/**
+ * Event name ("HOLD_TIMEOUT"), or nullptr for an ID this build does not know.
+ */
+const char* event_log_event_name(uint16_t event_id);
+
+/**
+ * Human-readable record: name and named arguments. Unknown IDs print as
+ * "EVENT_0x1234 arg0=... arg1=...". Always NUL-terminates (cap > 0).
+ */
+void event_log_format(const EventLogRecord& record, char* buf, std::size_t cap);
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_EVENT_LOG_H
@@ -0,0 +1,181 @@
+/**
+ * @file link_event_log_tool.cpp
+ * @brief Request the Spine event ring and print it.
+ *
+ * Usage:
+ *   link_event_log_tool <tty> [--timeout-ms N]
+ *
+ * Sends one B2S_EVENT_LOG_REQUEST, collects S2B_EVENT_LOG frames until
+ * both cores' rings are complete (or the timeout passes) and prints one
+ * line per record:
+ *
+ *   core=0 index=812 t_us=40213377 HOLD_TIMEOUT latency_us=3 state=1
+ *
+ * Other traffic on the tty is ignored. The tool owns the tty for its run,
+ * so stop link_telemetry_daemon first; it sends no keepalive.
+ * Exit status: 0 complete, 1 I/O error, 3 timed out before completion.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "bs_protocol.h"
+#include "link_event_log.h"
+#include "link_serial_port.h"
+#include "link_timing_constants.h"
+
+using namespace s2t::link;
+using namespace s2t::protocol;
+
+static constexpr int READ_TIMEOUT_MS = 50;
+static constexpr long DEFAULT_TIMEOUT_MS = 3000;
+static constexpr std::size_t READ_CHUNK_BYTES = 512;
+static constexpr std::size_t LINE_BYTES = 160;
+static constexpr uint64_t NS_PER_MS = NS_PER_US * US_PER_MS;
+
+struct DumpContext {
+    uint64_t frame_count;
+    uint64_t record_count;
+    uint64_t gap_count;
+    uint64_t parse_error_count;
+    bool core_done[EVENT_LOG_CORE_COUNT];
+};
+
+static void print_usage(const char* argv0)
+{
+    std::fprintf(stderr, "usage: %s <tty> [--timeout-ms N]\n", argv0);
+}
+
+static uint64_t monotonic_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * (NS_PER_S / NS_PER_MS) +
+           static_cast<uint64_t>(ts.tv_nsec) / NS_PER_MS;
+}
+
+static void on_frame(const uint8_t* frame_buf, std::size_t frame_len, void* ctx)
+{
+    DumpContext* dump = static_cast<DumpContext*>(ctx);
+
+    PacketHeader header;
+    if (validate_packet(frame_buf, frame_len) != PacketStatus::OK ||
+        parse_and_validate_header(frame_buf, frame_len, &header) != HeaderStatus::OK ||
+        header.src != NODE_ID_SPINE || header.msg_type != MSG_ID_S2B_EVENT_LOG) {
+        return;
+    }
+
+    EventLogFrame frame;
+    if (event_log_parse(frame_buf + HEADER_SIZE_BYTES, header.payload_len, &frame) != EventLogStatus::OK) {
+        dump->parse_error_count++;
+        return;
+    }
+
+    dump->frame_count++;
+    if (frame.flags & EVENT_LOG_FLAG_GAP) {
+        dump->gap_count++;
+        std::printf("core=%u -- records lost before index %u --\n", frame.core, frame.first_index);
+    }
+
+    char line[LINE_BYTES];
+    for (std::size_t i = 0; i < frame.record_count; ++i) {
+        const EventLogRecord& rec = frame.records[i];
+        event_log_format(rec, line, sizeof(line));
+        std::printf("core=%u index=%u t_us=%u %s\n", frame.core, rec.index, rec.time_us, line);
+    }
+    dump->record_count += frame.record_count;
+
+    if (frame.flags & EVENT_LOG_FLAG_LAST_FRAME) {
+        dump->core_done[frame.core] = true;
+    }
+}
+
+static bool dump_complete(const DumpContext& dump)
+{
+    for (bool done : dump.core_done) {
+        if (!done) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    const char* tty_path = argv[1];
+    long timeout_ms = DEFAULT_TIMEOUT_MS;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--timeout-ms") == 0 && i + 1 < argc) {
+            timeout_ms = std::strtol(argv[++i], nullptr, 10);
+        } else {
+            timeout_ms = 0;
+        }
+        if (timeout_ms <= 0) {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    SerialPort port;
+    if (!serial_port_open(&port, tty_path)) {
+        std::perror(tty_path);
+        return 1;
+    }
+
+    PacketHeader fields = {};
+    fields.msg_type = MSG_ID_B2S_EVENT_LOG_REQUEST;
+    fields.src = NODE_ID_BRAIN;
+    fields.dst = NODE_ID_SPINE;
+    uint8_t request[MAX_FRAME_BUFFER_SIZE];
+    std::size_t request_len = 0;
+    if (encode_packet(&fields, nullptr, 0, request, sizeof(request), &request_len) != EncodeStatus::OK ||
+        !serial_port_write_all(&port, request, request_len)) {
+        std::perror(tty_path);
+        serial_port_close(&port);
+        return 1;
+    }
+
+    ByteStreamFramer framer;
+    bs_framer_init(&framer);
+    DumpContext dump = {};
+
+    uint8_t chunk[READ_CHUNK_BYTES];
+    const uint64_t deadline_ms = monotonic_ms() + static_cast<uint64_t>(timeout_ms);
+    int exit_code = 3;
+
+    while (monotonic_ms() < deadline_ms) {
+        const std::ptrdiff_t n = serial_port_read(&port, chunk, sizeof(chunk), READ_TIMEOUT_MS);
+        if (n < 0) {
+            std::perror(tty_path);
+            exit_code = 1;
+            break;
+        }
+        if (n > 0) {
+            bs_framer_push(&framer, chunk, static_cast<std::size_t>(n), on_frame, &dump);
+        }
+        if (dump_complete(dump)) {
+            exit_code = 0;
+            break;
+        }
+    }
+
+    std::printf("link.event_log.frame_count=%llu link.event_log.record_count=%llu "
+                "link.event_log.gap_count=%llu link.event_log.parse_error_count=%llu "
+                "link.event_log.complete=%d\n",
+                static_cast<unsigned long long>(dump.frame_count),
+                static_cast<unsigned long long>(dump.record_count),
+                static_cast<unsigned long long>(dump.gap_count),
+                static_cast<unsigned long long>(dump.parse_error_count),
+                exit_code == 0 ? 1 : 0);
+
+    serial_port_close(&port);
+    return exit_code;
+}
@@ -0,0 +1,32 @@
+#ifndef LINK_FRAME_SINK_H
+#define LINK_FRAME_SINK_H
+
+#include <cstdint>
+#include <cstddef>
+#include <sys/uio.h>
+
+namespace s2t {
+namespace link {
+
+/**
+ * Destination for one fully encoded packet.
+ *
+ * The sink owns nothing: `frame` is only valid for the duration of the call
+ * and must be copied if it is needed afterwards.
+ *
+ * Returns true if every byte was accepted by the transport.
+ */
+typedef bool (*FrameSink)(const uint8_t* frame, std::size_t frame_len, void* ctx);
+
+/**
+ * Destination for several encoded packets written back to back, in order.
+ * Same ownership rule: the buffers are only valid during the call.
+ *
+ * Returns true if every byte of every frame was accepted.
+ */
+typedef bool (*FrameBatchSink)(const struct iovec* frames, std::size_t frame_count, void* ctx);
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_FRAME_SINK_H
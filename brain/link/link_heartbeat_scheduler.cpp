@@ -0,0 +1,264 @@
+/**
+ * @file link_heartbeat_scheduler.cpp
+ * @brief timerfd-driven B2S_HEARTBEAT sender with jitter and deadline metrics.
+ *
+ * Timing model:
+ * - deadline[n] = first_deadline + n * period (CLOCK_MONOTONIC, absolute)
+ * - the timerfd read returns how many periods elapsed since the last read;
+ *   anything above 1 means deadlines passed without a send
+ * - at most ONE heartbeat is sent per wake-up; missed periods are counted,
+ *   never replayed as a burst
+ */
+
+#include "link_heartbeat_scheduler.h"
+
+#include <cerrno>
+#include <ctime>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "../protocol/bs_protocol.h"
+
+namespace s2t {
+namespace link {
+
+static uint64_t monotonic_now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * NS_PER_S +
+           static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static struct timespec ns_to_timespec(uint64_t ns)
+{
+    struct timespec ts;
+    ts.tv_sec  = static_cast<time_t>(ns / NS_PER_S);
+    ts.tv_nsec = static_cast<long>(ns % NS_PER_S);
+    return ts;
+}
+
+HeartbeatScheduler::HeartbeatScheduler(const HeartbeatSchedulerConfig& config,
+                                       FrameSink sink,
+                                       void* sink_ctx)
+    : config_(config), sink_(sink), sink_ctx_(sink_ctx)
+{
+}
+
+HeartbeatScheduler::~HeartbeatScheduler()
+{
+    stop();
+}
+
+SchedulerStatus HeartbeatScheduler::start()
+{
+    if (thread_.joinable()) {
+        return SchedulerStatus::ERR_ALREADY_RUNNING;
+    }
+    if (!sink_ || config_.period_us == 0) {
+        return SchedulerStatus::ERR_INVALID_CONFIG;
+    }
+    if (config_.realtime_priority < 0 || config_.realtime_priority > 99) {
+        return SchedulerStatus::ERR_INVALID_CONFIG;
+    }
+
+    timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (timer_fd_ < 0) {
+        return SchedulerStatus::ERR_TIMERFD;
+    }
+
+    stop_fd_ = eventfd(0, EFD_CLOEXEC);
+    if (stop_fd_ < 0) {
+        ::close(timer_fd_);
+        timer_fd_ = -1;
+        return SchedulerStatus::ERR_EVENTFD;
+    }
+
+    const uint64_t period_ns = static_cast<uint64_t>(config_.period_us) * NS_PER_US;
+    first_deadline_ns_ = monotonic_now_ns() + period_ns;
+
+    struct itimerspec spec;
+    spec.it_value    = ns_to_timespec(first_deadline_ns_);
+    spec.it_interval = ns_to_timespec(period_ns);
+
+    if (timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr) != 0) {
+        ::close(stop_fd_);
+        ::close(timer_fd_);
+        stop_fd_ = -1;
+        timer_fd_ = -1;
+        return SchedulerStatus::ERR_TIMERFD;
+    }
+
+    try {
+        thread_ = std::thread(&HeartbeatScheduler::run, this);
+    } catch (...) {
+        ::close(stop_fd_);
+        ::close(timer_fd_);
+        stop_fd_ = -1;
+        timer_fd_ = -1;
+        return SchedulerStatus::ERR_THREAD;
+    }
+
+    return SchedulerStatus::OK;
+}
+
+void HeartbeatScheduler::stop()
+{
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    const uint64_t one = 1;
+    // An eventfd write of 1 only fails on counter overflow, which a single
+    // writer cannot reach.
+    (void)::write(stop_fd_, &one, sizeof(one));
+    thread_.join();
+
+    ::close(stop_fd_);
+    ::close(timer_fd_);
+    stop_fd_ = -1;
+    timer_fd_ = -1;
+}
+
+HeartbeatMetrics HeartbeatScheduler::metrics() const
+{
+    HeartbeatMetrics m;
+    m.sent_count            = sent_count_.load(std::memory_order_relaxed);
+    m.send_error_count      = send_error_count_.load(std::memory_order_relaxed);
+    m.missed_deadline_count = missed_deadline_count_.load(std::memory_order_relaxed);
+    m.jitter_last_us        = jitter_last_us_.load(std::memory_order_relaxed);
+    m.jitter_max_us         = jitter_max_us_.load(std::memory_order_relaxed);
+    m.jitter_total_us       = jitter_total_us_.load(std::memory_order_relaxed);
+    m.realtime_active       = realtime_active_.load(std::memory_order_relaxed);
+    m.cpu_pinned            = cpu_pinned_.load(std::memory_order_relaxed);
+    return m;
+}
+
+/**
+ * Apply optional SCHED_FIFO priority and CPU affinity to the calling thread.
+ *
+ * Both are best-effort: without CAP_SYS_NICE the thread keeps running at
+ * normal priority and the metrics report that. Heartbeat pacing on the
+ * Brain is a margin improvement, not a safety mechanism.
+ */
+void HeartbeatScheduler::apply_thread_policy()
+{
+    if (config_.realtime_priority > 0) {
+        struct sched_param param;
+        param.sched_priority = config_.realtime_priority;
+        const int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        realtime_active_.store(rc == 0, std::memory_order_relaxed);
+    }
+
+    if (config_.cpu_index >= 0 && config_.cpu_index < CPU_SETSIZE) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(config_.cpu_index, &set);
+        const int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        cpu_pinned_.store(rc == 0, std::memory_order_relaxed);
+    }
+}
+
+void HeartbeatScheduler::send_one(uint64_t deadline_ns)
+{
+    protocol::PacketHeader fields = {};
+    fields.msg_type = protocol::MSG_ID_B2S_HEARTBEAT;
+    fields.flags    = 0;
+    fields.src      = protocol::NODE_ID_BRAIN;
+    fields.dst      = protocol::NODE_ID_SPINE;
+    fields.seq      = next_seq_;
+
+    // Liveness is the whole message. The payload is the send time, which
+    // the Spine echoes in S2B_ACK for clock sync (link_clock_sync.h).
+    const uint64_t now_ns = monotonic_now_ns();
+    uint8_t payload[HEARTBEAT_PAYLOAD_SIZE_BYTES];
+    for (std::size_t i = 0; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>(now_ns >> (8u * i));
+    }
+
+    uint8_t frame[protocol::MAX_FRAME_BUFFER_SIZE];
+    std::size_t frame_len = 0;
+    const protocol::EncodeStatus es =
+        protocol::encode_packet(&fields, payload, sizeof(payload), frame, sizeof(frame), &frame_len);
+    if (es != protocol::EncodeStatus::OK) {
+        send_error_count_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const uint64_t late_ns = (now_ns > deadline_ns) ? (now_ns - deadline_ns) : 0;
+    const uint32_t late_us = static_cast<uint32_t>(late_ns / NS_PER_US);
+
+    const bool ok = sink_(frame, frame_len, sink_ctx_);
+    next_seq_++;
+
+    if (!ok) {
+        send_error_count_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    sent_count_.fetch_add(1, std::memory_order_relaxed);
+    jitter_last_us_.store(late_us, std::memory_order_relaxed);
+    jitter_total_us_.fetch_add(late_us, std::memory_order_relaxed);
+    if (late_us > jitter_max_us_.load(std::memory_order_relaxed)) {
+        jitter_max_us_.store(late_us, std::memory_order_relaxed);
+    }
+}
+
+void HeartbeatScheduler::run()
+{
+    apply_thread_policy();
+
+    const uint64_t period_ns = static_cast<uint64_t>(config_.period_us) * NS_PER_US;
+
+    uint64_t elapsed_periods = 0;
+
+    struct pollfd fds[2];
+    fds[0].fd = timer_fd_;
+    fds[0].events = POLLIN;
+    fds[1].fd = stop_fd_;
+    fds[1].events = POLLIN;
+
+    while (true) {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+
+        const int rc = poll(fds, 2, -1);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents & POLLIN) {
+            return;
+        }
+        if (!(fds[0].revents & POLLIN)) {
+            continue;
+        }
+
+        uint64_t expirations = 0;
+        if (::read(timer_fd_, &expirations, sizeof(expirations)) !=
+            static_cast<ssize_t>(sizeof(expirations))) {
+            continue;
+        }
+        if (expirations == 0) {
+            continue;
+        }
+
+        elapsed_periods += expirations;
+        if (expirations > 1) {
+            missed_deadline_count_.fetch_add(expirations - 1, std::memory_order_relaxed);
+        }
+
+        // The deadline being served is the most recent one that elapsed.
+        const uint64_t deadline_ns = first_deadline_ns_ + (elapsed_periods - 1) * period_ns;
+        send_one(deadline_ns);
+    }
+}
+
+} // namespace link
+} // namespace s2t
@@ -0,0 +1,125 @@
+#ifndef LINK_HEARTBEAT_SCHEDULER_H
+#define LINK_HEARTBEAT_SCHEDULER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <thread>
+
+#include "link_frame_sink.h"
+#include "link_timing_constants.h"
+
+/**
+ * @file link_heartbeat_scheduler.h
+ * @brief Deterministic B2S_HEARTBEAT sender for the Brain.
+ *
+ * One background thread waits on a timerfd armed with ABSOLUTE deadlines
+ * (start + n * period on CLOCK_MONOTONIC). Absolute deadlines mean a late
+ * wake-up never shifts later heartbeats; the schedule does not drift.
+ *
+ * Authority: none. A heartbeat only asserts Brain liveness. The Spine owns
+ * the hold timeout and MUST fall back to SAFE on its own if these frames
+ * stop arriving (Contract v0.2 Section 3.1 / 3.5).
+ *
+ * Lifecycle:
+ * - constructed idle; no thread exists
+ * - start() spawns the thread and arms the first deadline one period out
+ * - stop() wakes the thread through an eventfd and joins it
+ * - the destructor calls stop()
+ *
+ * Ownership: the scheduler owns its thread, timerfd, eventfd and sequence
+ * counter. The FrameSink and its context are borrowed and must outlive
+ * the running thread.
+ */
+
+namespace s2t {
+namespace link {
+
+// B2S_HEARTBEAT payload: Brain CLOCK_MONOTONIC send time, u64 LE.
+static constexpr std::size_t HEARTBEAT_PAYLOAD_SIZE_BYTES = 8;
+
+struct HeartbeatSchedulerConfig {
+    // Send period in microseconds. Contract default is 200 ms.
+    uint32_t period_us = B2S_HEARTBEAT_PERIOD_MS * US_PER_MS;
+
+    // SCHED_FIFO priority (1..99). 0 keeps the default SCHED_OTHER policy.
+    int realtime_priority = 0;
+
+    // CPU to pin the thread to. -1 leaves affinity unchanged.
+    int cpu_index = -1;
+};
+
+enum class SchedulerStatus {
+    OK = 0,
+    ERR_INVALID_CONFIG,
+    ERR_ALREADY_RUNNING,
+    ERR_TIMERFD,
+    ERR_EVENTFD,
+    ERR_THREAD
+};
+
+/**
+ * Snapshot of scheduler observability counters.
+ *
+ * Jitter is the lateness of a send relative to its absolute deadline,
+ * measured when the frame is handed to the sink. It is never negative:
+ * the timer cannot fire early.
+ */
+struct HeartbeatMetrics {
+    uint64_t sent_count            = 0;
+    uint64_t send_error_count      = 0;
+    uint64_t missed_deadline_count = 0;  // periods that elapsed with no send
+    uint32_t jitter_last_us        = 0;
+    uint32_t jitter_max_us         = 0;
+    uint64_t jitter_total_us       = 0;  // sum over sent_count, for the mean
+    bool     realtime_active       = false;
+    bool     cpu_pinned            = false;
+};
+
+class HeartbeatScheduler {
+public:
+    HeartbeatScheduler(const HeartbeatSchedulerConfig& config,
+                       FrameSink sink,
+                       void* sink_ctx);
+    ~HeartbeatScheduler();
+
+    HeartbeatScheduler(const HeartbeatScheduler&) = delete;
+    HeartbeatScheduler& operator=(const HeartbeatScheduler&) = delete;
+
+    SchedulerStatus start();
+    void stop();
+
+    bool running() const { return thread_.joinable(); }
+
+    HeartbeatMetrics metrics() const;
+
+private:
+    void run();
+    void apply_thread_policy();
+    void send_one(uint64_t deadline_ns);
+
+    HeartbeatSchedulerConfig config_;
+    FrameSink sink_;
+    void* sink_ctx_;
+
+    std::thread thread_;
+    int timer_fd_ = -1;
+    int stop_fd_  = -1;
+
+    uint64_t first_deadline_ns_ = 0;
+    uint16_t next_seq_ = 0;
+
+    std::atomic<uint64_t> sent_count_{0};
+    std::atomic<uint64_t> send_error_count_{0};
+    std::atomic<uint64_t> missed_deadline_count_{0};
+    std::atomic<uint32_t> jitter_last_us_{0};
+    std::atomic<uint32_t> jitter_max_us_{0};
+    std::atomic<uint64_t> jitter_total_us_{0};
+    std::atomic<bool>     realtime_active_{false};
+    std::atomic<bool>     cpu_pinned_{false};
+};
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_HEARTBEAT_SCHEDULER_H
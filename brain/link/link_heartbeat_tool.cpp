@@ -0,0 +1,121 @@
+/**
+ * @file link_heartbeat_tool.cpp
+ * @brief Brain-side CLI that keeps the Spine link alive with B2S_HEARTBEAT.
+ *
+ * Usage:
+ *   link_heartbeat_tool <tty> [--period-ms N] [--rt-prio N] [--cpu N]
+ *
+ * Prints scheduler metrics once per second until interrupted (SIGINT/SIGTERM).
+ * This tool grants no authority; it only asserts Brain liveness.
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+#include "link_heartbeat_scheduler.h"
+#include "link_serial_port.h"
+
+using namespace s2t::link;
+
+static volatile std::sig_atomic_t g_stop_requested = 0;
+
+static void on_stop_signal(int)
+{
+    g_stop_requested = 1;
+}
+
+static void print_usage(const char* argv0)
+{
+    std::fprintf(stderr,
+                 "usage: %s <tty> [--period-ms N] [--rt-prio N] [--cpu N]\n",
+                 argv0);
+}
+
+static void print_metrics(const HeartbeatMetrics& m)
+{
+    const uint64_t jitter_mean_us =
+        (m.sent_count > 0) ? (m.jitter_total_us / m.sent_count) : 0;
+
+    std::printf("link.heartbeat.sent_count=%llu "
+                "link.heartbeat.send_error_count=%llu "
+                "link.heartbeat.missed_deadline_count=%llu "
+                "link.heartbeat.jitter_last_us=%u "
+                "link.heartbeat.jitter_mean_us=%llu "
+                "link.heartbeat.jitter_max_us=%u "
+                "link.heartbeat.realtime=%d "
+                "link.heartbeat.cpu_pinned=%d\n",
+                static_cast<unsigned long long>(m.sent_count),
+                static_cast<unsigned long long>(m.send_error_count),
+                static_cast<unsigned long long>(m.missed_deadline_count),
+                m.jitter_last_us,
+                static_cast<unsigned long long>(jitter_mean_us),
+                m.jitter_max_us,
+                m.realtime_active ? 1 : 0,
+                m.cpu_pinned ? 1 : 0);
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    const char* tty_path = argv[1];
+    HeartbeatSchedulerConfig config;
+
+    for (int i = 2; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return 2;
+        }
+        const long value = std::strtol(argv[i + 1], nullptr, 10);
+        if (std::strcmp(argv[i], "--period-ms") == 0 && value > 0) {
+            config.period_us = static_cast<uint32_t>(value) * US_PER_MS;
+        } else if (std::strcmp(argv[i], "--rt-prio") == 0) {
+            config.realtime_priority = static_cast<int>(value);
+        } else if (std::strcmp(argv[i], "--cpu") == 0) {
+            config.cpu_index = static_cast<int>(value);
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+
+    if (config.period_us >= DEFAULT_HOLD_TIMEOUT_MS * US_PER_MS) {
+        std::fprintf(stderr,
+                     "warning: period %u us is not below the %u ms hold timeout\n",
+                     config.period_us, DEFAULT_HOLD_TIMEOUT_MS);
+    }
+
+    SerialPort port;
+    if (!serial_port_open(&port, tty_path)) {
+        std::perror(tty_path);
+        return 1;
+    }
+
+    std::signal(SIGINT, on_stop_signal);
+    std::signal(SIGTERM, on_stop_signal);
+
+    HeartbeatScheduler scheduler(config, serial_port_frame_sink, &port);
+    if (scheduler.start() != SchedulerStatus::OK) {
+        std::fprintf(stderr, "failed to start heartbeat scheduler\n");
+        serial_port_close(&port);
+        return 1;
+    }
+
+    while (!g_stop_requested) {
+        sleep(1);
+        print_metrics(scheduler.metrics());
+    }
+
+    scheduler.stop();
+    print_metrics(scheduler.metrics());
+    serial_port_close(&port);
+    return 0;
+}
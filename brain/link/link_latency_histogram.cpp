@@ -0,0 +1,115 @@
+/**
+ * @file link_latency_histogram.cpp
+ * @brief Bucket mapping and percentile walk for LatencyHistogram.
+ */
+
+#include "link_latency_histogram.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace s2t {
+namespace link {
+
+namespace {
+
+uint32_t bucket_index(uint32_t value)
+{
+    if (value < LATENCY_HIST_SUB_COUNT) {
+        return value;
+    }
+    const uint32_t msb = 31u - static_cast<uint32_t>(__builtin_clz(value));
+    const uint32_t shift = msb - (LATENCY_HIST_SUB_BITS - 1u);
+    const uint32_t top = value >> shift;   // HALF_COUNT .. SUB_COUNT - 1
+    return LATENCY_HIST_SUB_COUNT + (msb - LATENCY_HIST_SUB_BITS) * LATENCY_HIST_HALF_COUNT +
+           (top - LATENCY_HIST_HALF_COUNT);
+}
+
+uint32_t bucket_upper_edge(std::size_t index)
+{
+    if (index < LATENCY_HIST_SUB_COUNT) {
+        return static_cast<uint32_t>(index);
+    }
+    const std::size_t rel = index - LATENCY_HIST_SUB_COUNT;
+    const uint32_t shift = static_cast<uint32_t>(rel / LATENCY_HIST_HALF_COUNT) + 1u;
+    const uint64_t top = LATENCY_HIST_HALF_COUNT + rel % LATENCY_HIST_HALF_COUNT;
+    const uint64_t upper = ((top + 1u) << shift) - 1u;
+    return (upper > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(upper);
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+void LatencyHistogram::reset()
+{
+    std::memset(buckets_, 0, sizeof(buckets_));
+    count_ = 0;
+    total_us_ = 0;
+    min_us_ = UINT32_MAX;
+    max_us_ = 0;
+}
+
+void LatencyHistogram::record(uint32_t value_us)
+{
+    buckets_[bucket_index(value_us)]++;
+    count_++;
+    total_us_ += value_us;
+    if (value_us < min_us_) {
+        min_us_ = value_us;
+    }
+    if (value_us > max_us_) {
+        max_us_ = value_us;
+    }
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    for (std::size_t i = 0; i < LATENCY_HIST_BUCKET_COUNT; ++i) {
+        buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    total_us_ += other.total_us_;
+    if (other.count_ > 0) {
+        if (other.min_us_ < min_us_) {
+            min_us_ = other.min_us_;
+        }
+        if (other.max_us_ > max_us_) {
+            max_us_ = other.max_us_;
+        }
+    }
+}
+
+uint32_t LatencyHistogram::percentile_us(double q) const
+{
+    if (count_ == 0) {
+        return 0;
+    }
+    if (q < 0.0) {
+        q = 0.0;
+    } else if (q > 1.0) {
+        q = 1.0;
+    }
+
+    // 1-based rank of the sample at quantile q.
+    uint64_t rank = static_cast<uint64_t>(std::ceil(q * static_cast<double>(count_)));
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (std::size_t i = 0; i < LATENCY_HIST_BUCKET_COUNT; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            const uint32_t edge = bucket_upper_edge(i);
+            return (edge < max_us_) ? edge : max_us_;
+        }
+    }
+    return max_us_;
+}
+
+} // namespace link
+} // namespace s2t
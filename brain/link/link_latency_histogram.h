@@ -0,0 +1,63 @@
+#ifndef LINK_LATENCY_HISTOGRAM_H
+#define LINK_LATENCY_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file link_latency_histogram.h
+ * @brief Fixed-size log-linear latency histogram for long runs.
+ *
+ * Values are microseconds (u32). Below 2^LATENCY_HIST_SUB_BITS every
+ * value has its own bucket; above, each power of two is split into
+ * 2^(LATENCY_HIST_SUB_BITS - 1) equal buckets, so a reported percentile is
+ * within about 3 % of the true value over the whole u32 range. Storage is
+ * a flat array of counters (about 7 KiB): recording is O(1), never
+ * allocates, and hours of samples cost nothing extra.
+ *
+ * Percentiles report the upper edge of the bucket holding the requested
+ * rank (clamped to the largest value seen), so they never understate.
+ *
+ * Not thread-safe; one owner records and reads.
+ */
+
+namespace s2t {
+namespace link {
+
+static constexpr uint32_t LATENCY_HIST_SUB_BITS = 6;
+static constexpr uint32_t LATENCY_HIST_SUB_COUNT = 1u << LATENCY_HIST_SUB_BITS;          // exact range
+static constexpr uint32_t LATENCY_HIST_HALF_COUNT = LATENCY_HIST_SUB_COUNT / 2u;         // per octave
+static constexpr std::size_t LATENCY_HIST_BUCKET_COUNT =
+    LATENCY_HIST_SUB_COUNT + (32u - LATENCY_HIST_SUB_BITS) * LATENCY_HIST_HALF_COUNT;
+
+class LatencyHistogram {
+public:
+    LatencyHistogram();
+
+    void record(uint32_t value_us);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    uint64_t count() const { return count_; }
+    uint32_t min_us() const { return count_ ? min_us_ : 0; }
+    uint32_t max_us() const { return max_us_; }
+    uint64_t mean_us() const { return count_ ? total_us_ / count_ : 0; }
+
+    /**
+     * Smallest bucket upper edge covering a fraction `q` (0..1) of the
+     * samples, e.g. 0.999 for p99.9. 0 when empty.
+     */
+    uint32_t percentile_us(double q) const;
+
+private:
+    uint64_t buckets_[LATENCY_HIST_BUCKET_COUNT];
+    uint64_t count_;
+    uint64_t total_us_;
+    uint32_t min_us_;
+    uint32_t max_us_;
+};
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_LATENCY_HISTOGRAM_H
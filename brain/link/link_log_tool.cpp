@@ -0,0 +1,195 @@
+/**
+ * @file link_log_tool.cpp
+ * @brief Stream the Spine's deferred-format log as text.
+ *
+ * Usage:
+ *   link_log_tool <tty> --fmt FILE [--seconds N]
+ *
+ * FILE is the format table of the running firmware (scout_spine.logfmt,
+ * written next to the .elf by the Spine build). Every S2B_LOG record is
+ * printed as one line:
+ *
+ *   core=1 index=57 t_us=40213377 spine.state=2 spine.safety.last_fault=0 ...
+ *
+ * If the Spine reports a different table CRC the table is from another
+ * build: the tool says so once and prints records raw (FMT_0x.... and the
+ * arguments) instead of guessing. Other traffic on the tty is ignored.
+ * The tool owns the tty for its run and sends nothing.
+ *
+ * Runs until interrupted (SIGINT/SIGTERM), --seconds passes, or the tty
+ * goes away, then prints link.log.* counters.
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "bs_protocol.h"
+#include "link_serial_port.h"
+#include "link_spine_log.h"
+#include "link_timing_constants.h"
+
+using namespace s2t::link;
+using namespace s2t::protocol;
+
+static constexpr int READ_TIMEOUT_MS = 50;
+static constexpr std::size_t READ_CHUNK_BYTES = 512;
+static constexpr std::size_t LINE_BYTES = 512;
+
+static volatile std::sig_atomic_t g_stop_requested = 0;
+
+static void on_stop_signal(int)
+{
+    g_stop_requested = 1;
+}
+
+static void print_usage(const char* argv0)
+{
+    std::fprintf(stderr, "usage: %s <tty> --fmt FILE [--seconds N]\n", argv0);
+}
+
+static uint64_t monotonic_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * NS_PER_S + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+struct LogContext {
+    const SpineLogTable* table;
+    SpineLogTable empty_table;     // used while the CRC disagrees
+    uint64_t frame_count;
+    uint64_t record_count;
+    uint64_t gap_count;
+    uint64_t parse_error_count;
+    uint64_t table_mismatch_count;  // frames decoded raw
+    bool mismatch_reported;
+};
+
+static void on_frame(const uint8_t* frame_buf, std::size_t frame_len, void* ctx)
+{
+    LogContext* log = static_cast<LogContext*>(ctx);
+
+    PacketHeader header;
+    if (validate_packet(frame_buf, frame_len) != PacketStatus::OK ||
+        parse_and_validate_header(frame_buf, frame_len, &header) != HeaderStatus::OK ||
+        header.src != NODE_ID_SPINE || header.msg_type != MSG_ID_S2B_LOG) {
+        return;
+    }
+
+    SpineLogFrame frame;
+    if (spine_log_parse(frame_buf + HEADER_SIZE_BYTES, header.payload_len, &frame) != SpineLogStatus::OK) {
+        log->parse_error_count++;
+        return;
+    }
+
+    log->frame_count++;
+    const SpineLogTable* table = log->table;
+    if (frame.table_crc32 != table->crc32) {
+        log->table_mismatch_count++;
+        if (!log->mismatch_reported) {
+            std::fprintf(stderr, "format table mismatch: spine crc32=0x%08x, file crc32=0x%08x; "
+                                 "printing raw records\n",
+                         frame.table_crc32, table->crc32);
+            log->mismatch_reported = true;
+        }
+        table = &log->empty_table;
+    }
+
+    if (frame.flags & SPINE_LOG_FLAG_GAP) {
+        log->gap_count++;
+        std::printf("core=%u -- records lost before index %u --\n", frame.core, frame.first_index);
+    }
+
+    char line[LINE_BYTES];
+    for (std::size_t i = 0; i < frame.record_count; ++i) {
+        const SpineLogRecord& rec = frame.records[i];
+        spine_log_format(*table, rec, line, sizeof(line));
+        std::printf("core=%u index=%u t_us=%u %s\n", frame.core, rec.index, rec.time_us, line);
+    }
+    log->record_count += frame.record_count;
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    const char* tty_path = argv[1];
+    const char* fmt_path = nullptr;
+    long seconds = 0;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--fmt") == 0 && i + 1 < argc) {
+            fmt_path = argv[++i];
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+            seconds = std::strtol(argv[++i], nullptr, 10);
+            if (seconds <= 0) {
+                print_usage(argv[0]);
+                return 2;
+            }
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!fmt_path) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    SpineLogTable table;
+    if (!spine_log_table_load(fmt_path, &table)) {
+        std::perror(fmt_path);
+        return 1;
+    }
+
+    SerialPort port;
+    if (!serial_port_open(&port, tty_path)) {
+        std::perror(tty_path);
+        return 1;
+    }
+
+    std::signal(SIGINT, on_stop_signal);
+    std::signal(SIGTERM, on_stop_signal);
+
+    ByteStreamFramer framer;
+    bs_framer_init(&framer);
+    LogContext log = {};
+    log.table = &table;
+
+    uint8_t chunk[READ_CHUNK_BYTES];
+    const uint64_t deadline_ns =
+        (seconds > 0) ? monotonic_ns() + static_cast<uint64_t>(seconds) * NS_PER_S : 0;
+    int exit_code = 0;
+
+    while (!g_stop_requested && (deadline_ns == 0 || monotonic_ns() < deadline_ns)) {
+        const std::ptrdiff_t n = serial_port_read(&port, chunk, sizeof(chunk), READ_TIMEOUT_MS);
+        if (n < 0) {
+            std::perror(tty_path);
+            exit_code = 1;
+            break;
+        }
+        if (n > 0) {
+            bs_framer_push(&framer, chunk, static_cast<std::size_t>(n), on_frame, &log);
+        }
+    }
+
+    std::printf("link.log.frame_count=%llu link.log.record_count=%llu "
+                "link.log.gap_count=%llu link.log.parse_error_count=%llu "
+                "link.log.table_mismatch_count=%llu link.log.table_crc32=0x%08x\n",
+                static_cast<unsigned long long>(log.frame_count),
+                static_cast<unsigned long long>(log.record_count),
+                static_cast<unsigned long long>(log.gap_count),
+                static_cast<unsigned long long>(log.parse_error_count),
+                static_cast<unsigned long long>(log.table_mismatch_count),
+                table.crc32);
+
+    serial_port_close(&port);
+    return exit_code;
+}
@@ -0,0 +1,428 @@
+/**
+ * @file link_rtt_probe.cpp
+ * @brief Measure Brain -> Spine -> Brain round-trip time with S2B_ACK.
+ *
+ * Usage:
+ *   link_rtt_probe <tty> [options]
+ *   link_rtt_probe --spawn-spine PATH [options]
+ *
+ * Options:
+ *   --msg heartbeat|hello   probe message (default heartbeat)
+ *   --hz N                  probe rate (default 100)
+ *   --seconds N             run time, 0 = until SIGINT/SIGTERM (default 0)
+ *   --report-s N            interval report period (default 10)
+ *   --timeout-ms N          reply deadline before a probe counts lost (default 1000)
+ *
+ * Each probe carries the Brain send time (CLOCK_MONOTONIC ns, u64 LE) as
+ * its payload. The Spine echoes it in S2B_ACK together with the probe's
+ * seq; a reply is accepted only if both match an outstanding probe, so a
+ * late reply to a reused seq cannot be mis-attributed. RTT goes into an
+ * interval histogram (printed and folded into the run total every
+ * --report-s) and a run histogram (printed at exit):
+ *
+ *   link.rtt.scope=interval link.rtt.sent=1000 link.rtt.received=1000
+ *   link.rtt.lost=0 ... link.rtt.p50_us=212 link.rtt.p99_us=340 ...
+ *
+ * spine_hold_* is the Spine's own dispatch-to-encode time from the ACK
+ * timestamps, so the remainder of the RTT is USB, driver and scheduling.
+ *
+ * --spawn-spine runs PATH (the host build of scout_spine) on the master
+ * side of a fresh pty and probes the slave, which exercises the same tty
+ * path as a real device without one attached.
+ *
+ * Probing starts at the first valid Spine frame (any type), so boot time
+ * and stale tty input do not show up as loss or as the p999.
+ *
+ * B2S_HEARTBEAT probes also keep the Spine's link alive; HELLO probes do
+ * not. The tool owns the tty for its run, so stop link_telemetry_daemon.
+ * Exit status: 0 at least one reply, 1 I/O error, 3 no Spine or no replies.
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "bs_protocol.h"
+#include "link_ack.h"
+#include "link_latency_histogram.h"
+#include "link_serial_port.h"
+#include "link_timing_constants.h"
+
+using namespace s2t::link;
+using namespace s2t::protocol;
+
+static constexpr long DEFAULT_HZ = 100;
+static constexpr long DEFAULT_REPORT_S = 10;
+static constexpr long DEFAULT_TIMEOUT_MS = 1000;
+static constexpr long MAX_HZ = 10000;
+static constexpr uint64_t SPINE_WAIT_S = 5;
+static constexpr int SPINE_WAIT_READ_TIMEOUT_MS = 50;
+static constexpr std::size_t READ_CHUNK_BYTES = 512;
+static constexpr std::size_t SEQ_SPACE = 1u << 16;
+static constexpr uint64_t NS_PER_MS = NS_PER_US * US_PER_MS;
+
+static volatile std::sig_atomic_t g_stop_requested = 0;
+
+static void on_stop_signal(int)
+{
+    g_stop_requested = 1;
+}
+
+struct ProbeCounters {
+    uint64_t sent_count;
+    uint64_t received_count;
+    uint64_t lost_count;
+    uint64_t unmatched_count;    // no outstanding probe with that seq (late or duplicate)
+    uint64_t mismatch_count;     // seq outstanding but echo differs
+};
+
+struct ProbeContext {
+    uint8_t probe_msg_type;
+    bool spine_seen;
+    // Send time per seq; 0 = nothing outstanding.
+    std::vector<uint64_t> outstanding_ns;
+    ProbeCounters counters;
+    LatencyHistogram rtt;
+    LatencyHistogram spine_hold;
+};
+
+static void print_usage(const char* argv0)
+{
+    std::fprintf(stderr,
+                 "usage: %s <tty>|--spawn-spine PATH [--msg heartbeat|hello] [--hz N]\n"
+                 "       [--seconds N] [--report-s N] [--timeout-ms N]\n",
+                 argv0);
+}
+
+static uint64_t monotonic_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * NS_PER_S + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static void on_frame(const uint8_t* frame_buf, std::size_t frame_len, void* ctx)
+{
+    ProbeContext* probe = static_cast<ProbeContext*>(ctx);
+    const uint64_t now_ns = monotonic_ns();
+
+    PacketHeader header;
+    if (validate_packet(frame_buf, frame_len) != PacketStatus::OK ||
+        parse_and_validate_header(frame_buf, frame_len, &header) != HeaderStatus::OK ||
+        header.src != NODE_ID_SPINE) {
+        return;
+    }
+    probe->spine_seen = true;
+    if (header.msg_type != MSG_ID_S2B_ACK) {
+        return;
+    }
+
+    Ack ack;
+    if (ack_parse(frame_buf + HEADER_SIZE_BYTES, header.payload_len, &ack) != AckStatus::OK ||
+        ack.acked_msg_type != probe->probe_msg_type) {
+        probe->counters.unmatched_count++;
+        return;
+    }
+
+    uint64_t& sent_ns = probe->outstanding_ns[ack.acked_seq];
+    if (sent_ns == 0) {
+        probe->counters.unmatched_count++;
+        return;
+    }
+    if (ack.echo != sent_ns) {
+        probe->counters.mismatch_count++;
+        return;
+    }
+
+    probe->rtt.record(static_cast<uint32_t>((now_ns - sent_ns) / NS_PER_US));
+    probe->spine_hold.record(ack.spine_tx_time_us - ack.spine_rx_time_us);
+    probe->counters.received_count++;
+    sent_ns = 0;
+}
+
+static void print_report(const char* scope, const ProbeCounters& c, const LatencyHistogram& rtt,
+                         const LatencyHistogram& spine_hold)
+{
+    std::printf("link.rtt.scope=%s link.rtt.sent=%llu link.rtt.received=%llu link.rtt.lost=%llu "
+                "link.rtt.unmatched=%llu link.rtt.mismatch=%llu "
+                "link.rtt.min_us=%u link.rtt.mean_us=%llu link.rtt.p50_us=%u link.rtt.p99_us=%u "
+                "link.rtt.p999_us=%u link.rtt.max_us=%u "
+                "link.rtt.spine_hold_p99_us=%u link.rtt.spine_hold_max_us=%u\n",
+                scope,
+                static_cast<unsigned long long>(c.sent_count),
+                static_cast<unsigned long long>(c.received_count),
+                static_cast<unsigned long long>(c.lost_count),
+                static_cast<unsigned long long>(c.unmatched_count),
+                static_cast<unsigned long long>(c.mismatch_count),
+                rtt.min_us(),
+                static_cast<unsigned long long>(rtt.mean_us()),
+                rtt.percentile_us(0.50),
+                rtt.percentile_us(0.99),
+                rtt.percentile_us(0.999),
+                rtt.max_us(),
+                spine_hold.percentile_us(0.99),
+                spine_hold.max_us());
+    std::fflush(stdout);
+}
+
+static void add_counters(ProbeCounters* total, const ProbeCounters& interval)
+{
+    total->sent_count += interval.sent_count;
+    total->received_count += interval.received_count;
+    total->lost_count += interval.lost_count;
+    total->unmatched_count += interval.unmatched_count;
+    total->mismatch_count += interval.mismatch_count;
+}
+
+/**
+ * Start `path` with the master side of a new pty as its stdin/stdout.
+ * Writes the slave path to `slave_path` and the child pid to `pid_out`.
+ */
+static bool spawn_spine(const char* path, char* slave_path, std::size_t slave_cap, pid_t* pid_out)
+{
+    const int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0) {
+        return false;
+    }
+    const char* name = (grantpt(master) == 0 && unlockpt(master) == 0) ? ptsname(master) : nullptr;
+    if (!name || std::strlen(name) >= slave_cap) {
+        close(master);
+        return false;
+    }
+    std::strcpy(slave_path, name);
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        close(master);
+        return false;
+    }
+    if (pid == 0) {
+        dup2(master, STDIN_FILENO);
+        dup2(master, STDOUT_FILENO);
+        close(master);
+        execl(path, path, static_cast<char*>(nullptr));
+        _exit(127);
+    }
+
+    close(master);
+    *pid_out = pid;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    const char* tty_path = nullptr;
+    const char* spine_path = nullptr;
+    uint8_t probe_msg_type = MSG_ID_B2S_HEARTBEAT;
+    long hz = DEFAULT_HZ;
+    long seconds = 0;
+    long report_s = DEFAULT_REPORT_S;
+    long timeout_ms = DEFAULT_TIMEOUT_MS;
+
+    int first_option = 2;
+    if (std::strcmp(argv[1], "--spawn-spine") == 0 && argc > 2) {
+        spine_path = argv[2];
+        first_option = 3;
+    } else {
+        tty_path = argv[1];
+    }
+
+    for (int i = first_option; i < argc; ++i) {
+        const bool has_value = i + 1 < argc;
+        if (std::strcmp(argv[i], "--msg") == 0 && has_value) {
+            const char* name = argv[++i];
+            if (std::strcmp(name, "heartbeat") == 0) {
+                probe_msg_type = MSG_ID_B2S_HEARTBEAT;
+            } else if (std::strcmp(name, "hello") == 0) {
+                probe_msg_type = MSG_ID_B2S_HELLO;
+            } else {
+                hz = 0;
+            }
+        } else if (std::strcmp(argv[i], "--hz") == 0 && has_value) {
+            hz = std::strtol(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seconds") == 0 && has_value) {
+            seconds = std::strtol(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--report-s") == 0 && has_value) {
+            report_s = std::strtol(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--timeout-ms") == 0 && has_value) {
+            timeout_ms = std::strtol(argv[++i], nullptr, 10);
+        } else {
+            hz = 0;
+        }
+    }
+
+    // Every seq must be retired (answered or timed out) before it is reused.
+    if (hz <= 0 || hz > MAX_HZ || seconds < 0 || report_s <= 0 || timeout_ms <= 0 ||
+        static_cast<uint64_t>(hz) * static_cast<uint64_t>(timeout_ms) >= SEQ_SPACE * US_PER_MS) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    pid_t spine_pid = -1;
+    char slave_path[64];
+    if (spine_path) {
+        if (!spawn_spine(spine_path, slave_path, sizeof(slave_path), &spine_pid)) {
+            std::perror(spine_path);
+            return 1;
+        }
+        tty_path = slave_path;
+    }
+
+    std::signal(SIGINT, on_stop_signal);
+    std::signal(SIGTERM, on_stop_signal);
+
+    SerialPort port;
+    if (!serial_port_open(&port, tty_path)) {
+        std::perror(tty_path);
+        if (spine_pid > 0) {
+            kill(spine_pid, SIGTERM);
+            waitpid(spine_pid, nullptr, 0);
+        }
+        return 1;
+    }
+
+    ProbeContext probe;
+    probe.probe_msg_type = probe_msg_type;
+    probe.spine_seen = false;
+    probe.outstanding_ns.assign(SEQ_SPACE, 0);
+    probe.counters = {};
+
+    ProbeCounters total_counters = {};
+    LatencyHistogram total_rtt;
+    LatencyHistogram total_spine_hold;
+
+    ByteStreamFramer framer;
+    bs_framer_init(&framer);
+
+    PacketHeader fields = {};
+    fields.msg_type = probe_msg_type;
+    fields.src = NODE_ID_BRAIN;
+    fields.dst = NODE_ID_SPINE;
+    uint8_t frame[MAX_FRAME_BUFFER_SIZE];
+    uint8_t chunk[READ_CHUNK_BYTES];
+
+    int exit_code = 0;
+    const uint64_t wait_deadline_ns = monotonic_ns() + SPINE_WAIT_S * NS_PER_S;
+    while (!probe.spine_seen && !g_stop_requested && monotonic_ns() < wait_deadline_ns) {
+        const std::ptrdiff_t n = serial_port_read(&port, chunk, sizeof(chunk), SPINE_WAIT_READ_TIMEOUT_MS);
+        if (n < 0) {
+            std::perror(tty_path);
+            exit_code = 1;
+            break;
+        }
+        if (n > 0) {
+            bs_framer_push(&framer, chunk, static_cast<std::size_t>(n), on_frame, &probe);
+        }
+    }
+    if (exit_code == 0 && !probe.spine_seen) {
+        std::fprintf(stderr, "%s: no Spine frames\n", tty_path);
+        exit_code = 3;
+    }
+
+    const uint64_t period_ns = NS_PER_S / static_cast<uint64_t>(hz);
+    const uint64_t timeout_ns = static_cast<uint64_t>(timeout_ms) * NS_PER_MS;
+    const uint64_t start_ns = monotonic_ns();
+    const uint64_t end_ns = seconds ? start_ns + static_cast<uint64_t>(seconds) * NS_PER_S : UINT64_MAX;
+    uint64_t next_send_ns = start_ns;
+    uint64_t next_report_ns = start_ns + static_cast<uint64_t>(report_s) * NS_PER_S;
+    uint16_t next_seq = 0;
+    uint16_t oldest_seq = 0;
+
+    while (exit_code == 0 && !g_stop_requested) {
+        uint64_t now_ns = monotonic_ns();
+        if (now_ns >= end_ns) {
+            break;
+        }
+
+        if (now_ns >= next_send_ns) {
+            // Send time doubles as the echo, so it must never be 0 (the free marker).
+            const uint64_t t1_ns = now_ns;
+            uint8_t payload[ACK_ECHO_BYTES];
+            for (std::size_t b = 0; b < sizeof(payload); ++b) {
+                payload[b] = static_cast<uint8_t>(t1_ns >> (8u * b));
+            }
+            fields.seq = next_seq;
+            std::size_t frame_len = 0;
+            if (encode_packet(&fields, payload, sizeof(payload), frame, sizeof(frame), &frame_len) != EncodeStatus::OK ||
+                !serial_port_write_all(&port, frame, frame_len)) {
+                std::perror(tty_path);
+                exit_code = 1;
+                break;
+            }
+            probe.outstanding_ns[next_seq] = t1_ns;
+            probe.counters.sent_count++;
+            next_seq++;
+
+            // Fixed-rate schedule; after a stall, resume rather than burst.
+            next_send_ns += period_ns;
+            if (next_send_ns < now_ns) {
+                next_send_ns = now_ns + period_ns;
+            }
+        }
+
+        // Retire probes in send order: answered ones are already 0.
+        while (oldest_seq != next_seq) {
+            const uint64_t sent_ns = probe.outstanding_ns[oldest_seq];
+            if (sent_ns != 0) {
+                if (now_ns - sent_ns < timeout_ns) {
+                    break;
+                }
+                probe.outstanding_ns[oldest_seq] = 0;
+                probe.counters.lost_count++;
+            }
+            oldest_seq++;
+        }
+
+        const uint64_t wait_ns = (next_send_ns > now_ns) ? next_send_ns - now_ns : 0;
+        const std::ptrdiff_t n = serial_port_read(&port, chunk, sizeof(chunk), static_cast<int>(wait_ns / NS_PER_MS));
+        if (n < 0) {
+            std::perror(tty_path);
+            exit_code = 1;
+            break;
+        }
+        if (n > 0) {
+            bs_framer_push(&framer, chunk, static_cast<std::size_t>(n), on_frame, &probe);
+        }
+
+        now_ns = monotonic_ns();
+        if (now_ns >= next_report_ns) {
+            print_report("interval", probe.counters, probe.rtt, probe.spine_hold);
+            add_counters(&total_counters, probe.counters);
+            total_rtt.merge(probe.rtt);
+            total_spine_hold.merge(probe.spine_hold);
+            probe.counters = {};
+            probe.rtt.reset();
+            probe.spine_hold.reset();
+            next_report_ns += static_cast<uint64_t>(report_s) * NS_PER_S;
+        }
+    }
+
+    // Probes still in flight at exit are neither received nor lost.
+    add_counters(&total_counters, probe.counters);
+    total_rtt.merge(probe.rtt);
+    total_spine_hold.merge(probe.spine_hold);
+    print_report("total", total_counters, total_rtt, total_spine_hold);
+
+    serial_port_close(&port);
+    if (spine_pid > 0) {
+        kill(spine_pid, SIGTERM);
+        waitpid(spine_pid, nullptr, 0);
+    }
+
+    if (exit_code == 0 && total_counters.received_count == 0) {
+        exit_code = 3;
+    }
+    return exit_code;
+}
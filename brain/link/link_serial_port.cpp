@@ -0,0 +1,215 @@
+/**
+ * @file link_serial_port.cpp
+ * @brief Raw tty transport for the Brain side of the Brain <-> Spine link.
+ *
+ * Blocking writes and bounded-wait reads. The receive path is driven by
+ * whichever component calls serial_port_read(); this file does not spawn
+ * threads.
+ */
+
+#include "link_serial_port.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace s2t {
+namespace link {
+
+bool serial_port_open(SerialPort* port, const char* path)
+{
+    if (!port || !path) {
+        errno = EINVAL;
+        return false;
+    }
+
+    const int fd = ::open(path, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (fd < 0) {
+        port->fd = -1;
+        return false;
+    }
+
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0) {
+        const int saved = errno;
+        ::close(fd);
+        errno = saved;
+        port->fd = -1;
+        return false;
+    }
+
+    // Raw bytes: no echo, no canonical mode, no CR/LF translation.
+    // Baud rate is irrelevant for USB CDC but set explicitly for real UARTs.
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tio.c_cflag |= (CLOCAL | CREAD);
+    tio.c_cc[VMIN]  = 1;
+    tio.c_cc[VTIME] = 0;
+
+    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+        const int saved = errno;
+        ::close(fd);
+        errno = saved;
+        port->fd = -1;
+        return false;
+    }
+
+    port->fd = fd;
+    port->bytes_written = 0;
+    port->write_error_count = 0;
+    port->bytes_read = 0;
+    port->read_error_count = 0;
+    return true;
+}
+
+void serial_port_close(SerialPort* port)
+{
+    if (!port || port->fd < 0) {
+        return;
+    }
+    ::close(port->fd);
+    port->fd = -1;
+}
+
+bool serial_port_write_all(SerialPort* port, const uint8_t* data, std::size_t len)
+{
+    if (!port || port->fd < 0 || (!data && len > 0)) {
+        return false;
+    }
+
+    std::size_t done = 0;
+    while (done < len) {
+        const ssize_t n = ::write(port->fd, data + done, len - done);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            port->write_error_count++;
+            return false;
+        }
+        done += static_cast<std::size_t>(n);
+    }
+
+    port->bytes_written += len;
+    return true;
+}
+
+bool serial_port_writev_all(SerialPort* port, const struct iovec* iov, std::size_t count)
+{
+    if (!port || port->fd < 0 || (!iov && count > 0)) {
+        return false;
+    }
+
+    // Local copy so short writes can advance it.
+    if (count > SERIAL_WRITEV_MAX_BUFFERS) {
+        return false;
+    }
+    struct iovec local[SERIAL_WRITEV_MAX_BUFFERS];
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        local[i] = iov[i];
+        total += iov[i].iov_len;
+    }
+
+    std::size_t first = 0;
+    std::size_t done = 0;
+    while (done < total) {
+        const ssize_t n = ::writev(port->fd, local + first, static_cast<int>(count - first));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            port->write_error_count++;
+            return false;
+        }
+
+        done += static_cast<std::size_t>(n);
+        std::size_t advance = static_cast<std::size_t>(n);
+        while (first < count && advance >= local[first].iov_len) {
+            advance -= local[first].iov_len;
+            ++first;
+        }
+        if (first < count) {
+            local[first].iov_base = static_cast<uint8_t*>(local[first].iov_base) + advance;
+            local[first].iov_len -= advance;
+        }
+    }
+
+    port->bytes_written += total;
+    return true;
+}
+
+std::ptrdiff_t serial_port_read(SerialPort* port, uint8_t* buf, std::size_t cap, int timeout_ms)
+{
+    if (!port || port->fd < 0 || !buf || cap == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    struct pollfd pfd = { port->fd, POLLIN, 0 };
+    const int ready = ::poll(&pfd, 1, timeout_ms);
+    if (ready < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        port->read_error_count++;
+        return -1;
+    }
+    if (ready == 0) {
+        return 0;
+    }
+
+    const ssize_t n = ::read(port->fd, buf, cap);
+    if (n < 0) {
+        if (errno == EINTR || errno == EAGAIN) {
+            return 0;
+        }
+        port->read_error_count++;
+        return -1;
+    }
+    if (n == 0) {
+        // POLLIN with no data: the tty hung up.
+        port->read_error_count++;
+        errno = EPIPE;
+        return -1;
+    }
+
+    port->bytes_read += static_cast<uint64_t>(n);
+    return n;
+}
+
+std::size_t serial_port_output_queue_bytes(const SerialPort* port)
+{
+    if (!port || port->fd < 0) {
+        return 0;
+    }
+    int queued = 0;
+    if (::ioctl(port->fd, TIOCOUTQ, &queued) != 0 || queued < 0) {
+        return 0;
+    }
+    return static_cast<std::size_t>(queued);
+}
+
+std::size_t serial_port_backlog_probe(void* ctx)
+{
+    return serial_port_output_queue_bytes(static_cast<const SerialPort*>(ctx));
+}
+
+bool serial_port_frame_sink(const uint8_t* frame, std::size_t frame_len, void* ctx)
+{
+    SerialPort* port = static_cast<SerialPort*>(ctx);
+    return serial_port_write_all(port, frame, frame_len);
+}
+
+bool serial_port_frame_batch_sink(const struct iovec* frames, std::size_t frame_count, void* ctx)
+{
+    SerialPort* port = static_cast<SerialPort*>(ctx);
+    return serial_port_writev_all(port, frames, frame_count);
+}
+
+} // namespace link
+} // namespace s2t
@@ -0,0 +1,84 @@
+#ifndef LINK_SERIAL_PORT_H
+#define LINK_SERIAL_PORT_H
+
+#include <cstdint>
+#include <cstddef>
+#include <sys/uio.h>
+
+/**
+ * @file link_serial_port.h
+ * @brief Raw byte transport over a Linux tty (USB CDC to the Spine).
+ *
+ * Transport provides bytes only; no framing or semantics live here.
+ *
+ * Ownership: the SerialPort owns its file descriptor from a successful
+ * serial_port_open() until serial_port_close().
+ */
+
+namespace s2t {
+namespace link {
+
+// Most buffers one serial_port_writev_all() call accepts (well below IOV_MAX).
+static constexpr std::size_t SERIAL_WRITEV_MAX_BUFFERS = 64;
+
+struct SerialPort {
+    int fd = -1;
+    uint64_t bytes_written = 0;
+    uint64_t write_error_count = 0;
+    uint64_t bytes_read = 0;
+    uint64_t read_error_count = 0;
+};
+
+/**
+ * Open `path` in raw 8N1 mode with no line discipline.
+ * Returns false (and leaves port->fd == -1) on failure; errno is preserved.
+ */
+bool serial_port_open(SerialPort* port, const char* path);
+
+void serial_port_close(SerialPort* port);
+
+/**
+ * Write all `len` bytes, retrying on EINTR and short writes.
+ * Returns false on any other error.
+ */
+bool serial_port_write_all(SerialPort* port, const uint8_t* data, std::size_t len);
+
+/**
+ * Write every byte of `count` buffers, in order, with as few writev()
+ * calls as the driver allows. Same retry rules as serial_port_write_all.
+ * Returns false if `count` exceeds SERIAL_WRITEV_MAX_BUFFERS.
+ */
+bool serial_port_writev_all(SerialPort* port, const struct iovec* iov, std::size_t count);
+
+/**
+ * Wait up to `timeout_ms` for input, then read at most `cap` bytes.
+ * Returns the byte count, 0 on timeout or EINTR, and -1 on error or
+ * hangup (the Spine was unplugged); errno is preserved.
+ */
+std::ptrdiff_t serial_port_read(SerialPort* port, uint8_t* buf, std::size_t cap, int timeout_ms);
+
+/**
+ * Bytes written but not yet transmitted by the driver (TIOCOUTQ).
+ * Returns 0 if the port is closed or the driver cannot tell.
+ */
+std::size_t serial_port_output_queue_bytes(const SerialPort* port);
+
+/**
+ * TxBacklogProbe adapter: `ctx` must point to an open SerialPort.
+ */
+std::size_t serial_port_backlog_probe(void* ctx);
+
+/**
+ * FrameSink adapter: `ctx` must point to an open SerialPort.
+ */
+bool serial_port_frame_sink(const uint8_t* frame, std::size_t frame_len, void* ctx);
+
+/**
+ * FrameBatchSink adapter: `ctx` must point to an open SerialPort.
+ */
+bool serial_port_frame_batch_sink(const struct iovec* frames, std::size_t frame_count, void* ctx);
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_SERIAL_PORT_H
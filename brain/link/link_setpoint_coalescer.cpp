@@ -0,0 +1,293 @@
+/**
+ * @file link_setpoint_coalescer.cpp
+ * @brief Latest-wins B2S_MOTION_SETPOINT slots drained by one paced thread.
+ *
+ * Wake-ups:
+ * - wake eventfd: submit() stored a setpoint
+ * - timerfd (absolute): the earliest rate-limited slot becomes due
+ * - stop eventfd: stop()
+ *
+ * Every wake-up runs service(): each pending slot whose interval has
+ * elapsed is taken under the lock, and the frames are encoded and sent
+ * outside it so submit() never waits on the transport.
+ */
+
+#include "link_setpoint_coalescer.h"
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+namespace s2t {
+namespace link {
+
+static uint64_t monotonic_now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * NS_PER_S +
+           static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static struct timespec ns_to_timespec(uint64_t ns)
+{
+    struct timespec ts;
+    ts.tv_sec  = static_cast<time_t>(ns / NS_PER_S);
+    ts.tv_nsec = static_cast<long>(ns % NS_PER_S);
+    return ts;
+}
+
+static void close_fd(int* fd)
+{
+    if (*fd >= 0) {
+        ::close(*fd);
+        *fd = -1;
+    }
+}
+
+SetpointCoalescer::SetpointCoalescer(const SetpointCoalescerConfig& config,
+                                     FrameSink sink,
+                                     void* sink_ctx)
+    : config_(config), sink_(sink), sink_ctx_(sink_ctx)
+{
+}
+
+SetpointCoalescer::~SetpointCoalescer()
+{
+    stop();
+}
+
+SchedulerStatus SetpointCoalescer::start()
+{
+    if (thread_.joinable()) {
+        return SchedulerStatus::ERR_ALREADY_RUNNING;
+    }
+    if (!sink_ || config_.min_interval_us == 0) {
+        return SchedulerStatus::ERR_INVALID_CONFIG;
+    }
+
+    timer_fd_ = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+    if (timer_fd_ < 0) {
+        return SchedulerStatus::ERR_TIMERFD;
+    }
+
+    stop_fd_ = eventfd(0, EFD_CLOEXEC);
+    const int wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (stop_fd_ < 0 || wake_fd < 0) {
+        if (wake_fd >= 0) {
+            ::close(wake_fd);
+        }
+        close_fd(&stop_fd_);
+        close_fd(&timer_fd_);
+        return SchedulerStatus::ERR_EVENTFD;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(slots_mutex_);
+        wake_fd_ = wake_fd;
+    }
+
+    try {
+        thread_ = std::thread(&SetpointCoalescer::run, this);
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(slots_mutex_);
+            close_fd(&wake_fd_);
+        }
+        close_fd(&stop_fd_);
+        close_fd(&timer_fd_);
+        return SchedulerStatus::ERR_THREAD;
+    }
+
+    return SchedulerStatus::OK;
+}
+
+void SetpointCoalescer::stop()
+{
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    const uint64_t one = 1;
+    (void)::write(stop_fd_, &one, sizeof(one));
+    thread_.join();
+
+    {
+        std::lock_guard<std::mutex> lock(slots_mutex_);
+        close_fd(&wake_fd_);
+    }
+    close_fd(&stop_fd_);
+    close_fd(&timer_fd_);
+}
+
+SetpointStatus SetpointCoalescer::submit(std::size_t stream,
+                                         const uint8_t* payload,
+                                         std::size_t payload_len)
+{
+    if (stream >= SETPOINT_MAX_STREAMS || (!payload && payload_len > 0)) {
+        return SetpointStatus::ERR_INVALID_ARGS;
+    }
+    if (payload_len > protocol::MAX_PAYLOAD_SIZE_BYTES) {
+        return SetpointStatus::ERR_PAYLOAD_TOO_LARGE;
+    }
+
+    const uint64_t now_ns = monotonic_now_ns();
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+
+    Slot& slot = slots_[stream];
+    if (slot.pending) {
+        coalesced_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+    slot.pending = true;
+    slot.payload_len = static_cast<uint16_t>(payload_len);
+    slot.submit_ns = now_ns;
+    if (payload_len > 0) {
+        std::memcpy(slot.payload, payload, payload_len);
+    }
+    submitted_count_.fetch_add(1, std::memory_order_relaxed);
+
+    if (wake_fd_ >= 0) {
+        // Non-blocking; a saturated counter still leaves the thread awake.
+        const uint64_t one = 1;
+        (void)::write(wake_fd_, &one, sizeof(one));
+    }
+    return SetpointStatus::OK;
+}
+
+SetpointMetrics SetpointCoalescer::metrics() const
+{
+    SetpointMetrics m;
+    m.submitted_count  = submitted_count_.load(std::memory_order_relaxed);
+    m.sent_count       = sent_count_.load(std::memory_order_relaxed);
+    m.send_error_count = send_error_count_.load(std::memory_order_relaxed);
+    m.coalesced_count  = coalesced_count_.load(std::memory_order_relaxed);
+    m.age_last_us      = age_last_us_.load(std::memory_order_relaxed);
+    m.age_max_us       = age_max_us_.load(std::memory_order_relaxed);
+    m.age_total_us     = age_total_us_.load(std::memory_order_relaxed);
+    return m;
+}
+
+void SetpointCoalescer::send_one(const Slot& taken)
+{
+    protocol::PacketHeader fields = {};
+    fields.msg_type = protocol::MSG_ID_B2S_MOTION_SETPOINT;
+    fields.flags    = 0;
+    fields.src      = protocol::NODE_ID_BRAIN;
+    fields.dst      = protocol::NODE_ID_SPINE;
+    fields.seq      = next_seq_;
+
+    uint8_t frame[protocol::MAX_FRAME_BUFFER_SIZE];
+    std::size_t frame_len = 0;
+    const protocol::EncodeStatus es = protocol::encode_packet(
+        &fields, taken.payload, taken.payload_len, frame, sizeof(frame), &frame_len);
+    if (es != protocol::EncodeStatus::OK) {
+        send_error_count_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const uint64_t now_ns = monotonic_now_ns();
+    const uint64_t age_ns = (now_ns > taken.submit_ns) ? (now_ns - taken.submit_ns) : 0;
+    const uint32_t age_us = static_cast<uint32_t>(age_ns / NS_PER_US);
+
+    const bool ok = sink_(frame, frame_len, sink_ctx_);
+    next_seq_++;
+
+    if (!ok) {
+        send_error_count_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    sent_count_.fetch_add(1, std::memory_order_relaxed);
+    age_last_us_.store(age_us, std::memory_order_relaxed);
+    age_total_us_.fetch_add(age_us, std::memory_order_relaxed);
+    if (age_us > age_max_us_.load(std::memory_order_relaxed)) {
+        age_max_us_.store(age_us, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Send every slot that is pending and due. Returns the absolute time the
+ * next pending slot becomes due, or 0 if nothing is left pending.
+ */
+uint64_t SetpointCoalescer::service(uint64_t now_ns)
+{
+    const uint64_t interval_ns = static_cast<uint64_t>(config_.min_interval_us) * NS_PER_US;
+
+    Slot taken[SETPOINT_MAX_STREAMS];
+    std::size_t taken_count = 0;
+    uint64_t next_due_ns = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(slots_mutex_);
+        for (std::size_t i = 0; i < SETPOINT_MAX_STREAMS; ++i) {
+            Slot& slot = slots_[i];
+            if (!slot.pending) {
+                continue;
+            }
+            const uint64_t due_ns = (slot.last_sent_ns == 0) ? 0 : slot.last_sent_ns + interval_ns;
+            if (now_ns >= due_ns) {
+                taken[taken_count++] = slot;
+                slot.pending = false;
+                slot.last_sent_ns = now_ns;
+            } else if (next_due_ns == 0 || due_ns < next_due_ns) {
+                next_due_ns = due_ns;
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < taken_count; ++i) {
+        send_one(taken[i]);
+    }
+    return next_due_ns;
+}
+
+void SetpointCoalescer::run()
+{
+    struct pollfd fds[3];
+    fds[0].fd = timer_fd_;
+    fds[0].events = POLLIN;
+    fds[1].fd = wake_fd_;
+    fds[1].events = POLLIN;
+    fds[2].fd = stop_fd_;
+    fds[2].events = POLLIN;
+
+    while (true) {
+        fds[0].revents = 0;
+        fds[1].revents = 0;
+        fds[2].revents = 0;
+
+        const int rc = poll(fds, 3, -1);
+        if (rc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[2].revents & POLLIN) {
+            return;
+        }
+
+        // Drain both counters; the slots carry the actual state.
+        uint64_t count = 0;
+        if (fds[0].revents & POLLIN) {
+            (void)::read(timer_fd_, &count, sizeof(count));
+        }
+        if (fds[1].revents & POLLIN) {
+            (void)::read(wake_fd_, &count, sizeof(count));
+        }
+
+        const uint64_t next_due_ns = service(monotonic_now_ns());
+
+        // Absolute one-shot for the next rate-limited slot; zero disarms.
+        struct itimerspec spec = {};
+        spec.it_value = ns_to_timespec(next_due_ns);
+        timerfd_settime(timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr);
+    }
+}
+
+} // namespace link
+} // namespace s2t
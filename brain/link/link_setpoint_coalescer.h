@@ -0,0 +1,134 @@
+#ifndef LINK_SETPOINT_COALESCER_H
+#define LINK_SETPOINT_COALESCER_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include "bs_protocol.h"
+#include "link_frame_sink.h"
+#include "link_heartbeat_scheduler.h"
+#include "link_timing_constants.h"
+
+/**
+ * @file link_setpoint_coalescer.h
+ * @brief Latest-wins, rate-limited B2S_MOTION_SETPOINT sender.
+ *
+ * The planner may produce setpoints faster than the link drains. Queuing
+ * them all only adds latency: every stale setpoint still in a buffer delays
+ * the one that matters. Instead each stream (axis, controller, ...) has ONE
+ * slot. submit() overwrites it; the sender thread transmits whatever is in
+ * the slot, at most once per min_interval_us per stream.
+ *
+ * Command latency is then bounded by one interval plus the time to send a
+ * single frame, whatever rate the planner runs at. Setpoints overwritten
+ * before they were sent are counted as coalesced.
+ *
+ * Age of a transmitted setpoint = time it reached the sink - time it was
+ * submitted. The metrics report last, mean and max.
+ *
+ * Payload bytes are opaque here; the caller encodes them.
+ *
+ * Lifecycle matches HeartbeatScheduler: constructed idle, start() spawns
+ * the thread, stop() (and the destructor) wake and join it. submit() is
+ * safe from any thread, running or not; nothing is sent until start().
+ *
+ * Ownership: the coalescer owns its thread, timerfd, eventfds and sequence
+ * counter. The FrameSink and its context are borrowed and must outlive
+ * the running thread.
+ */
+
+namespace s2t {
+namespace link {
+
+    static constexpr std::size_t SETPOINT_MAX_STREAMS = 4;
+
+    // Default per-stream ceiling: 50 Hz.
+    static constexpr uint32_t SETPOINT_DEFAULT_MIN_INTERVAL_US = 20 * US_PER_MS;
+
+struct SetpointCoalescerConfig {
+    // Minimum spacing between two sends on the same stream.
+    uint32_t min_interval_us = SETPOINT_DEFAULT_MIN_INTERVAL_US;
+};
+
+enum class SetpointStatus {
+    OK = 0,
+    ERR_INVALID_ARGS,
+    ERR_PAYLOAD_TOO_LARGE
+};
+
+struct SetpointMetrics {
+    uint64_t submitted_count  = 0;
+    uint64_t sent_count       = 0;
+    uint64_t send_error_count = 0;
+    uint64_t coalesced_count  = 0;  // overwritten before they were sent
+    uint32_t age_last_us      = 0;
+    uint32_t age_max_us       = 0;
+    uint64_t age_total_us     = 0;  // sum over sent_count, for the mean
+};
+
+class SetpointCoalescer {
+public:
+    SetpointCoalescer(const SetpointCoalescerConfig& config,
+                      FrameSink sink,
+                      void* sink_ctx);
+    ~SetpointCoalescer();
+
+    SetpointCoalescer(const SetpointCoalescer&) = delete;
+    SetpointCoalescer& operator=(const SetpointCoalescer&) = delete;
+
+    SchedulerStatus start();
+    void stop();
+
+    bool running() const { return thread_.joinable(); }
+
+    /**
+     * Replace the pending setpoint on `stream` (< SETPOINT_MAX_STREAMS).
+     * Copies `payload`; never blocks on the link.
+     */
+    SetpointStatus submit(std::size_t stream, const uint8_t* payload, std::size_t payload_len);
+
+    SetpointMetrics metrics() const;
+
+private:
+    struct Slot {
+        bool     pending      = false;
+        uint16_t payload_len  = 0;
+        uint64_t submit_ns    = 0;
+        uint64_t last_sent_ns = 0;
+        uint8_t  payload[protocol::MAX_PAYLOAD_SIZE_BYTES];
+    };
+
+    void run();
+    uint64_t service(uint64_t now_ns);
+    void send_one(const Slot& taken);
+
+    SetpointCoalescerConfig config_;
+    FrameSink sink_;
+    void* sink_ctx_;
+
+    std::thread thread_;
+    int timer_fd_ = -1;
+    int wake_fd_  = -1;
+    int stop_fd_  = -1;
+
+    std::mutex slots_mutex_;
+    Slot slots_[SETPOINT_MAX_STREAMS];
+
+    uint16_t next_seq_ = 0;
+
+    std::atomic<uint64_t> submitted_count_{0};
+    std::atomic<uint64_t> sent_count_{0};
+    std::atomic<uint64_t> send_error_count_{0};
+    std::atomic<uint64_t> coalesced_count_{0};
+    std::atomic<uint32_t> age_last_us_{0};
+    std::atomic<uint32_t> age_max_us_{0};
+    std::atomic<uint64_t> age_total_us_{0};
+};
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_SETPOINT_COALESCER_H
@@ -0,0 +1,216 @@
+/**
+ * @file link_spine_log.cpp
+ * @brief S2B_LOG payload parsing, format table loading and text rebuild.
+ */
+
+#include "link_spine_log.h"
+#include "link_wire.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#include "bs_c_api.h"
+
+namespace s2t {
+namespace link {
+
+namespace {
+
+// Longest single conversion spec we rebuild: '%', flags, width, '.',
+// precision, conversion, NUL.
+constexpr std::size_t SPEC_BYTES = 24;
+
+// Append with snprintf semantics; `used` saturates at cap - 1.
+void append(char* buf, std::size_t cap, std::size_t* used, const char* text, std::size_t len)
+{
+    const std::size_t room = cap - 1 - *used;
+    const std::size_t n = (len < room) ? len : room;
+    std::memcpy(buf + *used, text, n);
+    *used += n;
+    buf[*used] = '\0';
+}
+
+bool is_flag(char c)
+{
+    return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0';
+}
+
+bool is_length_modifier(char c)
+{
+    return c == 'h' || c == 'l' || c == 'j' || c == 'z' || c == 't' || c == 'L';
+}
+
+} // namespace
+
+bool spine_log_table_load(const char* path, SpineLogTable* out)
+{
+    if (!path || !out) {
+        errno = EINVAL;
+        return false;
+    }
+
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+
+    out->bytes.clear();
+    char chunk[4096];
+    std::size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), f)) > 0) {
+        out->bytes.insert(out->bytes.end(), chunk, chunk + n);
+    }
+    const bool ok = !std::ferror(f);
+    std::fclose(f);
+
+    out->crc32 = s2t_crc32_iso_hdlc(reinterpret_cast<const uint8_t*>(out->bytes.data()),
+                                    out->bytes.size());
+    return ok;
+}
+
+SpineLogStatus spine_log_parse(const uint8_t* payload, std::size_t payload_len, SpineLogFrame* out)
+{
+    if (!payload || !out) {
+        return SpineLogStatus::ERR_NULL;
+    }
+    if (payload_len < SPINE_LOG_FRAME_HEADER_BYTES) {
+        return SpineLogStatus::ERR_TOO_SHORT;
+    }
+    if (payload[0] != SPINE_LOG_LAYOUT_VERSION) {
+        return SpineLogStatus::ERR_LAYOUT_VERSION;
+    }
+    if (payload[1] >= SPINE_LOG_CORE_COUNT) {
+        return SpineLogStatus::ERR_CORE;
+    }
+
+    const std::size_t count = payload[2];
+    if (count > SPINE_LOG_MAX_RECORDS_PER_FRAME) {
+        return SpineLogStatus::ERR_RECORD;
+    }
+
+    out->core = payload[1];
+    out->record_count = static_cast<uint8_t>(count);
+    out->flags = payload[3];
+    out->table_crc32 = get_u32_le(payload + 4);
+    out->first_index = get_u32_le(payload + 8);
+
+    // Records are variable length; the last one must end exactly at the
+    // end of the payload.
+    std::size_t offset = SPINE_LOG_FRAME_HEADER_BYTES;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (payload_len - offset < SPINE_LOG_RECORD_HEADER_BYTES) {
+            return SpineLogStatus::ERR_RECORD;
+        }
+        const uint8_t* r = payload + offset;
+        SpineLogRecord& rec = out->records[i];
+        rec.index = out->first_index + static_cast<uint32_t>(i);
+        rec.time_us = get_u32_le(r + 0);
+        rec.fmt_id = static_cast<uint16_t>(get_u16_le(r + 4));
+        rec.arg_count = r[6];
+        if (rec.arg_count > SPINE_LOG_MAX_ARGS ||
+            payload_len - offset - SPINE_LOG_RECORD_HEADER_BYTES < rec.arg_count * 4u) {
+            return SpineLogStatus::ERR_RECORD;
+        }
+        for (std::size_t a = 0; a < rec.arg_count; ++a) {
+            rec.args[a] = get_u32_le(r + SPINE_LOG_RECORD_HEADER_BYTES + a * 4);
+        }
+        offset += SPINE_LOG_RECORD_HEADER_BYTES + rec.arg_count * 4u;
+    }
+    if (offset != payload_len) {
+        return SpineLogStatus::ERR_RECORD;
+    }
+    return SpineLogStatus::OK;
+}
+
+void spine_log_format(const SpineLogTable& table, const SpineLogRecord& record,
+                      char* buf, std::size_t cap)
+{
+    if (!buf || cap == 0) {
+        return;
+    }
+    buf[0] = '\0';
+
+    // The string must start inside the table and end with its NUL there.
+    const std::size_t table_len = table.bytes.size();
+    const char* fmt = (record.fmt_id < table_len) ? table.bytes.data() + record.fmt_id : nullptr;
+    if (!fmt || !std::memchr(fmt, '\0', table_len - record.fmt_id)) {
+        int used = std::snprintf(buf, cap, "FMT_0x%04x", record.fmt_id);
+        for (std::size_t a = 0; a < record.arg_count && used >= 0 &&
+                                static_cast<std::size_t>(used) < cap; ++a) {
+            used += std::snprintf(buf + used, cap - used, " arg%zu=%u", a, record.args[a]);
+        }
+        return;
+    }
+
+    std::size_t used = 0;
+    std::size_t next_arg = 0;
+    const char* p = fmt;
+    while (*p != '\0' && used < cap - 1) {
+        const char* percent = std::strchr(p, '%');
+        if (!percent) {
+            append(buf, cap, &used, p, std::strlen(p));
+            break;
+        }
+        append(buf, cap, &used, p, static_cast<std::size_t>(percent - p));
+        p = percent + 1;
+
+        if (*p == '%') {
+            append(buf, cap, &used, "%", 1);
+            ++p;
+            continue;
+        }
+
+        // Rebuild the spec without length modifiers.
+        char spec[SPEC_BYTES];
+        std::size_t spec_len = 0;
+        spec[spec_len++] = '%';
+        while (is_flag(*p) && spec_len < SPEC_BYTES - 2) {
+            spec[spec_len++] = *p++;
+        }
+        while (*p >= '0' && *p <= '9' && spec_len < SPEC_BYTES - 2) {
+            spec[spec_len++] = *p++;
+        }
+        if (*p == '.') {
+            spec[spec_len++] = *p++;
+            while (*p >= '0' && *p <= '9' && spec_len < SPEC_BYTES - 2) {
+                spec[spec_len++] = *p++;
+            }
+        }
+        while (is_length_modifier(*p)) {
+            ++p;
+        }
+
+        const char conv = *p;
+        if (conv != '\0') {
+            ++p;
+        }
+        const bool integer = conv == 'd' || conv == 'i' || conv == 'u' ||
+                             conv == 'x' || conv == 'X' || conv == 'o' || conv == 'c';
+        if (!integer || next_arg >= record.arg_count || spec_len >= SPEC_BYTES - 1) {
+            append(buf, cap, &used, "<?>", 3);
+            continue;
+        }
+        spec[spec_len++] = conv;
+        spec[spec_len] = '\0';
+
+        const uint32_t arg = record.args[next_arg++];
+        char text[64];
+        int n;
+        if (conv == 'd' || conv == 'i') {
+            n = std::snprintf(text, sizeof(text), spec, static_cast<int32_t>(arg));
+        } else if (conv == 'c') {
+            n = std::snprintf(text, sizeof(text), spec, static_cast<int>(arg & 0xFFu));
+        } else {
+            n = std::snprintf(text, sizeof(text), spec, arg);
+        }
+        if (n > 0) {
+            const std::size_t len = (static_cast<std::size_t>(n) < sizeof(text))
+                                        ? static_cast<std::size_t>(n) : sizeof(text) - 1;
+            append(buf, cap, &used, text, len);
+        }
+    }
+}
+
+} // namespace link
+} // namespace s2t
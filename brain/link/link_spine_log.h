@@ -0,0 +1,97 @@
+#ifndef LINK_SPINE_LOG_H
+#define LINK_SPINE_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bs_protocol.h"
+
+/**
+ * @file link_spine_log.h
+ * @brief Decoder for S2B_LOG, the Spine's deferred-format log stream.
+ *
+ * The Spine never formats log text. Each record carries a format ID (the
+ * string's offset in the firmware's spine_log_fmt section) and up to
+ * SPINE_LOG_MAX_ARGS raw 32-bit arguments. The section is extracted at
+ * build time as scout_spine.logfmt; this decoder loads it and rebuilds
+ * the text. Layout mirrors spine/spine_log.h (layout version 1) and must
+ * change with it.
+ *
+ * Every frame carries the CRC32 of the Spine's table. A loaded table with
+ * a different CRC belongs to another firmware build: its offsets point at
+ * the wrong strings, so callers should refuse to format rather than print
+ * plausible nonsense.
+ */
+
+namespace s2t {
+namespace link {
+
+static constexpr uint8_t SPINE_LOG_LAYOUT_VERSION = 1;
+
+static constexpr std::size_t SPINE_LOG_FRAME_HEADER_BYTES  = 12;
+static constexpr std::size_t SPINE_LOG_RECORD_HEADER_BYTES = 8;
+static constexpr std::size_t SPINE_LOG_MAX_ARGS            = 4;
+static constexpr std::size_t SPINE_LOG_MAX_RECORDS_PER_FRAME =
+    (protocol::MAX_PAYLOAD_SIZE_BYTES - SPINE_LOG_FRAME_HEADER_BYTES) / SPINE_LOG_RECORD_HEADER_BYTES;
+
+static constexpr uint8_t SPINE_LOG_FLAG_GAP = 0x02;  // records lost before this frame
+
+static constexpr uint8_t SPINE_LOG_CORE_COUNT = 2;
+
+enum class SpineLogStatus : uint32_t {
+    OK = 0,
+    ERR_NULL,
+    ERR_TOO_SHORT,
+    ERR_LAYOUT_VERSION,
+    ERR_CORE,
+    ERR_RECORD           // a record runs past the payload or has too many args
+};
+
+struct SpineLogRecord {
+    uint32_t index;      // ring index (free-running per core)
+    uint32_t time_us;    // Spine time_us_32()
+    uint16_t fmt_id;
+    uint8_t  arg_count;
+    uint32_t args[SPINE_LOG_MAX_ARGS];
+};
+
+struct SpineLogFrame {
+    uint8_t core;
+    uint8_t flags;
+    uint8_t record_count;
+    uint32_t table_crc32;
+    uint32_t first_index;
+    SpineLogRecord records[SPINE_LOG_MAX_RECORDS_PER_FRAME];
+};
+
+/**
+ * Format table: the raw spine_log_fmt section (NUL-separated strings).
+ */
+struct SpineLogTable {
+    std::vector<char> bytes;
+    uint32_t crc32 = 0;
+};
+
+/**
+ * Read a .logfmt file. Returns false (errno set) if it cannot be read.
+ */
+bool spine_log_table_load(const char* path, SpineLogTable* out);
+
+SpineLogStatus spine_log_parse(const uint8_t* payload, std::size_t payload_len, SpineLogFrame* out);
+
+/**
+ * Rebuild the text of one record. Supports %d %i %u %x %X %o %c and %%,
+ * with flags, width and precision; length modifiers are ignored since
+ * every argument is 32 bits. A conversion with no argument left, %s, or
+ * an unknown conversion prints as "<?>". An fmt_id outside the table
+ * prints as "FMT_0x1234" followed by the raw arguments.
+ * Always NUL-terminates (cap > 0).
+ */
+void spine_log_format(const SpineLogTable& table, const SpineLogRecord& record,
+                      char* buf, std::size_t cap);
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_SPINE_LOG_H
@@ -0,0 +1,248 @@
+/**
+ * @file link_telemetry_daemon.cpp
+ * @brief Owns the Spine tty and publishes S2B telemetry to shared memory.
+ *
+ * Usage:
+ *   link_telemetry_daemon <tty> [--shm NAME] [--heartbeat]
+ *
+ * Frames the receive stream, validates each packet and publishes every S2B
+ * frame through link_telemetry_shm. Readers (link_telemetry_dump, dashboards,
+ * scripts) attach to the shared object instead of opening the tty.
+ *
+ * --heartbeat also runs the B2S_HEARTBEAT scheduler on the same port, so a
+ * single process keeps the link alive. Like link_heartbeat_tool, this grants
+ * no authority; it only asserts Brain liveness. All transmit traffic goes
+ * through one TxScheduler; heartbeats use its SAFETY class.
+ *
+ * Heartbeats carry their send time and the Spine acknowledges each with
+ * S2B_ACK, so with --heartbeat the daemon also estimates the Spine clock
+ * (link_clock_sync.h) and publishes the mapping for readers to convert
+ * Spine time_us stamps to CLOCK_MONOTONIC.
+ *
+ * Prints link counters once per second until interrupted (SIGINT/SIGTERM)
+ * or the tty goes away.
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+
+#include "bs_protocol.h"
+#include "link_ack.h"
+#include "link_clock_sync.h"
+#include "link_heartbeat_scheduler.h"
+#include "link_serial_port.h"
+#include "link_telemetry_shm.h"
+#include "link_timing_constants.h"
+#include "link_tx_scheduler.h"
+
+using namespace s2t::link;
+using namespace s2t::protocol;
+
+// Read wait; also bounds how stale writer_alive_ns can get while the
+// Spine is silent.
+static constexpr int READ_TIMEOUT_MS = 50;
+static constexpr std::size_t READ_CHUNK_BYTES = 512;
+
+static volatile std::sig_atomic_t g_stop_requested = 0;
+
+static void on_stop_signal(int)
+{
+    g_stop_requested = 1;
+}
+
+static void print_usage(const char* argv0)
+{
+    std::fprintf(stderr, "usage: %s <tty> [--shm NAME] [--heartbeat]\n", argv0);
+}
+
+static uint64_t monotonic_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * NS_PER_S + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+struct RxContext {
+    TelemetryShm* shm;
+    ClockSync* clock;
+    uint64_t rx_time_ns;
+    uint64_t published_count;
+    uint64_t invalid_count;
+    uint64_t ignored_count;   // valid but not S2B
+};
+
+static void on_frame(const uint8_t* frame_buf, std::size_t frame_len, void* ctx)
+{
+    RxContext* rx = static_cast<RxContext*>(ctx);
+
+    PacketHeader header;
+    if (validate_packet(frame_buf, frame_len) != PacketStatus::OK ||
+        parse_and_validate_header(frame_buf, frame_len, &header) != HeaderStatus::OK) {
+        rx->invalid_count++;
+        return;
+    }
+    if (header.src != NODE_ID_SPINE) {
+        rx->ignored_count++;
+        return;
+    }
+
+    if (telemetry_shm_publish(rx->shm, header, frame_buf + HEADER_SIZE_BYTES, rx->rx_time_ns)) {
+        rx->published_count++;
+    } else {
+        rx->invalid_count++;
+    }
+
+    // Heartbeat ACKs echo the send time (t1) and carry the Spine's t2/t3.
+    Ack ack;
+    if (header.msg_type == MSG_ID_S2B_ACK &&
+        ack_parse(frame_buf + HEADER_SIZE_BYTES, header.payload_len, &ack) == AckStatus::OK &&
+        ack.acked_msg_type == MSG_ID_B2S_HEARTBEAT && ack.echo != 0 &&
+        rx->clock->add_exchange(ack.echo, ack.spine_rx_time_us, ack.spine_tx_time_us, rx->rx_time_ns)) {
+        telemetry_shm_publish_clock(rx->shm, rx->clock->estimate());
+    }
+}
+
+static void print_metrics(const RxContext& rx,
+                          const ByteStreamFramer& framer,
+                          const SerialPort& port,
+                          const HeartbeatScheduler* scheduler,
+                          const TxScheduler& tx)
+{
+    std::printf("link.telemetry.bytes_read=%llu "
+                "link.telemetry.published_count=%llu "
+                "link.telemetry.invalid_count=%llu "
+                "link.telemetry.ignored_count=%llu "
+                "link.telemetry.sync_loss_count=%u",
+                static_cast<unsigned long long>(port.bytes_read),
+                static_cast<unsigned long long>(rx.published_count),
+                static_cast<unsigned long long>(rx.invalid_count),
+                static_cast<unsigned long long>(rx.ignored_count),
+                framer.sync_loss_count);
+
+    const ClockEstimate& clock = rx.clock->estimate();
+    const ClockSyncCounters& cc = rx.clock->counters();
+    std::printf(" link.clock.point_count=%u link.clock.drift_ppb=%lld"
+                " link.clock.error_bound_us=%llu link.clock.min_delay_us=%llu"
+                " link.clock.exchange_count=%llu link.clock.reset_count=%llu",
+                clock.point_count,
+                static_cast<long long>(clock.drift_ppb),
+                static_cast<unsigned long long>(clock.error_bound_ns / NS_PER_US),
+                static_cast<unsigned long long>(clock.min_delay_ns / NS_PER_US),
+                static_cast<unsigned long long>(cc.exchange_count),
+                static_cast<unsigned long long>(cc.reset_count));
+    if (scheduler) {
+        const HeartbeatMetrics m = scheduler->metrics();
+        const TxClassMetrics safety = tx.metrics(TxClass::SAFETY);
+        std::printf(" link.heartbeat.sent_count=%llu link.heartbeat.send_error_count=%llu"
+                    " link.tx.safety.delay_max_us=%u link.tx.safety.budget_miss_count=%llu",
+                    static_cast<unsigned long long>(m.sent_count),
+                    static_cast<unsigned long long>(m.send_error_count),
+                    safety.delay_max_us,
+                    static_cast<unsigned long long>(safety.budget_miss_count));
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    const char* tty_path = argv[1];
+    const char* shm_name = TELEMETRY_SHM_DEFAULT_NAME;
+    bool heartbeat = false;
+
+    for (int i = 2; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--heartbeat") == 0) {
+            heartbeat = true;
+        } else if (std::strcmp(argv[i], "--shm") == 0 && i + 1 < argc) {
+            shm_name = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    SerialPort port;
+    if (!serial_port_open(&port, tty_path)) {
+        std::perror(tty_path);
+        return 1;
+    }
+
+    TelemetryShmMapping mapping;
+    if (!telemetry_shm_create(&mapping, shm_name)) {
+        std::perror(shm_name);
+        serial_port_close(&port);
+        return 1;
+    }
+
+    std::signal(SIGINT, on_stop_signal);
+    std::signal(SIGTERM, on_stop_signal);
+
+    TxScheduler tx(TxSchedulerConfig(), serial_port_frame_sink, &port,
+                   serial_port_backlog_probe, &port,
+                   serial_port_frame_batch_sink, &port);
+    TxClassSink safety_sink = { &tx, TxClass::SAFETY };
+
+    std::unique_ptr<HeartbeatScheduler> scheduler;
+    if (heartbeat) {
+        scheduler.reset(new HeartbeatScheduler(HeartbeatSchedulerConfig(),
+                                               tx_class_frame_sink, &safety_sink));
+        if (tx.start() != SchedulerStatus::OK || scheduler->start() != SchedulerStatus::OK) {
+            std::fprintf(stderr, "failed to start heartbeat scheduler\n");
+            tx.stop();
+            telemetry_shm_close(&mapping);
+            telemetry_shm_unlink(shm_name);
+            serial_port_close(&port);
+            return 1;
+        }
+    }
+
+    ByteStreamFramer framer;
+    bs_framer_init(&framer);
+    ClockSync clock;
+    RxContext rx = { mapping.shm, &clock, 0, 0, 0, 0 };
+
+    uint8_t chunk[READ_CHUNK_BYTES];
+    uint64_t next_report_ns = monotonic_ns() + NS_PER_S;
+    int exit_code = 0;
+
+    while (!g_stop_requested) {
+        const std::ptrdiff_t n = serial_port_read(&port, chunk, sizeof(chunk), READ_TIMEOUT_MS);
+        if (n < 0) {
+            std::perror(tty_path);
+            exit_code = 1;
+            break;
+        }
+
+        const uint64_t now_ns = monotonic_ns();
+        if (n > 0) {
+            rx.rx_time_ns = now_ns;
+            bs_framer_push(&framer, chunk, static_cast<std::size_t>(n), on_frame, &rx);
+        }
+        telemetry_shm_note_alive(mapping.shm, now_ns, rx.invalid_count, framer.sync_loss_count);
+
+        if (now_ns >= next_report_ns) {
+            print_metrics(rx, framer, port, scheduler.get(), tx);
+            next_report_ns += NS_PER_S;
+        }
+    }
+
+    if (scheduler) {
+        scheduler->stop();
+    }
+    tx.stop();
+    print_metrics(rx, framer, port, scheduler.get(), tx);
+
+    // Leave the name in place on exit: readers see writer_alive_ns stop and
+    // can still inspect the last state. The next daemon replaces it.
+    telemetry_shm_close(&mapping);
+    serial_port_close(&port);
+    return exit_code;
+}
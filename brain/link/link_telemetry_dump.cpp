@@ -0,0 +1,168 @@
+/**
+ * @file link_telemetry_dump.cpp
+ * @brief Reader CLI for the shared-memory telemetry bus.
+ *
+ * Usage:
+ *   link_telemetry_dump [--shm NAME] [--history N] [--watch MS]
+ *
+ * Prints the Spine clock mapping, the latest STATE_REPORT, HEARTBEAT and
+ * FAULT frame and, with --history, the N most recent frames of any type. --watch repeats every
+ * MS milliseconds until interrupted. Never opens the tty.
+ *
+ * Output is one line per frame:
+ *   link.telemetry.<channel> index=... age_ms=... type=0x.. seq=... len=... payload=<hex>
+ */
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+
+#include "link_telemetry_shm.h"
+#include "link_timing_constants.h"
+
+using namespace s2t::link;
+
+static constexpr uint64_t NS_PER_MS = NS_PER_US * US_PER_MS;
+
+// A writer that has not refreshed writer_alive_ns for this long is reported
+// as stale. Several daemon read timeouts.
+static constexpr uint64_t WRITER_STALE_NS = 500 * NS_PER_MS;
+
+static volatile std::sig_atomic_t g_stop_requested = 0;
+
+static void on_stop_signal(int)
+{
+    g_stop_requested = 1;
+}
+
+static void print_usage(const char* argv0)
+{
+    std::fprintf(stderr, "usage: %s [--shm NAME] [--history N] [--watch MS]\n", argv0);
+}
+
+static uint64_t monotonic_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * NS_PER_S + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+static void print_frame(const char* label, const TelemetryFrame& f, uint64_t now_ns)
+{
+    const uint64_t age_ms = (now_ns > f.rx_time_ns) ? (now_ns - f.rx_time_ns) / NS_PER_MS : 0;
+    std::printf("link.telemetry.%s index=%llu age_ms=%llu type=0x%02x seq=%u flags=0x%02x len=%u payload=",
+                label,
+                static_cast<unsigned long long>(f.frame_index),
+                static_cast<unsigned long long>(age_ms),
+                f.msg_type, f.seq, f.flags, f.payload_len);
+    for (uint16_t i = 0; i < f.payload_len; ++i) {
+        std::printf("%02x", f.payload[i]);
+    }
+    std::printf("\n");
+}
+
+static void dump_once(const TelemetryShm* shm, uint32_t history_count)
+{
+    static const char* const CHANNEL_LABELS[TELEMETRY_CHANNEL_COUNT] = {
+        "state_report", "heartbeat", "fault"
+    };
+
+    const uint64_t now_ns = monotonic_ns();
+    const uint64_t alive_ns = shm->writer_alive_ns.load(std::memory_order_acquire);
+
+    std::printf("link.telemetry.writer_pid=%u "
+                "link.telemetry.writer_stale=%d "
+                "link.telemetry.published_count=%llu "
+                "link.telemetry.invalid_count=%llu "
+                "link.telemetry.sync_loss_count=%llu\n",
+                shm->writer_pid.load(std::memory_order_relaxed),
+                (now_ns > alive_ns + WRITER_STALE_NS) ? 1 : 0,
+                static_cast<unsigned long long>(shm->published_count.load(std::memory_order_relaxed)),
+                static_cast<unsigned long long>(shm->invalid_count.load(std::memory_order_relaxed)),
+                static_cast<unsigned long long>(shm->sync_loss_count.load(std::memory_order_relaxed)));
+
+    ClockEstimate clock;
+    const TelemetryReadStatus clock_status = telemetry_shm_read_clock(shm, &clock);
+    if (clock_status == TelemetryReadStatus::OK) {
+        std::printf("link.telemetry.clock ref_spine_us=%llu ref_brain_ns=%llu drift_ppb=%lld "
+                    "error_bound_us=%llu min_delay_us=%llu point_count=%u\n",
+                    static_cast<unsigned long long>(clock.ref_spine_us),
+                    static_cast<unsigned long long>(clock.ref_brain_ns),
+                    static_cast<long long>(clock.drift_ppb),
+                    static_cast<unsigned long long>(clock.error_bound_ns / NS_PER_US),
+                    static_cast<unsigned long long>(clock.min_delay_ns / NS_PER_US),
+                    clock.point_count);
+    } else {
+        std::printf("link.telemetry.clock %s\n",
+                    (clock_status == TelemetryReadStatus::EMPTY) ? "empty" : "busy");
+    }
+
+    TelemetryFrame frame;
+    for (std::size_t c = 0; c < TELEMETRY_CHANNEL_COUNT; ++c) {
+        const TelemetryReadStatus st =
+            telemetry_shm_read_latest(shm, static_cast<TelemetryChannel>(c), &frame);
+        if (st == TelemetryReadStatus::OK) {
+            print_frame(CHANNEL_LABELS[c], frame, now_ns);
+        } else {
+            std::printf("link.telemetry.%s %s\n", CHANNEL_LABELS[c],
+                        (st == TelemetryReadStatus::EMPTY) ? "empty" : "busy");
+        }
+    }
+
+    static TelemetryFrame history[TELEMETRY_HISTORY_DEPTH];
+    const uint32_t n = telemetry_shm_read_history(shm, history, history_count);
+    for (uint32_t i = 0; i < n; ++i) {
+        print_frame("history", history[i], now_ns);
+    }
+    std::fflush(stdout);
+}
+
+int main(int argc, char** argv)
+{
+    const char* shm_name = TELEMETRY_SHM_DEFAULT_NAME;
+    uint32_t history_count = 0;
+    long watch_ms = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return 2;
+        }
+        if (std::strcmp(argv[i], "--shm") == 0) {
+            shm_name = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--history") == 0) {
+            const long value = std::strtol(argv[i + 1], nullptr, 10);
+            history_count = (value <= 0) ? 0
+                          : (value > static_cast<long>(TELEMETRY_HISTORY_DEPTH))
+                                ? TELEMETRY_HISTORY_DEPTH
+                                : static_cast<uint32_t>(value);
+        } else if (std::strcmp(argv[i], "--watch") == 0) {
+            watch_ms = std::strtol(argv[i + 1], nullptr, 10);
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+
+    TelemetryShmMapping mapping;
+    if (!telemetry_shm_open(&mapping, shm_name)) {
+        std::perror(shm_name);
+        return 1;
+    }
+
+    std::signal(SIGINT, on_stop_signal);
+    std::signal(SIGTERM, on_stop_signal);
+
+    dump_once(mapping.shm, history_count);
+    while (watch_ms > 0 && !g_stop_requested) {
+        usleep(static_cast<useconds_t>(watch_ms) * US_PER_MS);
+        dump_once(mapping.shm, history_count);
+    }
+
+    telemetry_shm_close(&mapping);
+    return 0;
+}
@@ -0,0 +1,310 @@
+/**
+ * @file link_telemetry_shm.cpp
+ * @brief Seqlock publisher and reader for the shared-memory telemetry bus.
+ *
+ * Ordering (single writer):
+ *   writer  seq = s+1 (relaxed); release fence; copy frame; seq = s+2 (release)
+ *   reader  s1 = seq (acquire); copy frame; acquire fence; s2 = seq (relaxed)
+ * A copy is kept only if s1 == s2 and s1 is even. The copy itself may race
+ * with the writer; the counter check discards any torn result.
+ */
+
+#include "link_telemetry_shm.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace s2t {
+namespace link {
+
+using protocol::MAX_PAYLOAD_SIZE_BYTES;
+using protocol::PacketHeader;
+
+static constexpr mode_t SHM_MODE = 0644;
+
+bool telemetry_shm_create(TelemetryShmMapping* mapping, const char* name)
+{
+    if (!mapping || !name) {
+        errno = EINVAL;
+        return false;
+    }
+
+    // Readers of a previous daemon keep their mapping; new readers get ours.
+    ::shm_unlink(name);
+    const int fd = ::shm_open(name, O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, SHM_MODE);
+    if (fd < 0) {
+        return false;
+    }
+
+    const std::size_t size = sizeof(TelemetryShm);
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        const int saved = errno;
+        ::close(fd);
+        ::shm_unlink(name);
+        errno = saved;
+        return false;
+    }
+
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    const int saved = errno;
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        ::shm_unlink(name);
+        errno = saved;
+        return false;
+    }
+
+    // ftruncate zero-fills: every slot counter starts at 0 (EMPTY).
+    TelemetryShm* shm = static_cast<TelemetryShm*>(addr);
+    shm->layout_version = TELEMETRY_SHM_LAYOUT_VERSION;
+    shm->history_depth = TELEMETRY_HISTORY_DEPTH;
+    shm->slot_size = sizeof(TelemetrySlot);
+    shm->writer_pid.store(static_cast<uint32_t>(::getpid()), std::memory_order_relaxed);
+    shm->magic.store(TELEMETRY_SHM_MAGIC, std::memory_order_release);
+
+    mapping->shm = shm;
+    mapping->size = size;
+    return true;
+}
+
+bool telemetry_shm_open(TelemetryShmMapping* mapping, const char* name)
+{
+    if (!mapping || !name) {
+        errno = EINVAL;
+        return false;
+    }
+
+    const int fd = ::shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        const int saved = errno;
+        ::close(fd);
+        errno = saved;
+        return false;
+    }
+    if (static_cast<std::size_t>(st.st_size) != sizeof(TelemetryShm)) {
+        ::close(fd);
+        errno = EPROTO;
+        return false;
+    }
+
+    void* addr = ::mmap(nullptr, sizeof(TelemetryShm), PROT_READ, MAP_SHARED, fd, 0);
+    const int saved = errno;
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        errno = saved;
+        return false;
+    }
+
+    const TelemetryShm* shm = static_cast<const TelemetryShm*>(addr);
+    if (shm->magic.load(std::memory_order_acquire) != TELEMETRY_SHM_MAGIC ||
+        shm->layout_version != TELEMETRY_SHM_LAYOUT_VERSION ||
+        shm->history_depth != TELEMETRY_HISTORY_DEPTH ||
+        shm->slot_size != sizeof(TelemetrySlot)) {
+        ::munmap(addr, sizeof(TelemetryShm));
+        errno = EPROTO;
+        return false;
+    }
+
+    // The mapping is PROT_READ; the non-const pointer is only for close().
+    mapping->shm = static_cast<TelemetryShm*>(addr);
+    mapping->size = sizeof(TelemetryShm);
+    return true;
+}
+
+void telemetry_shm_close(TelemetryShmMapping* mapping)
+{
+    if (!mapping || !mapping->shm) {
+        return;
+    }
+    ::munmap(mapping->shm, mapping->size);
+    mapping->shm = nullptr;
+    mapping->size = 0;
+}
+
+void telemetry_shm_unlink(const char* name)
+{
+    if (name) {
+        ::shm_unlink(name);
+    }
+}
+
+TelemetryChannel telemetry_channel_for(uint8_t msg_type)
+{
+    switch (msg_type) {
+    case protocol::MSG_ID_S2B_STATE_REPORT: return TelemetryChannel::STATE_REPORT;
+    case protocol::MSG_ID_S2B_HEARTBEAT:    return TelemetryChannel::HEARTBEAT;
+    case protocol::MSG_ID_S2B_FAULT:        return TelemetryChannel::FAULT;
+    default:                                return TelemetryChannel::COUNT;
+    }
+}
+
+static void slot_write(TelemetrySlot* slot, const TelemetryFrame& frame)
+{
+    const uint32_t s = slot->seq.load(std::memory_order_relaxed);
+    slot->seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Only the meaningful payload bytes; readers never look past payload_len.
+    std::memcpy(&slot->frame, &frame, TELEMETRY_FRAME_FIXED_BYTES + frame.payload_len);
+
+    slot->seq.store(s + 2, std::memory_order_release);
+}
+
+static TelemetryReadStatus slot_read(const TelemetrySlot* slot, TelemetryFrame* out)
+{
+    for (uint32_t attempt = 0; attempt < TELEMETRY_READ_MAX_ATTEMPTS; ++attempt) {
+        const uint32_t s1 = slot->seq.load(std::memory_order_acquire);
+        if (s1 == 0) {
+            return TelemetryReadStatus::EMPTY;
+        }
+        if (s1 & 1u) {
+            continue;
+        }
+
+        std::memcpy(out, &slot->frame, TELEMETRY_FRAME_FIXED_BYTES);
+        // A torn length is discarded below, but must not overrun `out` first.
+        const std::size_t len = (out->payload_len <= MAX_PAYLOAD_SIZE_BYTES)
+                                    ? out->payload_len
+                                    : MAX_PAYLOAD_SIZE_BYTES;
+        std::memcpy(out->payload, slot->frame.payload, len);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) == s1) {
+            return TelemetryReadStatus::OK;
+        }
+    }
+    return TelemetryReadStatus::BUSY;
+}
+
+bool telemetry_shm_publish(TelemetryShm* shm,
+                           const PacketHeader& header,
+                           const uint8_t* payload,
+                           uint64_t rx_time_ns)
+{
+    if (!shm || header.payload_len > MAX_PAYLOAD_SIZE_BYTES ||
+        (!payload && header.payload_len > 0)) {
+        return false;
+    }
+
+    const uint64_t index = shm->published_count.load(std::memory_order_relaxed) + 1;
+
+    TelemetryFrame frame;
+    frame.rx_time_ns = rx_time_ns;
+    frame.frame_index = index;
+    frame.seq = header.seq;
+    frame.payload_len = header.payload_len;
+    frame.msg_type = header.msg_type;
+    frame.flags = header.flags;
+    frame.src = header.src;
+    frame.dst = header.dst;
+    if (header.payload_len > 0) {
+        std::memcpy(frame.payload, payload, header.payload_len);
+    }
+
+    const TelemetryChannel channel = telemetry_channel_for(header.msg_type);
+    if (channel != TelemetryChannel::COUNT) {
+        slot_write(&shm->latest[static_cast<std::size_t>(channel)], frame);
+    }
+
+    slot_write(&shm->history[(index - 1) & (TELEMETRY_HISTORY_DEPTH - 1)], frame);
+    shm->published_count.store(index, std::memory_order_release);
+    return true;
+}
+
+void telemetry_shm_note_alive(TelemetryShm* shm,
+                              uint64_t now_ns,
+                              uint64_t invalid_count,
+                              uint64_t sync_loss_count)
+{
+    if (!shm) {
+        return;
+    }
+    shm->invalid_count.store(invalid_count, std::memory_order_relaxed);
+    shm->sync_loss_count.store(sync_loss_count, std::memory_order_relaxed);
+    shm->writer_alive_ns.store(now_ns, std::memory_order_release);
+}
+
+void telemetry_shm_publish_clock(TelemetryShm* shm, const ClockEstimate& estimate)
+{
+    if (!shm) {
+        return;
+    }
+    TelemetryClockSlot* slot = &shm->clock;
+    const uint32_t s = slot->seq.load(std::memory_order_relaxed);
+    slot->seq.store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    std::memcpy(&slot->estimate, &estimate, sizeof(estimate));
+
+    slot->seq.store(s + 2, std::memory_order_release);
+}
+
+TelemetryReadStatus telemetry_shm_read_clock(const TelemetryShm* shm, ClockEstimate* out)
+{
+    if (!shm || !out) {
+        return TelemetryReadStatus::ERR_INVALID_ARGS;
+    }
+    const TelemetryClockSlot* slot = &shm->clock;
+    for (uint32_t attempt = 0; attempt < TELEMETRY_READ_MAX_ATTEMPTS; ++attempt) {
+        const uint32_t s1 = slot->seq.load(std::memory_order_acquire);
+        if (s1 == 0) {
+            return TelemetryReadStatus::EMPTY;
+        }
+        if (s1 & 1u) {
+            continue;
+        }
+
+        std::memcpy(out, &slot->estimate, sizeof(*out));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->seq.load(std::memory_order_relaxed) == s1) {
+            return (out->point_count > 0) ? TelemetryReadStatus::OK : TelemetryReadStatus::EMPTY;
+        }
+    }
+    return TelemetryReadStatus::BUSY;
+}
+
+TelemetryReadStatus telemetry_shm_read_latest(const TelemetryShm* shm,
+                                              TelemetryChannel channel,
+                                              TelemetryFrame* out)
+{
+    if (!shm || !out || channel >= TelemetryChannel::COUNT) {
+        return TelemetryReadStatus::ERR_INVALID_ARGS;
+    }
+    return slot_read(&shm->latest[static_cast<std::size_t>(channel)], out);
+}
+
+uint32_t telemetry_shm_read_history(const TelemetryShm* shm,
+                                    TelemetryFrame* out,
+                                    uint32_t max)
+{
+    if (!shm || !out) {
+        return 0;
+    }
+
+    const uint64_t newest = shm->published_count.load(std::memory_order_acquire);
+    uint32_t count = 0;
+
+    while (count < max && count < TELEMETRY_HISTORY_DEPTH && count < newest) {
+        const uint64_t index = newest - count;
+        const TelemetrySlot* slot = &shm->history[(index - 1) & (TELEMETRY_HISTORY_DEPTH - 1)];
+        if (slot_read(slot, &out[count]) != TelemetryReadStatus::OK ||
+            out[count].frame_index != index) {
+            break;  // busy, or already overwritten by a newer lap
+        }
+        ++count;
+    }
+    return count;
+}
+
+} // namespace link
+} // namespace s2t
@@ -0,0 +1,207 @@
+#ifndef LINK_TELEMETRY_SHM_H
+#define LINK_TELEMETRY_SHM_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+#include "bs_protocol.h"
+#include "link_clock_sync.h"
+
+/**
+ * @file link_telemetry_shm.h
+ * @brief Shared-memory telemetry bus: one link owner, any number of readers.
+ *
+ * The process that owns the serial port (link_telemetry_daemon) publishes
+ * every valid S2B frame into a POSIX shared-memory object. Readers map it
+ * read-only and never touch the tty or make a syscall to read.
+ *
+ * Layout (fixed, versioned by TELEMETRY_SHM_LAYOUT_VERSION):
+ *   - latest[]  newest STATE_REPORT, HEARTBEAT and FAULT frame
+ *   - history[] ring of the last TELEMETRY_HISTORY_DEPTH S2B frames of any
+ *               type, indexed by publish ordinal
+ *   - clock     Spine tick -> Brain CLOCK_MONOTONIC mapping (link_clock_sync.h)
+ *
+ * Every slot is a seqlock. The writer makes the slot counter odd, copies
+ * the frame, then makes it even again. A reader copies the frame between
+ * two loads of the counter and retries if it was odd or moved. Readers
+ * never block the writer; a reader that keeps losing the race gives up
+ * after TELEMETRY_READ_MAX_ATTEMPTS and reports BUSY.
+ *
+ * Payload bytes are copied verbatim. Decoding them is the reader's job;
+ * the contract does not fix payload layouts.
+ *
+ * Single writer only. A restarted daemon unlinks and recreates the object,
+ * so readers holding the old mapping see writer_alive_ns stop advancing
+ * and should reopen.
+ */
+
+namespace s2t {
+namespace link {
+
+    static constexpr uint32_t TELEMETRY_SHM_MAGIC          = 0x4D543253;  // "S2TM"
+    static constexpr uint32_t TELEMETRY_SHM_LAYOUT_VERSION = 2;
+    static constexpr const char* TELEMETRY_SHM_DEFAULT_NAME = "/s2t_telemetry";
+
+    // Ring of recent frames. Power of two; at the 100 ms S2B heartbeat
+    // rate this holds several seconds of traffic.
+    static constexpr uint32_t TELEMETRY_HISTORY_DEPTH = 64;
+
+    // Bound on seqlock retries per slot read.
+    static constexpr uint32_t TELEMETRY_READ_MAX_ATTEMPTS = 64;
+
+    static_assert((TELEMETRY_HISTORY_DEPTH & (TELEMETRY_HISTORY_DEPTH - 1)) == 0,
+                  "history depth must be a power of two");
+
+enum class TelemetryChannel : uint32_t {
+    STATE_REPORT = 0,
+    HEARTBEAT,
+    FAULT,
+    COUNT
+};
+
+static constexpr std::size_t TELEMETRY_CHANNEL_COUNT =
+    static_cast<std::size_t>(TelemetryChannel::COUNT);
+
+/**
+ * One received frame as readers see it. Header fields are decoded; the
+ * payload is the raw wire bytes (payload_len of them are meaningful).
+ */
+struct TelemetryFrame {
+    uint64_t rx_time_ns;    // CLOCK_MONOTONIC when the bytes were read
+    uint64_t frame_index;   // publish ordinal, 1-based, across all types
+    uint16_t seq;
+    uint16_t payload_len;
+    uint8_t  msg_type;
+    uint8_t  flags;
+    uint8_t  src;
+    uint8_t  dst;
+    uint8_t  payload[protocol::MAX_PAYLOAD_SIZE_BYTES];
+};
+
+static constexpr std::size_t TELEMETRY_FRAME_FIXED_BYTES =
+    offsetof(TelemetryFrame, payload);
+
+struct alignas(64) TelemetrySlot {
+    std::atomic<uint32_t> seq;   // seqlock counter: odd while being written
+    uint32_t reserved;
+    TelemetryFrame frame;
+};
+
+struct alignas(64) TelemetryClockSlot {
+    std::atomic<uint32_t> seq;   // seqlock counter, as TelemetrySlot
+    uint32_t reserved;
+    ClockEstimate estimate;
+};
+
+struct TelemetryShm {
+    // Identity. magic is stored last (release) once the rest is valid.
+    std::atomic<uint32_t> magic;
+    uint32_t layout_version;
+    uint32_t history_depth;
+    uint32_t slot_size;
+
+    std::atomic<uint32_t> writer_pid;
+    uint32_t reserved;
+    std::atomic<uint64_t> writer_alive_ns;   // CLOCK_MONOTONIC, refreshed by the writer
+    std::atomic<uint64_t> published_count;   // frame_index of the newest history entry
+    std::atomic<uint64_t> invalid_count;     // framed but failed validation
+    std::atomic<uint64_t> sync_loss_count;   // bytes discarded while resyncing
+
+    TelemetrySlot latest[TELEMETRY_CHANNEL_COUNT];
+    TelemetrySlot history[TELEMETRY_HISTORY_DEPTH];
+    TelemetryClockSlot clock;
+};
+
+// Readers in other processes rely on these being plain loads and stores.
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "u32 atomics must be lock-free");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "u64 atomics must be lock-free");
+
+enum class TelemetryReadStatus {
+    OK = 0,
+    EMPTY,              // nothing published on this channel yet
+    BUSY,               // writer kept the slot busy for every attempt
+    ERR_INVALID_ARGS
+};
+
+/**
+ * A mapping of the shared object. Owns the mapping from a successful
+ * create/open until telemetry_shm_close().
+ */
+struct TelemetryShmMapping {
+    TelemetryShm* shm = nullptr;
+    std::size_t size = 0;
+};
+
+/**
+ * Writer: replace any existing object called `name` with a fresh one and
+ * map it read-write. Returns false on failure; errno is preserved.
+ */
+bool telemetry_shm_create(TelemetryShmMapping* mapping, const char* name);
+
+/**
+ * Reader: map an existing object read-only and check its magic, layout
+ * version and size. Returns false (errno EPROTO on a layout mismatch).
+ */
+bool telemetry_shm_open(TelemetryShmMapping* mapping, const char* name);
+
+void telemetry_shm_close(TelemetryShmMapping* mapping);
+
+/**
+ * Writer: remove the name. Existing mappings stay valid until closed.
+ */
+void telemetry_shm_unlink(const char* name);
+
+/**
+ * Channel a message type feeds, or COUNT if it only goes to history.
+ */
+TelemetryChannel telemetry_channel_for(uint8_t msg_type);
+
+/**
+ * Writer: publish one validated frame. `payload` holds
+ * header.payload_len bytes. Returns false if the arguments are invalid.
+ */
+bool telemetry_shm_publish(TelemetryShm* shm,
+                           const protocol::PacketHeader& header,
+                           const uint8_t* payload,
+                           uint64_t rx_time_ns);
+
+/**
+ * Writer: refresh liveness and link-quality counters.
+ */
+void telemetry_shm_note_alive(TelemetryShm* shm,
+                              uint64_t now_ns,
+                              uint64_t invalid_count,
+                              uint64_t sync_loss_count);
+
+/**
+ * Writer: replace the published clock mapping.
+ */
+void telemetry_shm_publish_clock(TelemetryShm* shm, const ClockEstimate& estimate);
+
+/**
+ * Reader: consistent copy of the newest frame on `channel`.
+ */
+TelemetryReadStatus telemetry_shm_read_latest(const TelemetryShm* shm,
+                                              TelemetryChannel channel,
+                                              TelemetryFrame* out);
+
+/**
+ * Reader: consistent copy of the clock mapping. EMPTY until the writer
+ * has one; feed the result to clock_spine_to_brain_ns().
+ */
+TelemetryReadStatus telemetry_shm_read_clock(const TelemetryShm* shm, ClockEstimate* out);
+
+/**
+ * Reader: up to `max` most recent history frames, newest first. Stops
+ * early at a slot the writer is busy with or has already lapped.
+ * Returns the number of frames copied.
+ */
+uint32_t telemetry_shm_read_history(const TelemetryShm* shm,
+                                    TelemetryFrame* out,
+                                    uint32_t max);
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_TELEMETRY_SHM_H
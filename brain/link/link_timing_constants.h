@@ -0,0 +1,37 @@
+#ifndef LINK_TIMING_CONSTANTS_H
+#define LINK_TIMING_CONSTANTS_H
+
+#include <cstdint>
+
+/**
+ * @file link_timing_constants.h
+ * @brief Brain-side link timing constants for Brain <-> Spine Contract v0.2.
+ *
+ * Mirrors the timing requirements of BRAIN_SPINE_MESSAGE_CONTRACT.md
+ * Section 9. These live apart from bs_contract_constants.h on purpose:
+ * that file carries wire-format constants only.
+ *
+ * The Spine enforces the hold timeout. The Brain only uses these values
+ * to pace its own traffic and to judge its own timing margins.
+ */
+
+namespace s2t {
+namespace link {
+
+    // Contract v0.2 Section 9 (Frozen for v0.1).
+    static constexpr uint32_t B2S_HEARTBEAT_PERIOD_MS = 200;
+    static constexpr uint32_t S2B_HEARTBEAT_PERIOD_MS = 100;
+    static constexpr uint32_t DEFAULT_HOLD_TIMEOUT_MS = 500;
+    static constexpr uint32_t STATE_REPORT_PERIOD_MS  = 750;
+
+    static constexpr uint32_t US_PER_MS = 1000;
+    static constexpr uint64_t NS_PER_US = 1000;
+    static constexpr uint64_t NS_PER_S  = 1000000000ULL;
+
+    static_assert(B2S_HEARTBEAT_PERIOD_MS < DEFAULT_HOLD_TIMEOUT_MS,
+                  "heartbeat period must leave margin below the hold timeout");
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_TIMING_CONSTANTS_H
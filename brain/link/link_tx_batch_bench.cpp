@@ -0,0 +1,175 @@
+/**
+ * @file link_tx_batch_bench.cpp
+ * @brief TX batching: throughput and added latency across batch budgets.
+ *
+ * Usage:
+ *   link_tx_batch_bench [--frames N] [--paced-hz N] [--payload N]
+ *
+ * The TxScheduler writes through serial_port_frame_batch_sink into a
+ * pseudo-terminal, so every flush is a real writev() on a tty; a thread
+ * drains the master side. For each batch budget:
+ *   flood  enqueue --frames CONTROL frames as fast as the queue takes them;
+ *          report frames/s, writes and frames per write
+ *   paced  enqueue at --paced-hz for PACED_SECONDS; report the queueing
+ *          delay (mean/max), i.e. the latency batching adds
+ *
+ * No Spine needed. USB CDC adds a per-transfer cost a pty does not have,
+ * so real links gain more from fewer writes than this shows.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+
+#include "link_serial_port.h"
+#include "link_tx_scheduler.h"
+
+using namespace s2t::link;
+using namespace s2t::protocol;
+
+static constexpr uint32_t BUDGETS_US[] = { 0, 50, 100, 200, 500, 1000 };
+static constexpr double PACED_SECONDS = 0.5;
+
+struct Pty {
+    int master = -1;
+    SerialPort slave;
+};
+
+static bool pty_open(Pty* pty)
+{
+    pty->master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (pty->master < 0 || grantpt(pty->master) != 0 || unlockpt(pty->master) != 0) {
+        return false;
+    }
+    const char* name = ptsname(pty->master);
+    return name && serial_port_open(&pty->slave, name);
+}
+
+static void drain(int fd, const std::atomic<bool>* running)
+{
+    uint8_t buf[4096];
+    while (running->load(std::memory_order_relaxed)) {
+        if (::read(fd, buf, sizeof(buf)) <= 0) {
+            return;
+        }
+    }
+}
+
+static void wait_sent(const TxScheduler& tx, uint64_t target)
+{
+    while (tx.metrics(TxClass::CONTROL).sent_count < target) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+}
+
+int main(int argc, char** argv)
+{
+    long flood_frames = 20000;
+    long paced_hz = 5000;
+    long payload_len = 16;
+
+    for (int i = 1; i < argc; ++i) {
+        const long value = (i + 1 < argc) ? std::strtol(argv[i + 1], nullptr, 10) : 0;
+        if (value <= 0 || value > 1000000) {
+            std::fprintf(stderr, "usage: %s [--frames N] [--paced-hz N] [--payload N]\n", argv[0]);
+            return 2;
+        }
+        if (std::strcmp(argv[i], "--frames") == 0) {
+            flood_frames = value;
+        } else if (std::strcmp(argv[i], "--paced-hz") == 0) {
+            paced_hz = value;
+        } else if (std::strcmp(argv[i], "--payload") == 0 &&
+                   value <= static_cast<long>(MAX_PAYLOAD_SIZE_BYTES)) {
+            payload_len = value;
+        } else {
+            std::fprintf(stderr, "usage: %s [--frames N] [--paced-hz N] [--payload N]\n", argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+
+    Pty pty;
+    if (!pty_open(&pty)) {
+        std::perror("pty");
+        return 1;
+    }
+    std::atomic<bool> draining{true};
+    std::thread drainer(drain, pty.master, &draining);
+
+    PacketHeader fields = {};
+    fields.msg_type = MSG_ID_B2S_MOTION_SETPOINT;
+    fields.src = NODE_ID_BRAIN;
+    fields.dst = NODE_ID_SPINE;
+    uint8_t payload[MAX_PAYLOAD_SIZE_BYTES] = {};
+    uint8_t frame[MAX_FRAME_BUFFER_SIZE];
+    std::size_t frame_len = 0;
+    encode_packet(&fields, payload, static_cast<std::size_t>(payload_len),
+                  frame, sizeof(frame), &frame_len);
+
+    for (uint32_t budget_us : BUDGETS_US) {
+        TxSchedulerConfig config;
+        config.batch_budget_us = budget_us;
+        config.delay_budget_us[static_cast<std::size_t>(TxClass::CONTROL)] = 0;
+
+        // Flood: throughput and writes per frame.
+        TxScheduler tx(config, nullptr, nullptr, nullptr, nullptr,
+                       serial_port_frame_batch_sink, &pty.slave);
+        if (tx.start() != SchedulerStatus::OK) {
+            std::fprintf(stderr, "failed to start tx scheduler\n");
+            return 1;
+        }
+        const auto t0 = std::chrono::steady_clock::now();
+        for (long n = 0; n < flood_frames;) {
+            if (tx.enqueue(TxClass::CONTROL, frame, frame_len)) {
+                ++n;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        wait_sent(tx, static_cast<uint64_t>(flood_frames));
+        const double flood_s =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        const uint64_t flood_writes = tx.flush_count();
+        tx.stop();
+
+        // Paced: latency added by waiting for company.
+        TxScheduler paced(config, nullptr, nullptr, nullptr, nullptr,
+                          serial_port_frame_batch_sink, &pty.slave);
+        paced.start();
+        const auto period = std::chrono::nanoseconds(1000000000LL / paced_hz);
+        const long paced_frames = static_cast<long>(paced_hz * PACED_SECONDS);
+        auto next = std::chrono::steady_clock::now();
+        for (long n = 0; n < paced_frames; ++n) {
+            paced.enqueue(TxClass::CONTROL, frame, frame_len);
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+        wait_sent(paced, paced.metrics(TxClass::CONTROL).enqueued_count);
+        const TxClassMetrics pm = paced.metrics(TxClass::CONTROL);
+        const uint64_t paced_writes = paced.flush_count();
+        paced.stop();
+
+        std::printf("link.tx_batch.budget_us=%u "
+                    "flood.frames_per_s=%.0f flood.writes=%llu flood.frames_per_write=%.2f "
+                    "paced.frames_per_write=%.2f paced.delay_mean_us=%llu paced.delay_max_us=%u\n",
+                    budget_us,
+                    static_cast<double>(flood_frames) / flood_s,
+                    static_cast<unsigned long long>(flood_writes),
+                    static_cast<double>(flood_frames) / static_cast<double>(flood_writes),
+                    (paced_writes > 0) ? static_cast<double>(pm.sent_count) / paced_writes : 0.0,
+                    static_cast<unsigned long long>(pm.sent_count ? pm.delay_total_us / pm.sent_count : 0),
+                    pm.delay_max_us);
+        std::fflush(stdout);
+    }
+
+    draining.store(false);
+    serial_port_close(&pty.slave);
+    ::close(pty.master);
+    drainer.join();
+    return 0;
+}
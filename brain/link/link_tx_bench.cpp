@@ -0,0 +1,249 @@
+/**
+ * @file link_tx_bench.cpp
+ * @brief TX scheduler under a saturating bulk load. No hardware.
+ *
+ * Usage:
+ *   link_tx_bench [--link-baud N] [--seconds N] [--fifo] [--batch-budget-us N]
+ *
+ * Three senders share one simulated UART (the sink blocks for the frame's
+ * time on the wire at --link-baud, 10 bits per byte):
+ *   - HeartbeatScheduler at the contract period         -> SAFETY
+ *   - a 50 Hz control sender with 16-byte payloads      -> CONTROL
+ *   - a bulk sender that keeps its queue full of
+ *     maximum-size frames                               -> BULK
+ *
+ * --fifo sends everything through the BULK class, i.e. one shared FIFO,
+ * for comparison. Prints per-class queueing delay and budget misses.
+ *
+ * --batch-budget-us turns on batching and the backlog probe together. The
+ * UART then gets a driver buffer like a tty: the batch sink returns at
+ * once, the bytes drain at --link-baud, and the probe reports what is
+ * still queued. The bench also prints the most bytes any keepalive found
+ * ahead of it on the wire, and exits 1 if that exceeds max_backlog_bytes
+ * plus the one frame the writer may take while under it.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "link_heartbeat_scheduler.h"
+#include "link_tx_scheduler.h"
+
+using namespace s2t::link;
+using namespace s2t::protocol;
+
+static constexpr uint32_t UART_BITS_PER_BYTE = 10;
+static constexpr uint32_t CONTROL_PERIOD_MS  = 20;
+static constexpr std::size_t CONTROL_PAYLOAD_BYTES = 16;
+
+static bool sim_link_sink(const uint8_t*, std::size_t frame_len, void* ctx)
+{
+    const uint32_t baud = *static_cast<const uint32_t*>(ctx);
+    const uint64_t wire_us =
+        static_cast<uint64_t>(frame_len) * UART_BITS_PER_BYTE * 1000000ULL / baud;
+    std::this_thread::sleep_for(std::chrono::microseconds(wire_us));
+    return true;
+}
+
+/**
+ * UART behind a driver buffer. The sink never blocks; `drained_ns` is when
+ * the last queued byte will have left the wire.
+ */
+struct SimDriver {
+    uint32_t baud;
+    std::mutex lock;
+    uint64_t drained_ns = 0;
+    uint64_t keepalive_count = 0;
+    uint64_t keepalive_ahead_max_bytes = 0;
+    uint64_t keepalive_wait_max_us = 0;
+};
+
+static uint64_t steady_now_ns()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static uint64_t wire_ns(std::size_t bytes, uint32_t baud)
+{
+    return static_cast<uint64_t>(bytes) * UART_BITS_PER_BYTE * NS_PER_S / baud;
+}
+
+static uint64_t wire_bytes(uint64_t ns, uint32_t baud)
+{
+    return ns * baud / (UART_BITS_PER_BYTE * NS_PER_S);
+}
+
+static std::size_t sim_driver_backlog(void* ctx)
+{
+    SimDriver* drv = static_cast<SimDriver*>(ctx);
+    std::lock_guard<std::mutex> guard(drv->lock);
+    const uint64_t now_ns = steady_now_ns();
+    return (drv->drained_ns > now_ns)
+               ? static_cast<std::size_t>(wire_bytes(drv->drained_ns - now_ns, drv->baud))
+               : 0;
+}
+
+static bool sim_driver_batch_sink(const struct iovec* frames, std::size_t frame_count, void* ctx)
+{
+    SimDriver* drv = static_cast<SimDriver*>(ctx);
+    std::lock_guard<std::mutex> guard(drv->lock);
+    const uint64_t now_ns = steady_now_ns();
+    uint64_t start_ns = (drv->drained_ns > now_ns) ? drv->drained_ns : now_ns;
+    for (std::size_t i = 0; i < frame_count; ++i) {
+        const uint8_t* frame = static_cast<const uint8_t*>(frames[i].iov_base);
+        if (frame[OFFSET_MSG_TYPE] == MSG_ID_B2S_HEARTBEAT) {
+            const uint64_t wait_ns = start_ns - now_ns;
+            const uint64_t ahead = wire_bytes(wait_ns, drv->baud);
+            drv->keepalive_count++;
+            if (ahead > drv->keepalive_ahead_max_bytes) {
+                drv->keepalive_ahead_max_bytes = ahead;
+            }
+            if (wait_ns / NS_PER_US > drv->keepalive_wait_max_us) {
+                drv->keepalive_wait_max_us = wait_ns / NS_PER_US;
+            }
+        }
+        start_ns += wire_ns(frames[i].iov_len, drv->baud);
+    }
+    drv->drained_ns = start_ns;
+    return true;
+}
+
+static std::size_t encode_frame(uint8_t msg_type, uint16_t seq, std::size_t payload_len,
+                                uint8_t* out)
+{
+    PacketHeader fields = {};
+    fields.msg_type = msg_type;
+    fields.src = NODE_ID_BRAIN;
+    fields.dst = NODE_ID_SPINE;
+    fields.seq = seq;
+
+    uint8_t payload[MAX_PAYLOAD_SIZE_BYTES] = {};
+    std::size_t frame_len = 0;
+    encode_packet(&fields, payload, payload_len, out, MAX_FRAME_BUFFER_SIZE, &frame_len);
+    return frame_len;
+}
+
+static void print_class(const char* name, const TxClassMetrics& m)
+{
+    const uint64_t mean_us = (m.sent_count > 0) ? (m.delay_total_us / m.sent_count) : 0;
+    std::printf("link.tx.%s.sent_count=%llu "
+                "link.tx.%s.dropped_count=%llu "
+                "link.tx.%s.delay_mean_us=%llu "
+                "link.tx.%s.delay_max_us=%u "
+                "link.tx.%s.budget_miss_count=%llu\n",
+                name, static_cast<unsigned long long>(m.sent_count),
+                name, static_cast<unsigned long long>(m.dropped_count),
+                name, static_cast<unsigned long long>(mean_us),
+                name, m.delay_max_us,
+                name, static_cast<unsigned long long>(m.budget_miss_count));
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t baud = 115200;
+    long seconds = 2;
+    bool fifo = false;
+    long batch_budget_us = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--fifo") == 0) {
+            fifo = true;
+            continue;
+        }
+        const long value = (i + 1 < argc) ? std::strtol(argv[i + 1], nullptr, 10) : 0;
+        if (value <= 0) {
+            std::fprintf(stderr, "usage: %s [--link-baud N] [--seconds N] [--fifo] "
+                                 "[--batch-budget-us N]\n", argv[0]);
+            return 2;
+        }
+        if (std::strcmp(argv[i], "--link-baud") == 0) {
+            baud = static_cast<uint32_t>(value);
+        } else if (std::strcmp(argv[i], "--seconds") == 0) {
+            seconds = value;
+        } else if (std::strcmp(argv[i], "--batch-budget-us") == 0) {
+            batch_budget_us = value;
+        } else {
+            std::fprintf(stderr, "usage: %s [--link-baud N] [--seconds N] [--fifo] "
+                                 "[--batch-budget-us N]\n", argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+
+    const bool batched = batch_budget_us > 0;
+    TxSchedulerConfig config;
+    SimDriver driver;
+    driver.baud = baud;
+    if (batched) {
+        config.batch_budget_us = static_cast<uint32_t>(batch_budget_us);
+    }
+    TxScheduler tx(config, batched ? nullptr : sim_link_sink, &baud,
+                   batched ? sim_driver_backlog : nullptr, &driver,
+                   batched ? sim_driver_batch_sink : nullptr, &driver);
+    TxClassSink safety_sink  = { &tx, fifo ? TxClass::BULK : TxClass::SAFETY };
+    const TxClass control_class = fifo ? TxClass::BULK : TxClass::CONTROL;
+
+    HeartbeatScheduler heartbeat(HeartbeatSchedulerConfig(), tx_class_frame_sink, &safety_sink);
+    if (tx.start() != SchedulerStatus::OK || heartbeat.start() != SchedulerStatus::OK) {
+        std::fprintf(stderr, "failed to start schedulers\n");
+        return 1;
+    }
+
+    std::atomic<bool> running{true};
+
+    std::thread control([&] {
+        uint8_t frame[MAX_FRAME_BUFFER_SIZE];
+        uint16_t seq = 0;
+        while (running.load()) {
+            const std::size_t len =
+                encode_frame(MSG_ID_B2S_MOTION_SETPOINT, seq++, CONTROL_PAYLOAD_BYTES, frame);
+            tx.enqueue(control_class, frame, len);
+            std::this_thread::sleep_for(std::chrono::milliseconds(CONTROL_PERIOD_MS));
+        }
+    });
+
+    // Bulk: offer a frame whenever the queue has room; a full queue rejects.
+    std::thread bulk([&] {
+        uint8_t frame[MAX_FRAME_BUFFER_SIZE];
+        const std::size_t len = encode_frame(0x7F, 0, MAX_PAYLOAD_SIZE_BYTES, frame);
+        while (running.load()) {
+            if (!tx.enqueue(TxClass::BULK, frame, len)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    });
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    running.store(false);
+    control.join();
+    bulk.join();
+    heartbeat.stop();
+    tx.stop();
+
+    std::printf("link.tx.mode=%s link.tx.link_baud=%u link.tx.batch_budget_us=%ld\n",
+                fifo ? "fifo" : "priority", baud, batch_budget_us);
+    print_class("safety", tx.metrics(TxClass::SAFETY));
+    print_class("control", tx.metrics(TxClass::CONTROL));
+    print_class("bulk", tx.metrics(TxClass::BULK));
+    if (!batched) {
+        return 0;
+    }
+
+    const uint64_t ahead_bound = config.max_backlog_bytes + MAX_FRAME_BUFFER_SIZE;
+    std::printf("link.tx.flush_count=%llu link.tx.frames_per_flush=%.2f "
+                "link.tx.keepalive_count=%llu link.tx.keepalive_ahead_max_bytes=%llu "
+                "link.tx.keepalive_ahead_bound_bytes=%llu link.tx.keepalive_wire_wait_max_us=%llu\n",
+                static_cast<unsigned long long>(tx.flush_count()),
+                tx.flush_count() ? static_cast<double>(tx.flushed_frame_count()) / tx.flush_count() : 0.0,
+                static_cast<unsigned long long>(driver.keepalive_count),
+                static_cast<unsigned long long>(driver.keepalive_ahead_max_bytes),
+                static_cast<unsigned long long>(ahead_bound),
+                static_cast<unsigned long long>(driver.keepalive_wait_max_us));
+    return (driver.keepalive_ahead_max_bytes <= ahead_bound) ? 0 : 1;
+}
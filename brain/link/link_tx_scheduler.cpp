@@ -0,0 +1,321 @@
+/**
+ * @file link_tx_scheduler.cpp
+ * @brief Writer thread and per-class FIFOs for the strict-priority TX path.
+ *
+ * Writer loop:
+ * - wait until some class has a frame (or stop)
+ * - pick the highest non-empty class
+ * - CONTROL/BULK only: if the backlog probe reports more than
+ *   max_backlog_bytes, wait backlog_poll_us and re-pick (a SAFETY frame
+ *   that arrives meanwhile goes first)
+ * - take one frame; with batching, gather more (see gather_locked) but
+ *   no more CONTROL/BULK bytes than the probe left room for
+ * - hand the batch to the sink outside the lock, record each frame's delay
+ */
+
+#include "link_tx_scheduler.h"
+
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+namespace s2t {
+namespace link {
+
+static uint64_t monotonic_now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * NS_PER_S +
+           static_cast<uint64_t>(ts.tv_nsec);
+}
+
+TxScheduler::TxScheduler(const TxSchedulerConfig& config,
+                         FrameSink sink,
+                         void* sink_ctx,
+                         TxBacklogProbe probe,
+                         void* probe_ctx,
+                         FrameBatchSink batch_sink,
+                         void* batch_sink_ctx)
+    : config_(config), sink_(sink), sink_ctx_(sink_ctx), probe_(probe), probe_ctx_(probe_ctx),
+      batch_sink_(batch_sink), batch_sink_ctx_(batch_sink_ctx)
+{
+    // Storage is sized once here; enqueue never allocates.
+    for (std::size_t c = 0; c < TX_CLASS_COUNT; ++c) {
+        queues_[c].ring.resize(config_.queue_depth[c]);
+    }
+}
+
+TxScheduler::~TxScheduler()
+{
+    stop();
+}
+
+SchedulerStatus TxScheduler::start()
+{
+    if (thread_.joinable()) {
+        return SchedulerStatus::ERR_ALREADY_RUNNING;
+    }
+    if (!sink_ && !batch_sink_) {
+        return SchedulerStatus::ERR_INVALID_CONFIG;
+    }
+    for (std::size_t c = 0; c < TX_CLASS_COUNT; ++c) {
+        if (config_.queue_depth[c] == 0) {
+            return SchedulerStatus::ERR_INVALID_CONFIG;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        accepting_ = true;
+        stop_requested_ = false;
+    }
+
+    try {
+        thread_ = std::thread(&TxScheduler::run, this);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        accepting_ = false;
+        return SchedulerStatus::ERR_THREAD;
+    }
+    return SchedulerStatus::OK;
+}
+
+void TxScheduler::stop()
+{
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        accepting_ = false;
+        stop_requested_ = true;
+    }
+    cv_.notify_one();
+    thread_.join();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t c = 0; c < TX_CLASS_COUNT; ++c) {
+        metrics_[c].dropped_count += queues_[c].count;
+        queues_[c].head = 0;
+        queues_[c].count = 0;
+    }
+}
+
+bool TxScheduler::enqueue(TxClass tx_class, const uint8_t* frame, std::size_t frame_len)
+{
+    if (tx_class >= TxClass::COUNT || !frame || frame_len == 0 ||
+        frame_len > protocol::MAX_FRAME_BUFFER_SIZE) {
+        return false;
+    }
+
+    const std::size_t c = static_cast<std::size_t>(tx_class);
+    const uint64_t now_ns = monotonic_now_ns();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Queue& q = queues_[c];
+        if (!accepting_ || q.count == q.ring.size()) {
+            metrics_[c].dropped_count++;
+            return false;
+        }
+
+        Entry& e = q.ring[(q.head + q.count) % q.ring.size()];
+        e.enqueue_ns = now_ns;
+        e.frame_len = static_cast<uint16_t>(frame_len);
+        std::memcpy(e.frame, frame, frame_len);
+        q.count++;
+        metrics_[c].enqueued_count++;
+    }
+    cv_.notify_one();
+    return true;
+}
+
+TxClassMetrics TxScheduler::metrics(TxClass tx_class) const
+{
+    if (tx_class >= TxClass::COUNT) {
+        return TxClassMetrics();
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    return metrics_[static_cast<std::size_t>(tx_class)];
+}
+
+uint64_t TxScheduler::backlog_wait_count() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return backlog_wait_count_;
+}
+
+uint64_t TxScheduler::flush_count() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return flush_count_;
+}
+
+uint64_t TxScheduler::flushed_frame_count() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return flushed_frame_count_;
+}
+
+int TxScheduler::next_class_locked() const
+{
+    for (std::size_t c = 0; c < TX_CLASS_COUNT; ++c) {
+        if (queues_[c].count > 0) {
+            return static_cast<int>(c);
+        }
+    }
+    return -1;
+}
+
+void TxScheduler::take_locked(std::size_t tx_class)
+{
+    Queue& q = queues_[tx_class];
+    const Entry& head = q.ring[q.head];
+    Entry& e = batch_[batch_count_];
+    e.enqueue_ns = head.enqueue_ns;
+    e.frame_len = head.frame_len;
+    std::memcpy(e.frame, head.frame, head.frame_len);
+    batch_class_[batch_count_] = static_cast<uint8_t>(tx_class);
+    batch_count_++;
+    batch_bytes_ += head.frame_len;
+
+    q.head = (q.head + 1) % q.ring.size();
+    q.count--;
+}
+
+/**
+ * Grow the batch (first frame already taken) until the budget measured
+ * from that frame's enqueue runs out, a bound is hit, or a SAFETY frame
+ * joins. CONTROL/BULK frames join only while the batch stays within
+ * `byte_limit`; SAFETY frames are never held back.
+ */
+void TxScheduler::gather_locked(std::unique_lock<std::mutex>& lock, std::size_t byte_limit)
+{
+    const uint64_t deadline_ns =
+        batch_[0].enqueue_ns + static_cast<uint64_t>(config_.batch_budget_us) * NS_PER_US;
+
+    while (batch_count_ < TX_BATCH_MAX_FRAMES && !stop_requested_) {
+        const int c = next_class_locked();
+        if (c >= 0) {
+            const Queue& q = queues_[c];
+            const std::size_t frame_len = q.ring[q.head].frame_len;
+            if (batch_bytes_ + frame_len > TX_BATCH_MAX_BYTES ||
+                (c != static_cast<int>(TxClass::SAFETY) && batch_bytes_ + frame_len > byte_limit)) {
+                return;
+            }
+            take_locked(static_cast<std::size_t>(c));
+            if (c == static_cast<int>(TxClass::SAFETY)) {
+                return;
+            }
+            continue;
+        }
+
+        const uint64_t now_ns = monotonic_now_ns();
+        if (now_ns >= deadline_ns) {
+            return;
+        }
+        cv_.wait_for(lock, std::chrono::nanoseconds(deadline_ns - now_ns));
+    }
+}
+
+void TxScheduler::flush_batch(std::unique_lock<std::mutex>& lock)
+{
+    const std::size_t count = batch_count_;
+
+    lock.unlock();
+    const uint64_t now_ns = monotonic_now_ns();
+    bool ok;
+    if (batch_sink_) {
+        struct iovec iov[TX_BATCH_MAX_FRAMES];
+        for (std::size_t i = 0; i < count; ++i) {
+            iov[i].iov_base = batch_[i].frame;
+            iov[i].iov_len = batch_[i].frame_len;
+        }
+        ok = batch_sink_(iov, count, batch_sink_ctx_);
+    } else {
+        ok = sink_(batch_[0].frame, batch_[0].frame_len, sink_ctx_);
+    }
+    lock.lock();
+
+    flush_count_++;
+    flushed_frame_count_ += count;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t c = batch_class_[i];
+        TxClassMetrics& m = metrics_[c];
+        if (!ok) {
+            m.send_error_count++;
+            continue;
+        }
+
+        const uint64_t delay_ns =
+            (now_ns > batch_[i].enqueue_ns) ? (now_ns - batch_[i].enqueue_ns) : 0;
+        const uint32_t delay_us = static_cast<uint32_t>(delay_ns / NS_PER_US);
+        m.sent_count++;
+        m.delay_last_us = delay_us;
+        m.delay_total_us += delay_us;
+        if (delay_us > m.delay_max_us) {
+            m.delay_max_us = delay_us;
+        }
+        if (config_.delay_budget_us[c] > 0 && delay_us > config_.delay_budget_us[c]) {
+            m.budget_miss_count++;
+        }
+    }
+
+    batch_count_ = 0;
+    batch_bytes_ = 0;
+}
+
+void TxScheduler::run()
+{
+    const auto backlog_poll = std::chrono::microseconds(config_.backlog_poll_us);
+    const bool batching = batch_sink_ && config_.batch_budget_us > 0;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return stop_requested_ || next_class_locked() >= 0; });
+        if (stop_requested_) {
+            return;
+        }
+
+        const int c = next_class_locked();
+        std::size_t batch_limit = TX_BATCH_MAX_BYTES;
+        if (c != static_cast<int>(TxClass::SAFETY) && probe_) {
+            lock.unlock();
+            const std::size_t backlog = probe_(probe_ctx_);
+            lock.lock();
+            if (backlog > config_.max_backlog_bytes) {
+                backlog_wait_count_++;
+                // Wakes early if anything is enqueued, so SAFETY is re-picked.
+                cv_.wait_for(lock, backlog_poll);
+                continue;
+            }
+            if (next_class_locked() != c) {
+                continue;  // something more urgent arrived while probing
+            }
+            // The driver only drains from here on, so the probed backlog
+            // plus the batch bounds what a later keepalive finds ahead.
+            batch_limit = config_.max_backlog_bytes - backlog;
+        }
+
+        take_locked(static_cast<std::size_t>(c));
+        if (batching && c != static_cast<int>(TxClass::SAFETY)) {
+            gather_locked(lock, batch_limit);
+        }
+        flush_batch(lock);
+    }
+}
+
+bool tx_class_frame_sink(const uint8_t* frame, std::size_t frame_len, void* ctx)
+{
+    TxClassSink* binding = static_cast<TxClassSink*>(ctx);
+    if (!binding || !binding->scheduler) {
+        return false;
+    }
+    return binding->scheduler->enqueue(binding->tx_class, frame, frame_len);
+}
+
+} // namespace link
+} // namespace s2t
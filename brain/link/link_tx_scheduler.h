@@ -0,0 +1,213 @@
+#ifndef LINK_TX_SCHEDULER_H
+#define LINK_TX_SCHEDULER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bs_protocol.h"
+#include "link_frame_sink.h"
+#include "link_heartbeat_scheduler.h"
+#include "link_timing_constants.h"
+
+/**
+ * @file link_tx_scheduler.h
+ * @brief Strict-priority transmit scheduler for the single Brain -> Spine pipe.
+ *
+ * Every outgoing frame goes through one writer thread. Frames wait in one
+ * bounded FIFO per class, and the writer always takes the next frame from
+ * the highest non-empty class:
+ *
+ *   SAFETY   B2S_HEARTBEAT, MOTION_ENABLE      (hold timeout depends on it)
+ *   CONTROL  MOTION_SETPOINT, HELLO
+ *   BULK     diagnostics, dumps, anything else
+ *
+ * Preemption is at frame boundaries: a frame already handed to the sink is
+ * never split, so a keepalive waits at most for one frame in flight.
+ *
+ * The kernel tty buffer would otherwise undo this: bulk frames sitting in
+ * it are ahead of any later keepalive. With a backlog probe (for example
+ * serial_port_backlog_probe), CONTROL and BULK frames are held back while
+ * more than max_backlog_bytes are still queued in the driver. SAFETY frames
+ * are never held back.
+ *
+ * Producers keep their own FrameSink interface: bind a TxClassSink to a
+ * class and pass tx_class_frame_sink to HeartbeatScheduler,
+ * SetpointCoalescer or any other sender. Enqueue copies the frame and
+ * never blocks on the transport; a full class queue rejects the frame.
+ *
+ * Batching (optional, needs a FrameBatchSink and batch_budget_us > 0):
+ * after taking a CONTROL or BULK frame the writer keeps gathering ready
+ * frames, still in priority order, until batch_budget_us after the first
+ * one was enqueued, TX_BATCH_MAX_FRAMES / TX_BATCH_MAX_BYTES is reached,
+ * or a SAFETY frame joins the batch. With a probe, CONTROL/BULK frames
+ * join only while the probed backlog plus the batch stays within
+ * max_backlog_bytes, so batching keeps the keepalive bound above. The
+ * batch then goes out as one FrameBatchSink call (one writev). A SAFETY
+ * frame taken first is flushed alone and at once. The budget caps the
+ * latency batching adds. When a FrameBatchSink is given it carries all
+ * traffic, single frames included, and the FrameSink may be null.
+ *
+ * Metrics per class: queueing delay (enqueue to sink) last/mean/max, and
+ * the number of frames whose delay exceeded the class budget. Batching
+ * delay is part of the queueing delay.
+ *
+ * Lifecycle matches HeartbeatScheduler. Frames still queued at stop() are
+ * discarded. The downstream sinks, their contexts and the probe are
+ * borrowed and must outlive the running thread.
+ */
+
+namespace s2t {
+namespace link {
+
+enum class TxClass : uint32_t {
+    SAFETY = 0,
+    CONTROL,
+    BULK,
+    COUNT
+};
+
+static constexpr std::size_t TX_CLASS_COUNT = static_cast<std::size_t>(TxClass::COUNT);
+
+// Upper bounds for one batched flush. 4 KiB is the usual tty write buffer.
+static constexpr std::size_t TX_BATCH_MAX_FRAMES = 16;
+static constexpr std::size_t TX_BATCH_MAX_BYTES  = 4096;
+
+/**
+ * Bytes still queued below the scheduler (driver / UART). Returns 0 if
+ * unknown.
+ */
+typedef std::size_t (*TxBacklogProbe)(void* ctx);
+
+struct TxSchedulerConfig {
+    // Frames each class can hold before enqueue rejects.
+    std::size_t queue_depth[TX_CLASS_COUNT] = { 8, 32, 64 };
+
+    // Queueing-delay budget per class; 0 disables the check.
+    // SAFETY leaves most of the hold timeout for the Spine side.
+    uint32_t delay_budget_us[TX_CLASS_COUNT] = {
+        50 * US_PER_MS, 100 * US_PER_MS, 0
+    };
+
+    // CONTROL/BULK wait while the probe reports more than this. About one
+    // maximum frame, so a keepalive never sits behind more than that.
+    std::size_t max_backlog_bytes = protocol::MAX_FRAME_BUFFER_SIZE;
+
+    // How often a held-back writer re-reads the probe.
+    uint32_t backlog_poll_us = 1 * US_PER_MS;
+
+    // How long the first frame of a batch may wait for company. 0 sends
+    // every frame on its own. Ignored without a FrameBatchSink.
+    uint32_t batch_budget_us = 0;
+};
+
+struct TxClassMetrics {
+    uint64_t enqueued_count      = 0;
+    uint64_t sent_count          = 0;
+    uint64_t send_error_count    = 0;
+    uint64_t dropped_count       = 0;  // rejected: queue full or not running
+    uint64_t budget_miss_count   = 0;  // delay above delay_budget_us
+    uint32_t delay_last_us       = 0;
+    uint32_t delay_max_us        = 0;
+    uint64_t delay_total_us      = 0;  // sum over sent_count, for the mean
+};
+
+class TxScheduler {
+public:
+    TxScheduler(const TxSchedulerConfig& config,
+                FrameSink sink,
+                void* sink_ctx,
+                TxBacklogProbe probe = nullptr,
+                void* probe_ctx = nullptr,
+                FrameBatchSink batch_sink = nullptr,
+                void* batch_sink_ctx = nullptr);
+    ~TxScheduler();
+
+    TxScheduler(const TxScheduler&) = delete;
+    TxScheduler& operator=(const TxScheduler&) = delete;
+
+    SchedulerStatus start();
+    void stop();
+
+    bool running() const { return thread_.joinable(); }
+
+    /**
+     * Copy one encoded frame into the class queue. Returns false if the
+     * scheduler is stopped, the queue is full or the frame is too large.
+     */
+    bool enqueue(TxClass tx_class, const uint8_t* frame, std::size_t frame_len);
+
+    TxClassMetrics metrics(TxClass tx_class) const;
+
+    uint64_t backlog_wait_count() const;
+
+    // Sink calls made, and frames they carried (frames / flushes = mean batch).
+    uint64_t flush_count() const;
+    uint64_t flushed_frame_count() const;
+
+private:
+    struct Entry {
+        uint64_t enqueue_ns;
+        uint16_t frame_len;
+        uint8_t  frame[protocol::MAX_FRAME_BUFFER_SIZE];
+    };
+
+    struct Queue {
+        std::vector<Entry> ring;
+        std::size_t head = 0;
+        std::size_t count = 0;
+    };
+
+    void run();
+    int next_class_locked() const;
+    void take_locked(std::size_t tx_class);
+    void gather_locked(std::unique_lock<std::mutex>& lock, std::size_t byte_limit);
+    void flush_batch(std::unique_lock<std::mutex>& lock);
+
+    TxSchedulerConfig config_;
+    FrameSink sink_;
+    void* sink_ctx_;
+    TxBacklogProbe probe_;
+    void* probe_ctx_;
+    FrameBatchSink batch_sink_;
+    void* batch_sink_ctx_;
+
+    std::thread thread_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool accepting_ = false;
+    bool stop_requested_ = false;
+
+    Queue queues_[TX_CLASS_COUNT];
+    TxClassMetrics metrics_[TX_CLASS_COUNT];
+    uint64_t backlog_wait_count_ = 0;
+    uint64_t flush_count_ = 0;
+    uint64_t flushed_frame_count_ = 0;
+
+    // Frames taken for the current flush; only the writer thread uses these.
+    Entry batch_[TX_BATCH_MAX_FRAMES];
+    uint8_t batch_class_[TX_BATCH_MAX_FRAMES];
+    std::size_t batch_count_ = 0;
+    std::size_t batch_bytes_ = 0;
+};
+
+/**
+ * FrameSink context that feeds one class of a TxScheduler.
+ */
+struct TxClassSink {
+    TxScheduler* scheduler;
+    TxClass tx_class;
+};
+
+/**
+ * FrameSink adapter: `ctx` must point to a TxClassSink.
+ */
+bool tx_class_frame_sink(const uint8_t* frame, std::size_t frame_len, void* ctx);
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_TX_SCHEDULER_H
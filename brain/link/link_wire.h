@@ -0,0 +1,31 @@
+#ifndef LINK_WIRE_H
+#define LINK_WIRE_H
+
+#include <cstdint>
+
+/**
+ * @file link_wire.h
+ * @brief Little-endian field reads for the Spine payload decoders.
+ *
+ * Shared by the S2B_ACK, S2B_EVENT_LOG and S2B_LOG parsers. Byte-wise, so
+ * payload fields need no alignment. Both return uint32_t so a u16 can be
+ * shifted and combined without casts at the call site.
+ */
+
+namespace s2t {
+namespace link {
+
+inline uint32_t get_u16_le(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8);
+}
+
+inline uint32_t get_u32_le(const uint8_t* p)
+{
+    return get_u16_le(p) | (get_u16_le(p + 2) << 16);
+}
+
+} // namespace link
+} // namespace s2t
+
+#endif // LINK_WIRE_H
@@ -0,0 +1,273 @@
+/**
+ * @file bs_c_api.cpp
+ * @brief C ABI over the Brain protocol core (see bs_c_api.h).
+ *
+ * Thin adapters only: every check and computation is the C++ core's.
+ * Layout of each public struct is pinned with static_assert so an
+ * accidental change fails the build instead of breaking bindings.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+#include "bs_c_api.h"
+#include "bs_protocol.h"
+
+namespace s2t {
+namespace protocol {
+
+// Forward declarations (implemented in bs_crc.cpp)
+uint16_t compute_header_crc16(const uint8_t* data, std::size_t len);
+uint32_t compute_payload_crc32(const uint8_t* data, std::size_t len);
+
+} // namespace protocol
+} // namespace s2t
+
+using namespace s2t::protocol;
+
+static_assert(sizeof(s2t_header_t) == 16, "ABI: s2t_header_t layout changed");
+static_assert(sizeof(s2t_frame_record_t) == 16, "ABI: s2t_frame_record_t layout changed");
+static_assert(offsetof(s2t_frame_record_t, status) == 12, "ABI: s2t_frame_record_t layout changed");
+static_assert(sizeof(s2t_framer_stats_t) == 24, "ABI: s2t_framer_stats_t layout changed");
+
+static_assert(S2T_PACKET_ERR_PAYLOAD_CRC ==
+              static_cast<int>(PacketStatus::ERR_PAYLOAD_CRC_MISMATCH),
+              "ABI: PacketStatus values changed");
+static_assert(S2T_HEADER_ERR_CRC == static_cast<int>(HeaderStatus::ERR_CRC_MISMATCH),
+              "ABI: HeaderStatus values changed");
+static_assert(S2T_ENCODE_ERR_BUFFER_TOO_SMALL ==
+              static_cast<int>(EncodeStatus::ERR_BUFFER_TOO_SMALL),
+              "ABI: EncodeStatus values changed");
+
+static_assert(S2T_BATCH_MIN_ARENA >= MAX_FRAME_BUFFER_SIZE,
+              "S2T_BATCH_MIN_ARENA below the framer buffer");
+static_assert(S2T_BATCH_MIN_RECORDS > MAX_FRAME_BUFFER_SIZE / MIN_PACKET_SIZE_BYTES,
+              "S2T_BATCH_MIN_RECORDS below the frames one framer buffer can hold");
+
+struct s2t_framer {
+    ByteStreamFramer framer;
+    uint64_t bytes_in;
+    uint32_t frames_valid;
+    uint32_t frames_invalid;
+};
+
+namespace {
+
+// Destination of one push_batch slice.
+struct BatchSink {
+    s2t_framer*         owner;
+    s2t_frame_record_t* records;
+    std::size_t         record_count;
+    uint8_t*            arena;
+    std::size_t         arena_used;
+};
+
+void on_batch_frame(const uint8_t* frame_buf, std::size_t frame_len, void* ctx)
+{
+    BatchSink* sink = static_cast<BatchSink*>(ctx);
+
+    // The framer only emits frames whose header already validated.
+    PacketHeader hdr;
+    parse_and_validate_header(frame_buf, frame_len, &hdr);
+    const PacketStatus st = validate_packet(frame_buf, frame_len);
+
+    s2t_frame_record_t* rec = &sink->records[sink->record_count++];
+    std::memset(rec, 0, sizeof(*rec));
+    rec->payload_offset = static_cast<uint32_t>(sink->arena_used);
+    rec->payload_len    = hdr.payload_len;
+    rec->seq            = hdr.seq;
+    rec->msg_type       = hdr.msg_type;
+    rec->flags          = hdr.flags;
+    rec->src            = hdr.src;
+    rec->dst            = hdr.dst;
+    rec->status         = static_cast<uint8_t>(st);
+
+    if (hdr.payload_len > 0) {
+        std::memcpy(sink->arena + sink->arena_used, frame_buf + HEADER_SIZE_BYTES, hdr.payload_len);
+        sink->arena_used += hdr.payload_len;
+    }
+
+    if (st == PacketStatus::OK) {
+        sink->owner->frames_valid++;
+    } else {
+        sink->owner->frames_invalid++;
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+uint32_t s2t_abi_version(void)
+{
+    return S2T_ABI_VERSION;
+}
+
+size_t s2t_header_size(void)
+{
+    return HEADER_SIZE_BYTES;
+}
+
+size_t s2t_trailer_size(void)
+{
+    return TRAILER_SIZE_BYTES;
+}
+
+size_t s2t_max_payload_size(void)
+{
+    return MAX_PAYLOAD_SIZE_BYTES;
+}
+
+uint16_t s2t_crc16_ccitt_false(const uint8_t* data, size_t len)
+{
+    return compute_header_crc16(data, len);
+}
+
+uint32_t s2t_crc32_iso_hdlc(const uint8_t* data, size_t len)
+{
+    return compute_payload_crc32(data, len);
+}
+
+int s2t_parse_header(const uint8_t* buf, size_t len, s2t_header_t* out)
+{
+    if (!out) {
+        return S2T_HEADER_ERR_INVALID_ARGS;
+    }
+
+    PacketHeader hdr{};
+    const HeaderStatus st = parse_and_validate_header(buf, len, &hdr);
+    if (st != HeaderStatus::OK && buf && len >= HEADER_SIZE_BYTES) {
+        // The validator leaves rejected headers undecoded; bindings still
+        // get the raw fields to show what was on the wire.
+        decode_header_fields(buf, &hdr);
+    }
+
+    std::memset(out, 0, sizeof(*out));
+    out->magic        = hdr.magic;
+    out->proto_major  = hdr.proto_major;
+    out->proto_minor  = hdr.proto_minor;
+    out->msg_type     = hdr.msg_type;
+    out->flags        = hdr.flags;
+    out->src          = hdr.src;
+    out->dst          = hdr.dst;
+    out->seq          = hdr.seq;
+    out->payload_len  = hdr.payload_len;
+    out->header_crc16 = hdr.header_crc16;
+    return static_cast<int>(st);
+}
+
+int s2t_validate_packet(const uint8_t* buf, size_t len)
+{
+    return static_cast<int>(validate_packet(buf, len));
+}
+
+int s2t_encode_packet(const s2t_header_t* fields,
+                      const uint8_t* payload,
+                      size_t payload_len,
+                      uint8_t* out,
+                      size_t out_cap,
+                      size_t* out_len)
+{
+    if (!fields) {
+        return S2T_ENCODE_ERR_INVALID_ARGS;
+    }
+
+    PacketHeader hdr{};
+    hdr.msg_type = fields->msg_type;
+    hdr.flags    = fields->flags;
+    hdr.src      = fields->src;
+    hdr.dst      = fields->dst;
+    hdr.seq      = fields->seq;
+    return static_cast<int>(encode_packet(&hdr, payload, payload_len, out, out_cap, out_len));
+}
+
+s2t_framer_t* s2t_framer_create(void)
+{
+    s2t_framer* f = new (std::nothrow) s2t_framer;
+    if (f) {
+        s2t_framer_reset(f);
+    }
+    return f;
+}
+
+void s2t_framer_destroy(s2t_framer_t* framer)
+{
+    delete framer;
+}
+
+void s2t_framer_reset(s2t_framer_t* framer)
+{
+    if (!framer) {
+        return;
+    }
+    bs_framer_init(&framer->framer);
+    framer->bytes_in = 0;
+    framer->frames_valid = 0;
+    framer->frames_invalid = 0;
+}
+
+void s2t_framer_get_stats(const s2t_framer_t* framer, s2t_framer_stats_t* out)
+{
+    if (!framer || !out) {
+        return;
+    }
+    std::memset(out, 0, sizeof(*out));
+    out->bytes_in       = framer->bytes_in;
+    out->frames_found   = framer->framer.frames_found_count;
+    out->frames_valid   = framer->frames_valid;
+    out->frames_invalid = framer->frames_invalid;
+    out->sync_losses    = framer->framer.sync_loss_count;
+}
+
+size_t s2t_framer_push_batch(s2t_framer_t* framer,
+                             const uint8_t* data,
+                             size_t len,
+                             s2t_frame_record_t* records,
+                             size_t record_cap,
+                             uint8_t* arena,
+                             size_t arena_cap,
+                             size_t* consumed)
+{
+    if (consumed) {
+        *consumed = 0;
+    }
+    if (!framer || !records || !arena || !consumed || (!data && len > 0)) {
+        return 0;
+    }
+
+    BatchSink sink{framer, records, 0, arena, 0};
+    std::size_t taken = 0;
+
+    // Each slice is sized so that even if every buffered and new byte
+    // resolves into minimum-size frames, records and arena still hold
+    // them all. Payload bytes can never exceed the bytes they came from.
+    while (taken < len) {
+        const std::size_t buffered = framer->framer.write_idx;
+        const std::size_t records_free = record_cap - sink.record_count;
+        const std::size_t arena_free = arena_cap - sink.arena_used;
+
+        const std::size_t by_records = records_free * MIN_PACKET_SIZE_BYTES + (MIN_PACKET_SIZE_BYTES - 1);
+        const std::size_t by_arena = arena_free;
+        std::size_t limit = (by_records < by_arena) ? by_records : by_arena;
+        if (limit <= buffered) {
+            break;
+        }
+        limit -= buffered;
+
+        std::size_t slice = len - taken;
+        if (slice > limit) {
+            slice = limit;
+        }
+
+        bs_framer_push(&framer->framer, data + taken, slice, on_batch_frame, &sink);
+        taken += slice;
+    }
+
+    framer->bytes_in += taken;
+    *consumed = taken;
+    return sink.record_count;
+}
+
+} // extern "C"
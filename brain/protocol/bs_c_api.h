@@ -0,0 +1,162 @@
+#ifndef BS_C_API_H
+#define BS_C_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file bs_c_api.h
+ * @brief Stable C ABI over the Brain protocol core (libs2t_protocol).
+ *
+ * For callers that cannot use the C++ interface (Python via ctypes/CFFI,
+ * other languages, dlopen). Rules that keep the ABI stable:
+ * - plain C types only; every struct is fixed-size, fixed-layout and
+ *   checked with static_assert in bs_c_api.cpp
+ * - status codes are ints with the values below, never C++ enums
+ * - framer state is opaque and heap-owned by the library
+ * - S2T_ABI_VERSION is bumped on any incompatible change; callers check
+ *   s2t_abi_version() before use
+ *
+ * Payloads are exposed as views (offset + length into a caller buffer);
+ * the library does not interpret payload bytes.
+ *
+ * No I/O, no timing, no threads. A framer handle must not be used from
+ * two threads at once; distinct handles are independent.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define S2T_ABI_VERSION 1u
+
+/* Packet validation results (match s2t::protocol::PacketStatus). */
+#define S2T_PACKET_OK                   0
+#define S2T_PACKET_ERR_INVALID_ARGS     1
+#define S2T_PACKET_ERR_HEADER_INVALID   2
+#define S2T_PACKET_ERR_LENGTH_MISMATCH  3
+#define S2T_PACKET_ERR_PAYLOAD_CRC      4
+
+/* Header parse results (match s2t::protocol::HeaderStatus). */
+#define S2T_HEADER_OK                   0
+#define S2T_HEADER_ERR_INVALID_ARGS     1
+#define S2T_HEADER_ERR_BUFFER_TOO_SMALL 2
+#define S2T_HEADER_ERR_MAGIC            3
+#define S2T_HEADER_ERR_VERSION          4
+#define S2T_HEADER_ERR_PAYLOAD_TOO_LARGE 5
+#define S2T_HEADER_ERR_CRC              6
+
+/* Encode results (match s2t::protocol::EncodeStatus). */
+#define S2T_ENCODE_OK                    0
+#define S2T_ENCODE_ERR_INVALID_ARGS      1
+#define S2T_ENCODE_ERR_PAYLOAD_TOO_LARGE 2
+#define S2T_ENCODE_ERR_BUFFER_TOO_SMALL  3
+
+/*
+ * Smallest buffers s2t_framer_push_batch() can always make progress with:
+ * everything still buffered in the framer (one frame buffer) may resolve
+ * into frames at once.
+ */
+#define S2T_BATCH_MIN_RECORDS 16u
+#define S2T_BATCH_MIN_ARENA   274u
+
+/* Decoded header fields, 16 bytes. */
+typedef struct {
+    uint16_t magic;
+    uint8_t  proto_major;
+    uint8_t  proto_minor;
+    uint8_t  msg_type;
+    uint8_t  flags;
+    uint8_t  src;
+    uint8_t  dst;
+    uint16_t seq;
+    uint16_t payload_len;
+    uint16_t header_crc16;
+    uint16_t reserved;
+} s2t_header_t;
+
+/*
+ * One extracted frame, 16 bytes, little-endian natural alignment.
+ * The payload is arena[payload_offset .. payload_offset + payload_len).
+ * status is an S2T_PACKET_* code: frames whose payload CRC fails are
+ * still reported, so tooling can count them.
+ */
+typedef struct {
+    uint32_t payload_offset;
+    uint16_t payload_len;
+    uint16_t seq;
+    uint8_t  msg_type;
+    uint8_t  flags;
+    uint8_t  src;
+    uint8_t  dst;
+    uint8_t  status;
+    uint8_t  reserved[3];
+} s2t_frame_record_t;
+
+/* Framer counters (cumulative since create/reset). */
+typedef struct {
+    uint64_t bytes_in;
+    uint32_t frames_found;
+    uint32_t frames_valid;
+    uint32_t frames_invalid;
+    uint32_t sync_losses;
+} s2t_framer_stats_t;
+
+typedef struct s2t_framer s2t_framer_t;
+
+uint32_t s2t_abi_version(void);
+
+/* Contract constants, so bindings need not hard-code them. */
+size_t s2t_header_size(void);
+size_t s2t_trailer_size(void);
+size_t s2t_max_payload_size(void);
+
+uint16_t s2t_crc16_ccitt_false(const uint8_t* data, size_t len);
+uint32_t s2t_crc32_iso_hdlc(const uint8_t* data, size_t len);
+
+int s2t_parse_header(const uint8_t* buf, size_t len, s2t_header_t* out);
+int s2t_validate_packet(const uint8_t* buf, size_t len);
+
+/*
+ * Encode one packet. Only msg_type, flags, src, dst and seq are read from
+ * `fields`; everything else is derived (see encode_packet()).
+ */
+int s2t_encode_packet(const s2t_header_t* fields,
+                      const uint8_t* payload,
+                      size_t payload_len,
+                      uint8_t* out,
+                      size_t out_cap,
+                      size_t* out_len);
+
+/* NULL on allocation failure. */
+s2t_framer_t* s2t_framer_create(void);
+void s2t_framer_destroy(s2t_framer_t* framer);
+void s2t_framer_reset(s2t_framer_t* framer);
+void s2t_framer_get_stats(const s2t_framer_t* framer, s2t_framer_stats_t* out);
+
+/*
+ * Feed stream bytes and collect the frames they complete.
+ *
+ * Consumes input only as far as `records` and `arena` are guaranteed to
+ * hold every resulting frame, so nothing is ever dropped for lack of
+ * space: *consumed tells how much of `data` was taken, and the caller
+ * pushes the rest with fresh (or drained) buffers. With at least
+ * S2T_BATCH_MIN_RECORDS records and S2T_BATCH_MIN_ARENA arena bytes every
+ * call consumes something.
+ *
+ * Returns the number of records written.
+ */
+size_t s2t_framer_push_batch(s2t_framer_t* framer,
+                             const uint8_t* data,
+                             size_t len,
+                             s2t_frame_record_t* records,
+                             size_t record_cap,
+                             uint8_t* arena,
+                             size_t arena_cap,
+                             size_t* consumed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BS_C_API_H */
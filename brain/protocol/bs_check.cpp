@@ -0,0 +1,300 @@
+/**
+ * @file bs_check.cpp
+ * @brief Self-checks for s2t_protocol, run by ctest.
+ *
+ * Usage:
+ *   bs_check crc
+ *   bs_check roundtrip
+ *   bs_check resync STREAM_FILE [--chunk N] [--min-valid N]
+ *
+ * crc        CRC-16/CCITT-FALSE and CRC-32/ISO-HDLC check values
+ *            ("123456789"), the empty-payload rule, the header CRC with
+ *            its field taken as zero, and both CRCs against byte-table
+ *            references over pseudo-random buffers of every length up to
+ *            the payload maximum.
+ * roundtrip  encode -> validate -> parse for every payload length, then
+ *            every single-bit flip of a frame must fail validation.
+ * resync     push a captured stream (bs_bench --write-stream) through the
+ *            framer in --chunk byte pieces (0 = all at once) and compare
+ *            the frames found with a byte-by-byte push, which never fills
+ *            the buffer with input still pending.
+ *
+ * Prints one `protocol.check.<name>=<pass|fail>` line; exit status 0 on
+ * pass, 1 on a failed check, 2 on usage or I/O errors.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "bs_protocol.h"
+
+namespace s2t {
+namespace protocol {
+
+// Forward declarations (implemented in bs_crc.cpp)
+uint16_t compute_header_crc16(const uint8_t* data, std::size_t len);
+uint16_t compute_header_crc16_zeroed(const uint8_t* header);
+uint32_t compute_payload_crc32(const uint8_t* data, std::size_t len);
+
+} // namespace protocol
+} // namespace s2t
+
+using namespace s2t::protocol;
+
+static constexpr uint16_t CRC16_CHECK_VALUE = 0x29B1;       // CRC-16/CCITT-FALSE
+static constexpr uint32_t CRC32_CHECK_VALUE = 0xCBF43926u;  // CRC-32/ISO-HDLC
+static const uint8_t CHECK_INPUT[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+static constexpr uint32_t CRC_REFERENCE_ROUNDS = 16;
+
+static uint32_t g_failures = 0;
+
+static void expect(bool ok, const char* what)
+{
+    if (!ok) {
+        std::fprintf(stderr, "bs_check: FAILED %s\n", what);
+        g_failures++;
+    }
+}
+
+/**
+ * Byte-at-a-time table CRCs, built from the contract polynomials. An
+ * independent formulation of the bitwise kernels in bs_crc.cpp.
+ */
+struct CrcTables {
+    uint16_t crc16[256];
+    uint32_t crc32[256];
+
+    CrcTables()
+    {
+        for (uint32_t b = 0; b < 256; ++b) {
+            uint16_t c16 = static_cast<uint16_t>(b << 8);
+            uint32_t c32 = b;
+            for (int bit = 0; bit < 8; ++bit) {
+                c16 = (c16 & 0x8000) ? static_cast<uint16_t>((c16 << 1) ^ 0x1021)
+                                     : static_cast<uint16_t>(c16 << 1);
+                c32 = (c32 & 1u) ? (c32 >> 1) ^ 0xEDB88320u : (c32 >> 1);
+            }
+            crc16[b] = c16;
+            crc32[b] = c32;
+        }
+    }
+
+    uint16_t ref_crc16(const uint8_t* data, std::size_t len) const
+    {
+        uint16_t crc = 0xFFFF;
+        for (std::size_t i = 0; i < len; ++i) {
+            crc = static_cast<uint16_t>((crc << 8) ^ crc16[((crc >> 8) ^ data[i]) & 0xFF]);
+        }
+        return crc;
+    }
+
+    uint32_t ref_crc32(const uint8_t* data, std::size_t len) const
+    {
+        if (len == 0) {
+            return 0;
+        }
+        uint32_t crc = 0xFFFFFFFFu;
+        for (std::size_t i = 0; i < len; ++i) {
+            crc = (crc >> 8) ^ crc32[(crc ^ data[i]) & 0xFF];
+        }
+        return crc ^ 0xFFFFFFFFu;
+    }
+};
+
+static void check_crc()
+{
+    expect(compute_header_crc16(CHECK_INPUT, sizeof(CHECK_INPUT)) == CRC16_CHECK_VALUE,
+           "crc16 check value");
+    expect(compute_payload_crc32(CHECK_INPUT, sizeof(CHECK_INPUT)) == CRC32_CHECK_VALUE,
+           "crc32 check value");
+    expect(compute_payload_crc32(CHECK_INPUT, 0) == 0, "crc32 of an empty payload is 0");
+
+    const CrcTables tables;
+    uint8_t data[MAX_PAYLOAD_SIZE_BYTES];
+    uint32_t state = 0x5332u;
+    for (uint32_t round = 0; round < CRC_REFERENCE_ROUNDS; ++round) {
+        for (std::size_t i = 0; i < sizeof(data); ++i) {
+            state = state * 1664525u + 1013904223u;
+            data[i] = static_cast<uint8_t>(state >> 24);
+        }
+        for (std::size_t len = 0; len <= sizeof(data); ++len) {
+            if (compute_header_crc16(data, len) != tables.ref_crc16(data, len) ||
+                compute_payload_crc32(data, len) != tables.ref_crc32(data, len)) {
+                expect(false, "crc against the table reference");
+                return;
+            }
+        }
+    }
+
+    // The zeroed-field CRC must match copying the header and clearing it.
+    uint8_t header[HEADER_SIZE_BYTES];
+    for (uint32_t seed = 0; seed < 256; ++seed) {
+        for (std::size_t i = 0; i < sizeof(header); ++i) {
+            header[i] = static_cast<uint8_t>(seed * 31u + i * 7u);
+        }
+        uint8_t zeroed[HEADER_SIZE_BYTES];
+        std::memcpy(zeroed, header, sizeof(zeroed));
+        zeroed[OFFSET_HEADER_CRC16] = 0;
+        zeroed[OFFSET_HEADER_CRC16 + 1] = 0;
+        if (compute_header_crc16_zeroed(header) != compute_header_crc16(zeroed, sizeof(zeroed))) {
+            expect(false, "header crc16 with the field taken as zero");
+            return;
+        }
+    }
+}
+
+static void check_roundtrip()
+{
+    uint8_t payload[MAX_PAYLOAD_SIZE_BYTES];
+    for (std::size_t i = 0; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>(i * 13u + 5u);
+    }
+    uint8_t frame[MAX_FRAME_BUFFER_SIZE];
+
+    for (std::size_t payload_len = 0; payload_len <= MAX_PAYLOAD_SIZE_BYTES; ++payload_len) {
+        PacketHeader fields{};
+        fields.msg_type = static_cast<uint8_t>(payload_len);
+        fields.flags = static_cast<uint8_t>(payload_len >> 3);
+        fields.src = NODE_ID_BRAIN;
+        fields.dst = NODE_ID_SPINE;
+        fields.seq = static_cast<uint16_t>(payload_len * 257u);
+
+        std::size_t frame_len = 0;
+        if (encode_packet(&fields, payload, payload_len, frame, sizeof(frame), &frame_len) !=
+                EncodeStatus::OK ||
+            frame_len != HEADER_SIZE_BYTES + payload_len + TRAILER_SIZE_BYTES) {
+            expect(false, "encode_packet");
+            return;
+        }
+        if (validate_packet(frame, frame_len) != PacketStatus::OK) {
+            expect(false, "validate_packet on an encoded frame");
+            return;
+        }
+
+        PacketHeader hdr{};
+        if (parse_and_validate_header(frame, frame_len, &hdr) != HeaderStatus::OK ||
+            hdr.magic != PROTO_MAGIC || hdr.proto_major != PROTO_VERSION_MAJOR ||
+            hdr.proto_minor != PROTO_VERSION_MINOR || hdr.msg_type != fields.msg_type ||
+            hdr.flags != fields.flags || hdr.src != fields.src || hdr.dst != fields.dst ||
+            hdr.seq != fields.seq || hdr.payload_len != payload_len) {
+            expect(false, "parse_and_validate_header fields");
+            return;
+        }
+
+        // Both CRCs detect every single-bit error in what they cover.
+        for (std::size_t bit = 0; bit < frame_len * 8; ++bit) {
+            frame[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+            const bool rejected = validate_packet(frame, frame_len) != PacketStatus::OK;
+            frame[bit / 8] ^= static_cast<uint8_t>(1u << (bit % 8));
+            if (!rejected) {
+                expect(false, "single-bit error detected");
+                return;
+            }
+        }
+    }
+}
+
+struct FrameCounts {
+    uint32_t found = 0;
+    uint32_t valid = 0;
+    uint64_t valid_bytes = 0;
+};
+
+static void count_frame(const uint8_t* frame_buf, std::size_t frame_len, void* ctx)
+{
+    FrameCounts* counts = static_cast<FrameCounts*>(ctx);
+    counts->found++;
+    if (validate_packet(frame_buf, frame_len) == PacketStatus::OK) {
+        counts->valid++;
+        counts->valid_bytes += frame_len;
+    }
+}
+
+static FrameCounts push_stream(const std::vector<uint8_t>& stream, std::size_t chunk)
+{
+    ByteStreamFramer framer;
+    bs_framer_init(&framer);
+    FrameCounts counts;
+    const std::size_t step = (chunk == 0) ? stream.size() : chunk;
+    for (std::size_t off = 0; off < stream.size(); off += step) {
+        const std::size_t n = (stream.size() - off < step) ? stream.size() - off : step;
+        bs_framer_push(&framer, stream.data() + off, n, count_frame, &counts);
+    }
+    return counts;
+}
+
+static bool check_resync(const char* path, std::size_t chunk, uint32_t min_valid)
+{
+    std::FILE* in = std::fopen(path, "rb");
+    if (!in) {
+        std::perror(path);
+        return false;
+    }
+    std::vector<uint8_t> stream;
+    uint8_t buf[4096];
+    std::size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), in)) > 0) {
+        stream.insert(stream.end(), buf, buf + n);
+    }
+    std::fclose(in);
+
+    const FrameCounts reference = push_stream(stream, 1);
+    const FrameCounts counts = push_stream(stream, chunk);
+    std::printf("protocol.check.resync.chunk=%zu protocol.check.resync.frames_found=%u "
+                "protocol.check.resync.valid=%u protocol.check.resync.reference_valid=%u\n",
+                chunk, counts.found, counts.valid, reference.valid);
+
+    expect(reference.valid >= min_valid, "byte-by-byte push finds --min-valid frames");
+    expect(counts.found == reference.found && counts.valid == reference.valid &&
+               counts.valid_bytes == reference.valid_bytes,
+           "chunked push finds the same frames as byte-by-byte");
+    return true;
+}
+
+static void print_usage(const char* argv0)
+{
+    std::fprintf(stderr,
+                 "usage: %s crc | roundtrip | resync STREAM_FILE [--chunk N] [--min-valid N]\n",
+                 argv0);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    const char* name = argv[1];
+    if (std::strcmp(name, "crc") == 0 && argc == 2) {
+        check_crc();
+    } else if (std::strcmp(name, "roundtrip") == 0 && argc == 2) {
+        check_roundtrip();
+    } else if (std::strcmp(name, "resync") == 0 && argc >= 3) {
+        std::size_t chunk = 1;
+        uint32_t min_valid = 1;
+        for (int i = 3; i < argc; ++i) {
+            if (std::strcmp(argv[i], "--chunk") == 0 && i + 1 < argc) {
+                chunk = static_cast<std::size_t>(std::strtoul(argv[++i], nullptr, 10));
+            } else if (std::strcmp(argv[i], "--min-valid") == 0 && i + 1 < argc) {
+                min_valid = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            } else {
+                print_usage(argv[0]);
+                return 2;
+            }
+        }
+        if (!check_resync(argv[2], chunk, min_valid)) {
+            return 2;
+        }
+    } else {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    std::printf("protocol.check.%s=%s\n", name, (g_failures == 0) ? "pass" : "fail");
+    return (g_failures == 0) ? 0 : 1;
+}
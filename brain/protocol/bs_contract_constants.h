@@ -103,6 +103,12 @@ namespace protocol {
     static constexpr uint8_t MSG_ID_S2B_ACK          = 0x83;
     static constexpr uint8_t MSG_ID_S2B_FAULT        = 0x84;
 
+    // Diagnostic extensions (provisional; not part of Contract v0.2).
+    // Taken from the top of each range so contract additions never collide.
+    static constexpr uint8_t MSG_ID_B2S_EVENT_LOG_REQUEST = 0x2F;
+    static constexpr uint8_t MSG_ID_S2B_EVENT_LOG         = 0x9F;
+    static constexpr uint8_t MSG_ID_S2B_LOG               = 0x9E;
+
     // ==========================================================================
     // 6. SPINE STATE ENUM VALUES (Normative)
     // ==========================================================================
@@ -38,18 +38,37 @@ uint16_t compute_header_crc16(const uint8_t* data, std::size_t len)
     for (std::size_t i = 0; i < len; ++i) {
         crc ^= static_cast<uint16_t>(data[i]) << 8;
 
+        // Branch-free bit step: the top bit is data-dependent, so a branch
+        // here mispredicts half the time (PGO builds keep it as a branch).
         for (int bit = 0; bit < 8; ++bit) {
-            if (crc & 0x8000) {
-                crc = (crc << 1) ^ 0x1021;
-            } else {
-                crc <<= 1;
-            }
+            crc = static_cast<uint16_t>((crc << 1) ^ (0x1021u & (0u - (crc >> 15))));
         }
     }
 
     return crc;
 }
 
+/**
+ * CRC16 of a full header as the contract defines it: bytes up to the CRC
+ * field, then the CRC field taken as zero. Same value as copying the header
+ * and zeroing the field, without the copy. `header` must hold
+ * HEADER_SIZE_BYTES.
+ */
+uint16_t compute_header_crc16_zeroed(const uint8_t* header)
+{
+    static_assert(OFFSET_HEADER_CRC16 + 2 == HEADER_SIZE_BYTES,
+                  "header CRC16 must be the last header field");
+
+    uint16_t crc = compute_header_crc16(header, OFFSET_HEADER_CRC16);
+
+    // Two zero bytes: the xor-in is a no-op, only the shifts remain.
+    for (int bit = 0; bit < 16; ++bit) {
+        crc = static_cast<uint16_t>((crc << 1) ^ (0x1021u & (0u - (crc >> 15))));
+    }
+
+    return crc;
+}
+
 /**
  * Compute CRC-32/ISO-HDLC over the packet payload.
  *
@@ -80,12 +99,9 @@ uint32_t compute_payload_crc32(const uint8_t* data, std::size_t len)
     for (std::size_t i = 0; i < len; ++i) {
         crc ^= static_cast<uint32_t>(data[i]);
 
+        // Branch-free bit step (see compute_header_crc16).
         for (int bit = 0; bit < 8; ++bit) {
-            if (crc & 1) {
-                crc = (crc >> 1) ^ POLY_REVERSED;
-            } else {
-                crc >>= 1;
-            }
+            crc = (crc >> 1) ^ (POLY_REVERSED & (0u - (crc & 1u)));
         }
     }
 
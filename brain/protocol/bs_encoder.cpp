@@ -0,0 +1,101 @@
+/**
+ * @file bs_encoder.cpp
+ * @brief Brain-side packet encoding for Brain <-> Spine protocol v0.2
+ *
+ * Serializes one contiguous packet (header + payload + trailer) into a
+ * caller-owned buffer:
+ * 1) Fixed header with explicit little-endian field writes
+ * 2) Header CRC16 computed with the CRC field treated as zero
+ * 3) Payload copied verbatim
+ * 4) Trailer CRC32 over the payload (0 when payload is empty)
+ *
+ * No framing, no buffering, no I/O, no timing.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "bs_protocol.h"
+
+namespace s2t {
+namespace protocol {
+
+// Forward declarations (implemented in bs_crc.cpp)
+uint16_t compute_header_crc16(const uint8_t* data, std::size_t len);
+uint32_t compute_payload_crc32(const uint8_t* data, std::size_t len);
+
+// Explicit little-endian writes (wire format).
+static inline void write_u16_le(uint8_t* p, uint16_t v)
+{
+    p[0] = static_cast<uint8_t>(v & 0xFF);
+    p[1] = static_cast<uint8_t>((v >> 8) & 0xFF);
+}
+
+static inline void write_u32_le(uint8_t* p, uint32_t v)
+{
+    p[0] = static_cast<uint8_t>(v & 0xFF);
+    p[1] = static_cast<uint8_t>((v >> 8) & 0xFF);
+    p[2] = static_cast<uint8_t>((v >> 16) & 0xFF);
+    p[3] = static_cast<uint8_t>((v >> 24) & 0xFF);
+}
+
+/**
+ * Encode one packet.
+ *
+ * Only msg_type, flags, src, dst and seq are taken from `fields`.
+ * magic, version, payload_len and both CRCs are derived here so a caller
+ * cannot produce a packet that disagrees with the contract constants.
+ */
+EncodeStatus encode_packet(const PacketHeader* fields,
+                           const uint8_t* payload,
+                           std::size_t payload_len,
+                           uint8_t* out,
+                           std::size_t out_cap,
+                           std::size_t* out_len)
+{
+    if (!fields || !out || !out_len) {
+        return EncodeStatus::ERR_INVALID_ARGS;
+    }
+    if (!payload && payload_len > 0) {
+        return EncodeStatus::ERR_INVALID_ARGS;
+    }
+    if (payload_len > MAX_PAYLOAD_SIZE_BYTES) {
+        return EncodeStatus::ERR_PAYLOAD_TOO_LARGE;
+    }
+
+    const std::size_t total_len =
+        HEADER_SIZE_BYTES + payload_len + TRAILER_SIZE_BYTES;
+    if (out_cap < total_len) {
+        return EncodeStatus::ERR_BUFFER_TOO_SMALL;
+    }
+
+    write_u16_le(&out[OFFSET_MAGIC], PROTO_MAGIC);
+    out[OFFSET_PROTO_MAJOR] = PROTO_VERSION_MAJOR;
+    out[OFFSET_PROTO_MINOR] = PROTO_VERSION_MINOR;
+    out[OFFSET_MSG_TYPE]    = fields->msg_type;
+    out[OFFSET_FLAGS]       = fields->flags;
+    out[OFFSET_SRC]         = fields->src;
+    out[OFFSET_DST]         = fields->dst;
+    write_u16_le(&out[OFFSET_SEQ], fields->seq);
+    write_u16_le(&out[OFFSET_PAYLOAD_LEN], static_cast<uint16_t>(payload_len));
+    write_u16_le(&out[OFFSET_HEADER_CRC16], 0);
+
+    const uint16_t header_crc = compute_header_crc16(out, HEADER_SIZE_BYTES);
+    write_u16_le(&out[OFFSET_HEADER_CRC16], header_crc);
+
+    uint8_t* payload_ptr = out + HEADER_SIZE_BYTES;
+    if (payload_len > 0) {
+        std::memcpy(payload_ptr, payload, payload_len);
+    }
+
+    // compute_payload_crc32 already returns 0 for an empty payload.
+    const uint32_t payload_crc = compute_payload_crc32(payload_ptr, payload_len);
+    write_u32_le(payload_ptr + payload_len + TRAILER_OFFSET_CRC32, payload_crc);
+
+    *out_len = total_len;
+    return EncodeStatus::OK;
+}
+
+} // namespace protocol
+} // namespace s2t
@@ -13,31 +13,11 @@
 #include <cstddef>
 #include <cstring>
 
-#include "bs_contract_constants.h"
+#include "bs_protocol.h"
 
 namespace s2t {
 namespace protocol {
 
-// Forward declarations from Chunk C.
-// We intentionally do NOT duplicate these types/values here.
-struct PacketHeader;
-enum class HeaderStatus;
-HeaderStatus parse_and_validate_header(const uint8_t* buf, std::size_t len, PacketHeader* out);
-
-static constexpr std::size_t MAX_FRAME_BUFFER_SIZE =
-    HEADER_SIZE_BYTES + MAX_PAYLOAD_SIZE_BYTES + TRAILER_SIZE_BYTES;
-
-typedef void (*FrameCallback)(const uint8_t* frame_buf, std::size_t frame_len, void* ctx);
-
-struct ByteStreamFramer {
-    uint8_t buffer[MAX_FRAME_BUFFER_SIZE];
-    std::size_t write_idx = 0;
-
-    // Observability counters (purely internal state; no I/O here)
-    uint32_t sync_loss_count = 0;
-    uint32_t frames_found_count = 0;
-};
-
 static inline void discard_one(ByteStreamFramer* framer)
 {
     if (framer->write_idx == 0) {
@@ -80,11 +60,9 @@ void bs_framer_push(ByteStreamFramer* framer,
             framer->buffer[framer->write_idx++] = data[in_idx++];
         }
 
-        // If buffer is full and we still have more input, discard until space.
-        // This is deterministic and preserves resync behavior under overload.
-        while (in_idx < len && framer->write_idx == MAX_FRAME_BUFFER_SIZE) {
-            discard_one(framer);
-        }
+        // A full buffer always makes progress below: it holds at least one
+        // complete frame, or its first bytes are discarded as noise. Space
+        // is never made by dropping bytes that might start a valid frame.
 
         // We need at least 2 bytes to check magic.
         if (framer->write_idx < 2) {
@@ -0,0 +1,80 @@
+/**
+ * @file bs_harness_tool.cpp
+ * @brief Brain-side CLI over run_protocol_harness(): frame and validate a
+ * captured byte stream and print the counts.
+ *
+ * Usage:
+ *   bs_harness_tool [capture-file | -]
+ *
+ * Reads the whole capture (stdin when omitted or "-"). Exit status is 0
+ * when every extracted frame validated, 1 otherwise, 2 on usage or I/O
+ * errors. The tool never opens the link; it only reads bytes.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "bs_tool.h"
+
+using namespace s2t::protocol;
+
+static constexpr std::size_t READ_CHUNK_BYTES = 4096;
+
+static void print_usage(const char* argv0)
+{
+    std::fprintf(stderr, "usage: %s [capture-file | -]\n", argv0);
+}
+
+static bool read_all(std::FILE* in, std::vector<uint8_t>* out)
+{
+    uint8_t chunk[READ_CHUNK_BYTES];
+    while (true) {
+        const std::size_t n = std::fread(chunk, 1, sizeof(chunk), in);
+        out->insert(out->end(), chunk, chunk + n);
+        if (n < sizeof(chunk)) {
+            return std::ferror(in) == 0;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 2) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    const bool use_stdin = (argc < 2) || (std::strcmp(argv[1], "-") == 0);
+    std::FILE* in = use_stdin ? stdin : std::fopen(argv[1], "rb");
+    if (!in) {
+        std::perror(argv[1]);
+        return 2;
+    }
+
+    std::vector<uint8_t> capture;
+    const bool read_ok = read_all(in, &capture);
+    if (!use_stdin) {
+        std::fclose(in);
+    }
+    if (!read_ok) {
+        std::fprintf(stderr, "read error\n");
+        return 2;
+    }
+
+    const ProtocolTestStats stats = run_protocol_harness(capture.data(), capture.size());
+
+    std::printf("protocol.harness.input_bytes=%llu "
+                "protocol.harness.frames_extracted=%u "
+                "protocol.harness.packets_valid=%u "
+                "protocol.harness.packets_invalid=%u "
+                "protocol.harness.sync_losses=%u\n",
+                static_cast<unsigned long long>(capture.size()),
+                stats.frames_extracted,
+                stats.packets_valid,
+                stats.packets_invalid,
+                stats.sync_losses);
+
+    return (stats.packets_invalid == 0) ? 0 : 1;
+}
@@ -9,40 +9,13 @@
 #include <cstdint>
 #include <cstddef>
 
-#include "bs_contract_constants.h"
+#include "bs_protocol.h"
 
 namespace s2t {
 namespace protocol {
 
 // Forward declaration (implemented in bs_crc.cpp)
-uint16_t compute_header_crc16(const uint8_t* data, std::size_t len);
-
-/**
- * Parsed header fields (host-side representation).
- * NOTE: This is NOT a wire struct; fields are explicitly decoded from bytes.
- */
-struct PacketHeader {
-    uint16_t magic;
-    uint8_t  proto_major;
-    uint8_t  proto_minor;
-    uint8_t  msg_type;
-    uint8_t  flags;
-    uint8_t  src;
-    uint8_t  dst;
-    uint16_t seq;
-    uint16_t payload_len;
-    uint16_t header_crc16;
-};
-
-enum class HeaderStatus {
-    OK = 0,
-    ERR_INVALID_ARGS,
-    ERR_BUFFER_TOO_SMALL,
-    ERR_MAGIC_MISMATCH,
-    ERR_VERSION_MISMATCH,
-    ERR_PAYLOAD_TOO_LARGE,
-    ERR_CRC_MISMATCH
-};
+uint16_t compute_header_crc16_zeroed(const uint8_t* header);
 
 // Explicit little-endian reads (wire format).
 static inline uint16_t read_u16_le(const uint8_t* p)
@@ -51,16 +24,54 @@ static inline uint16_t read_u16_le(const uint8_t* p)
                                  (static_cast<uint16_t>(p[1]) << 8));
 }
 
+static inline uint32_t read_u32_le(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) |
+           (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Magic, major and minor as they appear in the first four header bytes.
+static_assert(OFFSET_MAGIC == 0 && OFFSET_PROTO_MAJOR == 2 && OFFSET_PROTO_MINOR == 3,
+              "header prefix layout");
+static constexpr uint32_t HEADER_PREFIX_LE =
+    static_cast<uint32_t>(PROTO_MAGIC) |
+    (static_cast<uint32_t>(PROTO_VERSION_MAJOR) << 16) |
+    (static_cast<uint32_t>(PROTO_VERSION_MINOR) << 24);
+
+/**
+ * Decode the fixed header fields without validating them.
+ * `buf` must hold HEADER_SIZE_BYTES.
+ */
+void decode_header_fields(const uint8_t* buf, PacketHeader* out)
+{
+    out->magic        = read_u16_le(&buf[OFFSET_MAGIC]);
+    out->proto_major  = buf[OFFSET_PROTO_MAJOR];
+    out->proto_minor  = buf[OFFSET_PROTO_MINOR];
+    out->msg_type     = buf[OFFSET_MSG_TYPE];
+    out->flags        = buf[OFFSET_FLAGS];
+    out->src          = buf[OFFSET_SRC];
+    out->dst          = buf[OFFSET_DST];
+    out->seq          = read_u16_le(&buf[OFFSET_SEQ]);
+    out->payload_len  = read_u16_le(&buf[OFFSET_PAYLOAD_LEN]);
+    out->header_crc16 = read_u16_le(&buf[OFFSET_HEADER_CRC16]);
+}
+
 /**
  * Parse and validate the fixed packet header.
  *
  * Validation steps:
  * 1) Args / length
- * 2) Decode fields (explicit LE for u16 fields)
- * 3) Magic check
- * 4) Version check (exact match)
- * 5) Payload length safety cap
- * 6) Header CRC16 check (CRC field treated as zero during computation)
+ * 2) Magic + version as one 32-bit LE compare (exact match); the magic
+ *    half decides which error is reported
+ * 3) Payload length safety cap
+ * 4) Header CRC16 check (CRC field treated as zero during computation)
+ * 5) Decode fields (explicit LE for u16 fields)
+ *
+ * `*out` is written only on OK; use decode_header_fields for the raw
+ * fields of a rejected header. The framer calls this at every candidate
+ * offset while resyncing, so rejects are kept cheap.
  */
 HeaderStatus parse_and_validate_header(const uint8_t* buf,
                                       std::size_t len,
@@ -76,43 +87,22 @@ HeaderStatus parse_and_validate_header(const uint8_t* buf,
         return HeaderStatus::ERR_BUFFER_TOO_SMALL;
     }
 
-    out->magic        = read_u16_le(&buf[OFFSET_MAGIC]);
-    out->proto_major  = buf[OFFSET_PROTO_MAJOR];
-    out->proto_minor  = buf[OFFSET_PROTO_MINOR];
-    out->msg_type     = buf[OFFSET_MSG_TYPE];
-    out->flags        = buf[OFFSET_FLAGS];
-    out->src          = buf[OFFSET_SRC];
-    out->dst          = buf[OFFSET_DST];
-    out->seq          = read_u16_le(&buf[OFFSET_SEQ]);
-    out->payload_len  = read_u16_le(&buf[OFFSET_PAYLOAD_LEN]);
-    out->header_crc16 = read_u16_le(&buf[OFFSET_HEADER_CRC16]);
-
-    if (out->magic != PROTO_MAGIC) {
-        return HeaderStatus::ERR_MAGIC_MISMATCH;
-    }
-
     // Version handling: exact match unless canon explicitly allows ranges.
-    if (out->proto_major != PROTO_VERSION_MAJOR ||
-        out->proto_minor != PROTO_VERSION_MINOR) {
-        return HeaderStatus::ERR_VERSION_MISMATCH;
+    const uint32_t prefix = read_u32_le(&buf[OFFSET_MAGIC]);
+    if (prefix != HEADER_PREFIX_LE) {
+        return ((prefix & 0xFFFFu) != PROTO_MAGIC) ? HeaderStatus::ERR_MAGIC_MISMATCH
+                                                   : HeaderStatus::ERR_VERSION_MISMATCH;
     }
 
-    if (out->payload_len > MAX_PAYLOAD_SIZE_BYTES) {
+    if (read_u16_le(&buf[OFFSET_PAYLOAD_LEN]) > MAX_PAYLOAD_SIZE_BYTES) {
         return HeaderStatus::ERR_PAYLOAD_TOO_LARGE;
     }
 
-    uint8_t scratch[HEADER_SIZE_BYTES];
-    for (std::size_t i = 0; i < HEADER_SIZE_BYTES; ++i) {
-        scratch[i] = buf[i];
-    }
-    scratch[OFFSET_HEADER_CRC16]     = 0;
-    scratch[OFFSET_HEADER_CRC16 + 1] = 0;
-
-    const uint16_t computed = compute_header_crc16(scratch, HEADER_SIZE_BYTES);
-    if (computed != out->header_crc16) {
+    if (compute_header_crc16_zeroed(buf) != read_u16_le(&buf[OFFSET_HEADER_CRC16])) {
         return HeaderStatus::ERR_CRC_MISMATCH;
     }
 
+    decode_header_fields(buf, out);
     return HeaderStatus::OK;
 }
 
@@ -14,27 +14,14 @@
 #include <cstddef>
 #include <limits>
 
-#include "bs_contract_constants.h"
+#include "bs_protocol.h"
 
 namespace s2t {
 namespace protocol {
 
-// Forward declarations from earlier chunks.
-// NOTE: We intentionally avoid duplicating wire/type definitions here.
-struct PacketHeader;
-enum class HeaderStatus;
-HeaderStatus parse_and_validate_header(const uint8_t* buf, std::size_t len, PacketHeader* out);
-
+// Forward declaration (implemented in bs_crc.cpp)
 uint32_t compute_payload_crc32(const uint8_t* data, std::size_t len);
 
-enum class PacketStatus {
-    OK = 0,
-    ERR_INVALID_ARGS,
-    ERR_HEADER_INVALID,
-    ERR_LENGTH_MISMATCH,
-    ERR_PAYLOAD_CRC_MISMATCH
-};
-
 static inline uint32_t read_u32_le(const uint8_t* p)
 {
     return static_cast<uint32_t>(static_cast<uint32_t>(p[0]) |
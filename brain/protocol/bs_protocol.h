@@ -47,6 +47,13 @@ enum class PacketStatus {
     ERR_PAYLOAD_CRC_MISMATCH
 };
 
+enum class EncodeStatus {
+    OK = 0,
+    ERR_INVALID_ARGS,
+    ERR_PAYLOAD_TOO_LARGE,
+    ERR_BUFFER_TOO_SMALL
+};
+
 struct ByteStreamFramer {
     uint8_t  buffer[MAX_FRAME_BUFFER_SIZE];
     std::size_t write_idx;
@@ -62,12 +69,29 @@ typedef void (*FrameCallback)(const uint8_t* frame_buf,
 // PUBLIC INTERFACE
 // ==========================================================================
 
+/**
+ * Validate the fixed header at `buf` and, only if it is OK, decode it
+ * into `*out`. On any other status `*out` is left unchanged.
+ */
 HeaderStatus parse_and_validate_header(const uint8_t* buf,
                                       std::size_t len,
                                       PacketHeader* out);
 
+/**
+ * Decode the fixed header fields without validating them, e.g. to show
+ * what a rejected header carried. `buf` must hold HEADER_SIZE_BYTES.
+ */
+void decode_header_fields(const uint8_t* buf, PacketHeader* out);
+
 PacketStatus validate_packet(const uint8_t* buf, std::size_t len);
 
+EncodeStatus encode_packet(const PacketHeader* fields,
+                           const uint8_t* payload,
+                           std::size_t payload_len,
+                           uint8_t* out,
+                           std::size_t out_cap,
+                           std::size_t* out_len);
+
 void bs_framer_init(ByteStreamFramer* framer);
 
 void bs_framer_push(ByteStreamFramer* framer,
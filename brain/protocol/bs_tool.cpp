@@ -2,17 +2,11 @@
 #include <cstddef>
 
 #include "bs_protocol.h"
+#include "bs_tool.h"
 
 namespace s2t {
 namespace protocol {
 
-struct ProtocolTestStats {
-    uint32_t frames_extracted = 0;
-    uint32_t packets_valid    = 0;
-    uint32_t packets_invalid  = 0;
-    uint32_t sync_losses      = 0;
-};
-
 struct ToolContext {
     ProtocolTestStats* stats = nullptr;
 };
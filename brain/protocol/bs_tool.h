@@ -0,0 +1,31 @@
+#ifndef BS_TOOL_H
+#define BS_TOOL_H
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @file bs_tool.h
+ * @brief Offline protocol harness: run a captured byte stream through the
+ * framer and validator and count the outcome.
+ *
+ * No I/O, no timing. Callers own the input buffer.
+ */
+
+namespace s2t {
+namespace protocol {
+
+struct ProtocolTestStats {
+    uint32_t frames_extracted = 0;
+    uint32_t packets_valid    = 0;
+    uint32_t packets_invalid  = 0;
+    uint32_t sync_losses      = 0;
+};
+
+ProtocolTestStats run_protocol_harness(const uint8_t* input_data,
+                                       std::size_t input_len);
+
+} // namespace protocol
+} // namespace s2t
+
+#endif // BS_TOOL_H
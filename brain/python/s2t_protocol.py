@@ -0,0 +1,323 @@
+"""
+s2t_protocol: Python binding for the Brain protocol core (Contract v0.2).
+
+Loads libs2t_protocol through ctypes and exposes the C ABI in
+brain/protocol/bs_c_api.h. CRCs, header/packet validation, encoding and
+stream framing all run in the C++ core; nothing is re-implemented here.
+
+Decoded frames come back in batches:
+  batch.records   one 16-byte record per frame (FRAME_DTYPE layout)
+  batch.payloads  all payload bytes of the batch, back to back
+Both support the buffer protocol, so numpy users can do
+  records = numpy.frombuffer(batch.records, dtype=numpy.dtype(FRAME_DTYPE))
+without a copy. numpy is not required.
+
+Library lookup: $S2T_PROTOCOL_LIB, then brain/build/<preset>/, then the
+system loader path.
+
+Usage as a tool:
+  python3 s2t_protocol.py <capture-file>
+"""
+
+import ctypes
+import glob
+import os
+import sys
+from typing import Iterator, List, NamedTuple, Optional
+
+ABI_VERSION = 1
+
+PACKET_OK = 0
+PACKET_ERR_INVALID_ARGS = 1
+PACKET_ERR_HEADER_INVALID = 2
+PACKET_ERR_LENGTH_MISMATCH = 3
+PACKET_ERR_PAYLOAD_CRC = 4
+
+ENCODE_OK = 0
+
+BATCH_MIN_RECORDS = 16
+BATCH_MIN_ARENA = 274
+
+DEFAULT_BATCH_RECORDS = 1024
+DEFAULT_BATCH_ARENA = 64 * 1024
+
+# numpy structured dtype description of s2t_frame_record_t (16 bytes).
+FRAME_DTYPE = [
+    ("payload_offset", "<u4"),
+    ("payload_len", "<u2"),
+    ("seq", "<u2"),
+    ("msg_type", "u1"),
+    ("flags", "u1"),
+    ("src", "u1"),
+    ("dst", "u1"),
+    ("status", "u1"),
+    ("reserved", "u1", (3,)),
+]
+
+
+class _Header(ctypes.Structure):
+    _fields_ = [
+        ("magic", ctypes.c_uint16),
+        ("proto_major", ctypes.c_uint8),
+        ("proto_minor", ctypes.c_uint8),
+        ("msg_type", ctypes.c_uint8),
+        ("flags", ctypes.c_uint8),
+        ("src", ctypes.c_uint8),
+        ("dst", ctypes.c_uint8),
+        ("seq", ctypes.c_uint16),
+        ("payload_len", ctypes.c_uint16),
+        ("header_crc16", ctypes.c_uint16),
+        ("reserved", ctypes.c_uint16),
+    ]
+
+
+class _FrameRecord(ctypes.Structure):
+    _fields_ = [
+        ("payload_offset", ctypes.c_uint32),
+        ("payload_len", ctypes.c_uint16),
+        ("seq", ctypes.c_uint16),
+        ("msg_type", ctypes.c_uint8),
+        ("flags", ctypes.c_uint8),
+        ("src", ctypes.c_uint8),
+        ("dst", ctypes.c_uint8),
+        ("status", ctypes.c_uint8),
+        ("reserved", ctypes.c_uint8 * 3),
+    ]
+
+
+class _FramerStats(ctypes.Structure):
+    _fields_ = [
+        ("bytes_in", ctypes.c_uint64),
+        ("frames_found", ctypes.c_uint32),
+        ("frames_valid", ctypes.c_uint32),
+        ("frames_invalid", ctypes.c_uint32),
+        ("sync_losses", ctypes.c_uint32),
+    ]
+
+
+class ProtocolError(RuntimeError):
+    pass
+
+
+class Frame(NamedTuple):
+    msg_type: int
+    flags: int
+    src: int
+    dst: int
+    seq: int
+    status: int
+    payload: bytes
+
+    @property
+    def valid(self) -> bool:
+        return self.status == PACKET_OK
+
+
+class FramerStats(NamedTuple):
+    bytes_in: int
+    frames_found: int
+    frames_valid: int
+    frames_invalid: int
+    sync_losses: int
+
+
+def _candidate_paths() -> List[str]:
+    paths = []
+    env = os.environ.get("S2T_PROTOCOL_LIB")
+    if env:
+        paths.append(env)
+    brain_dir = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    paths.extend(sorted(glob.glob(os.path.join(brain_dir, "build", "*", "libs2t_protocol.so"))))
+    paths.append("libs2t_protocol.so")
+    return paths
+
+
+def _load() -> ctypes.CDLL:
+    errors = []
+    for path in _candidate_paths():
+        try:
+            lib = ctypes.CDLL(path)
+        except OSError as e:
+            errors.append(f"{path}: {e}")
+            continue
+        if hasattr(lib, "s2t_abi_version"):
+            break
+        errors.append(f"{path}: no C ABI (older build)")
+    else:
+        raise ProtocolError("libs2t_protocol not found:\n  " + "\n  ".join(errors))
+
+    u8p = ctypes.POINTER(ctypes.c_uint8)
+    size = ctypes.c_size_t
+
+    lib.s2t_abi_version.restype = ctypes.c_uint32
+    lib.s2t_header_size.restype = size
+    lib.s2t_trailer_size.restype = size
+    lib.s2t_max_payload_size.restype = size
+    lib.s2t_crc16_ccitt_false.argtypes = [ctypes.c_char_p, size]
+    lib.s2t_crc16_ccitt_false.restype = ctypes.c_uint16
+    lib.s2t_crc32_iso_hdlc.argtypes = [ctypes.c_char_p, size]
+    lib.s2t_crc32_iso_hdlc.restype = ctypes.c_uint32
+    lib.s2t_parse_header.argtypes = [ctypes.c_char_p, size, ctypes.POINTER(_Header)]
+    lib.s2t_parse_header.restype = ctypes.c_int
+    lib.s2t_validate_packet.argtypes = [ctypes.c_char_p, size]
+    lib.s2t_validate_packet.restype = ctypes.c_int
+    lib.s2t_encode_packet.argtypes = [ctypes.POINTER(_Header), ctypes.c_char_p, size,
+                                      u8p, size, ctypes.POINTER(size)]
+    lib.s2t_encode_packet.restype = ctypes.c_int
+    lib.s2t_framer_create.restype = ctypes.c_void_p
+    lib.s2t_framer_destroy.argtypes = [ctypes.c_void_p]
+    lib.s2t_framer_reset.argtypes = [ctypes.c_void_p]
+    lib.s2t_framer_get_stats.argtypes = [ctypes.c_void_p, ctypes.POINTER(_FramerStats)]
+    # Input as an address so Framer.push can walk one buffer by offset.
+    lib.s2t_framer_push_batch.argtypes = [ctypes.c_void_p, ctypes.c_void_p, size,
+                                          ctypes.POINTER(_FrameRecord), size,
+                                          u8p, size, ctypes.POINTER(size)]
+    lib.s2t_framer_push_batch.restype = size
+
+    if lib.s2t_abi_version() != ABI_VERSION:
+        raise ProtocolError(f"libs2t_protocol ABI {lib.s2t_abi_version()}, "
+                            f"binding expects {ABI_VERSION}")
+    return lib
+
+
+_lib = _load()
+
+HEADER_SIZE = _lib.s2t_header_size()
+TRAILER_SIZE = _lib.s2t_trailer_size()
+MAX_PAYLOAD_SIZE = _lib.s2t_max_payload_size()
+
+
+def crc16(data: bytes) -> int:
+    return _lib.s2t_crc16_ccitt_false(data, len(data))
+
+
+def crc32(data: bytes) -> int:
+    return _lib.s2t_crc32_iso_hdlc(data, len(data))
+
+
+def validate(packet: bytes) -> int:
+    """S2T PACKET_* status of one complete packet."""
+    return _lib.s2t_validate_packet(packet, len(packet))
+
+
+def encode(msg_type: int, payload: bytes = b"", seq: int = 0,
+           src: int = 0x00, dst: int = 0x01, flags: int = 0) -> bytes:
+    """One wire packet; defaults are Brain -> Spine."""
+    fields = _Header(msg_type=msg_type, flags=flags, src=src, dst=dst, seq=seq & 0xFFFF)
+    out = (ctypes.c_uint8 * (HEADER_SIZE + len(payload) + TRAILER_SIZE))()
+    out_len = ctypes.c_size_t(0)
+    st = _lib.s2t_encode_packet(ctypes.byref(fields), payload, len(payload),
+                                out, len(out), ctypes.byref(out_len))
+    if st != ENCODE_OK:
+        raise ProtocolError(f"encode failed: status {st}")
+    return bytes(out[:out_len.value])
+
+
+class FrameBatch:
+    """Frames completed by one push_batch call. Owns its buffers."""
+
+    def __init__(self, records, count: int, arena, arena_used: int):
+        self._records = records
+        self._arena = arena
+        self.count = count
+        self.records = memoryview(records).cast("B")[:count * ctypes.sizeof(_FrameRecord)]
+        self.payloads = memoryview(arena)[:arena_used]
+
+    def __len__(self) -> int:
+        return self.count
+
+    def __iter__(self) -> Iterator[Frame]:
+        for i in range(self.count):
+            r = self._records[i]
+            start = r.payload_offset
+            yield Frame(r.msg_type, r.flags, r.src, r.dst, r.seq, r.status,
+                        bytes(self.payloads[start:start + r.payload_len]))
+
+
+class Framer:
+    """Stream framer over the C++ core. Not thread-safe; one per stream."""
+
+    def __init__(self, batch_records: int = DEFAULT_BATCH_RECORDS,
+                 batch_arena: int = DEFAULT_BATCH_ARENA):
+        if batch_records < BATCH_MIN_RECORDS or batch_arena < BATCH_MIN_ARENA:
+            raise ValueError(f"batch needs >= {BATCH_MIN_RECORDS} records "
+                             f"and >= {BATCH_MIN_ARENA} arena bytes")
+        self._batch_records = batch_records
+        self._batch_arena = batch_arena
+        self._handle = _lib.s2t_framer_create()
+        if not self._handle:
+            raise MemoryError("s2t_framer_create")
+
+    def close(self) -> None:
+        if self._handle:
+            _lib.s2t_framer_destroy(self._handle)
+            self._handle = None
+
+    def __enter__(self) -> "Framer":
+        return self
+
+    def __exit__(self, *exc) -> None:
+        self.close()
+
+    def __del__(self) -> None:
+        self.close()
+
+    def reset(self) -> None:
+        _lib.s2t_framer_reset(self._handle)
+
+    def push(self, data: bytes) -> List[FrameBatch]:
+        """Feed stream bytes; returns the batches of frames they complete."""
+        batches = []
+        total = len(data)
+        if total == 0:
+            return batches
+        # One copy of the input; each batch starts at an offset into it.
+        buf = (ctypes.c_char * total).from_buffer_copy(data)
+        base = ctypes.addressof(buf)
+        offset = 0
+        while offset < total:
+            records = (_FrameRecord * self._batch_records)()
+            arena = (ctypes.c_uint8 * self._batch_arena)()
+            consumed = ctypes.c_size_t(0)
+            count = _lib.s2t_framer_push_batch(self._handle, base + offset, total - offset,
+                                               records, self._batch_records,
+                                               arena, self._batch_arena,
+                                               ctypes.byref(consumed))
+            if consumed.value == 0:
+                raise ProtocolError("framer made no progress")
+            if count > 0:
+                used = records[count - 1].payload_offset + records[count - 1].payload_len
+                batches.append(FrameBatch(records, count, arena, used))
+            offset += consumed.value
+        return batches
+
+    def frames(self, data: bytes) -> Iterator[Frame]:
+        for batch in self.push(data):
+            yield from batch
+
+    def stats(self) -> FramerStats:
+        s = _FramerStats()
+        _lib.s2t_framer_get_stats(self._handle, ctypes.byref(s))
+        return FramerStats(s.bytes_in, s.frames_found, s.frames_valid,
+                           s.frames_invalid, s.sync_losses)
+
+
+def _main(argv: List[str]) -> int:
+    if len(argv) != 2:
+        print(f"usage: {argv[0]} <capture-file>", file=sys.stderr)
+        return 2
+    with open(argv[1], "rb") as f:
+        data = f.read()
+    with Framer() as framer:
+        batches = framer.push(data)
+        s = framer.stats()
+    print(f"protocol.py.batches={len(batches)} "
+          f"protocol.py.frames_found={s.frames_found} "
+          f"protocol.py.frames_valid={s.frames_valid} "
+          f"protocol.py.frames_invalid={s.frames_invalid} "
+          f"protocol.py.sync_losses={s.sync_losses}")
+    return 0 if s.frames_invalid == 0 else 1
+
+
+if __name__ == "__main__":
+    sys.exit(_main(sys.argv))
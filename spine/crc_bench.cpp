@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+
+#include "proto_constants.h"
+#include "proto_crc.h"
+#include "proto_crc_dma.h"
+
+/*
+ * On-target comparison of the software and DMA-sniffer payload CRC32.
+ *
+ * 1) Equivalence: random payloads of every length 0..MAX_PAYLOAD_SIZE_BYTES
+ *    must produce identical CRCs from both backends.
+ * 2) Cost: best and worst core cycles per call, measured with SysTick
+ *    clocked from the processor clock (the M0+ has no DWT cycle counter).
+ */
+
+static constexpr uint32_t SYSTICK_RELOAD_MAX   = 0x00FFFFFFu;
+static constexpr uint32_t SYSTICK_ENABLE_CPU   = 0x5u;  // ENABLE | CLKSOURCE=processor
+static constexpr uint32_t ITERATIONS_PER_SIZE  = 32u;
+static constexpr uint32_t EQUIVALENCE_ROUNDS   = 4u;
+static constexpr uint32_t REPORT_PERIOD_MS     = 5000u;
+
+static const size_t BENCH_SIZES[] = {0, 1, 4, 16, 32, 64, 128, 256};
+
+static uint8_t payload[proto::MAX_PAYLOAD_SIZE_BYTES];
+
+static inline uint32_t cycles_now() {
+    return systick_hw->cvr;
+}
+
+// SysTick counts down and wraps at 24 bits.
+static inline uint32_t cycles_between(uint32_t start, uint32_t end) {
+    return (start - end) & SYSTICK_RELOAD_MAX;
+}
+
+static void fill_random(size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        payload[i] = static_cast<uint8_t>(rand());
+    }
+}
+
+static uint32_t check_equivalence() {
+    uint32_t mismatches = 0;
+    for (uint32_t round = 0; round < EQUIVALENCE_ROUNDS; ++round) {
+        for (size_t len = 0; len <= proto::MAX_PAYLOAD_SIZE_BYTES; ++len) {
+            fill_random(len);
+            uint32_t hw = 0;
+            const uint32_t sw = proto::proto_crc32_iso_hdlc_sw(payload, len);
+            if (!proto::proto_crc32_dma_try(payload, len, &hw) || hw != sw) {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
+
+static void bench_size(size_t len, uint32_t overhead) {
+    uint32_t sw_min = SYSTICK_RELOAD_MAX, sw_max = 0;
+    uint32_t hw_min = SYSTICK_RELOAD_MAX, hw_max = 0;
+    volatile uint32_t sink = 0;
+
+    fill_random(len);
+
+    for (uint32_t i = 0; i < ITERATIONS_PER_SIZE; ++i) {
+        uint32_t t0 = cycles_now();
+        sink = proto::proto_crc32_iso_hdlc_sw(payload, len);
+        uint32_t t1 = cycles_now();
+        uint32_t c = cycles_between(t0, t1) - overhead;
+        if (c < sw_min) sw_min = c;
+        if (c > sw_max) sw_max = c;
+
+        uint32_t hw = 0;
+        t0 = cycles_now();
+        proto::proto_crc32_dma_try(payload, len, &hw);
+        t1 = cycles_now();
+        sink = hw;
+        c = cycles_between(t0, t1) - overhead;
+        if (c < hw_min) hw_min = c;
+        if (c > hw_max) hw_max = c;
+    }
+    (void)sink;
+
+    printf("crc_bench.len_bytes=%u sw_cycles_min=%lu sw_cycles_max=%lu "
+           "dma_cycles_min=%lu dma_cycles_max=%lu\n",
+           (unsigned)len,
+           (unsigned long)sw_min, (unsigned long)sw_max,
+           (unsigned long)hw_min, (unsigned long)hw_max);
+}
+
+int main() {
+    stdio_init_all();
+    sleep_ms(2000);
+
+    systick_hw->rvr = SYSTICK_RELOAD_MAX;
+    systick_hw->cvr = 0;
+    systick_hw->csr = SYSTICK_ENABLE_CPU;
+
+    const bool dma_ready = proto::proto_crc32_dma_init();
+
+    // Cost of the measurement itself, subtracted from every sample.
+    const uint32_t t0 = cycles_now();
+    const uint32_t t1 = cycles_now();
+    const uint32_t overhead = cycles_between(t0, t1);
+
+    while (true) {
+        printf("\n--- PAYLOAD CRC32: SOFTWARE vs DMA SNIFFER ---\n");
+        if (!dma_ready) {
+            printf("crc_bench.dma_ready=0 (no free DMA channel)\n");
+        } else {
+            printf("crc_bench.mismatch_count=%lu\n", (unsigned long)check_equivalence());
+            for (size_t i = 0; i < sizeof(BENCH_SIZES) / sizeof(BENCH_SIZES[0]); ++i) {
+                bench_size(BENCH_SIZES[i], overhead);
+            }
+        }
+        sleep_ms(REPORT_PERIOD_MS);
+    }
+}
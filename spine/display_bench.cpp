@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "hardware/i2c.h"
+#include "lib/pico-ssd1306/ssd1306.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+/*
+ * On-target cost of the OLED driver's bus traffic.
+ *
+ * 1) Command transactions: the same window-addressing sequence sent one
+ *    byte per transaction (the old driver) and as one command stream.
+ * 2) Init and refresh: wall time plus i2c transactions and bytes for
+ *    ssd1306_init, a full refresh, an unchanged redraw and a one-digit
+ *    change.
+ *
+ * Wiring matches scout_spine (i2c0, SDA 4, SCL 5, 0x3C, 400 kHz).
+ */
+
+#define I2C_PORT i2c0
+#define SDA_PIN 4
+#define SCL_PIN 5
+
+static constexpr uint8_t  DISPLAY_ADDRESS     = 0x3C;
+static constexpr uint32_t I2C_BAUD_HZ         = 400u * 1000u;
+static constexpr uint32_t ITERATIONS          = 16u;
+static constexpr uint32_t REPORT_PERIOD_MS    = 5000u;
+
+// Column and page window covering the whole panel; harmless to resend.
+static const uint8_t WINDOW_CMDS[] = {SET_COL_ADDR, 0, 127, SET_PAGE_ADDR, 0, 7};
+
+static ssd1306_t disp;
+
+struct BusSample {
+    uint32_t elapsed_us;
+    uint32_t transfer_count;
+    uint32_t byte_count;
+};
+
+static void sample_begin(BusSample* s) {
+    s->transfer_count = disp.i2c_transfer_count;
+    s->byte_count = disp.i2c_byte_count;
+    s->elapsed_us = time_us_32();
+}
+
+static void sample_end(BusSample* s) {
+    s->elapsed_us = time_us_32() - s->elapsed_us;
+    s->transfer_count = disp.i2c_transfer_count - s->transfer_count;
+    s->byte_count = disp.i2c_byte_count - s->byte_count;
+}
+
+static void print_sample(const char* name, const BusSample* s) {
+    printf("display_bench.%s_us=%lu %s_transfers=%lu %s_bytes=%lu\n",
+           name, (unsigned long)s->elapsed_us,
+           name, (unsigned long)s->transfer_count,
+           name, (unsigned long)s->byte_count);
+}
+
+static void bench_commands() {
+    uint32_t per_byte_us = 0;
+    uint32_t coalesced_us = 0;
+
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        uint32_t t0 = time_us_32();
+        for (size_t c = 0; c < sizeof(WINDOW_CMDS); ++c) {
+            const uint8_t d[2] = {0x00, WINDOW_CMDS[c]};
+            i2c_write_blocking(I2C_PORT, DISPLAY_ADDRESS, d, sizeof(d), false);
+        }
+        per_byte_us += time_us_32() - t0;
+
+        t0 = time_us_32();
+        ssd1306_cmd_buf_t b;
+        ssd1306_cmd_begin(&b);
+        for (size_t c = 0; c < sizeof(WINDOW_CMDS); ++c) {
+            ssd1306_cmd_push(&b, WINDOW_CMDS[c]);
+        }
+        ssd1306_cmd_send(&disp, &b);
+        coalesced_us += time_us_32() - t0;
+    }
+
+    printf("display_bench.window_cmds_per_byte_us=%lu window_cmds_coalesced_us=%lu\n",
+           (unsigned long)(per_byte_us / ITERATIONS),
+           (unsigned long)(coalesced_us / ITERATIONS));
+}
+
+static void draw_status(uint32_t counter) {
+    char line[16];
+    snprintf(line, sizeof(line), "T+%04lu", (unsigned long)(counter % 10000u));
+    ssd1306_clear(&disp);
+    ssd1306_draw_string(&disp, 20, 10, 2, "TITAN");
+    ssd1306_draw_string(&disp, 25, 35, 1, line);
+}
+
+static void bench_refresh(uint32_t* counter) {
+    BusSample s;
+
+    ssd1306_invalidate(&disp);
+    draw_status(*counter);
+    sample_begin(&s);
+    ssd1306_show(&disp);
+    sample_end(&s);
+    print_sample("show_full", &s);
+
+    draw_status(*counter);
+    sample_begin(&s);
+    ssd1306_show(&disp);
+    sample_end(&s);
+    print_sample("show_unchanged", &s);
+
+    // Last digit always changes; on 9 -> 0 the tens digit changes too.
+    *counter += 1u;
+    draw_status(*counter);
+    sample_begin(&s);
+    ssd1306_show(&disp);
+    sample_end(&s);
+    print_sample("show_digit", &s);
+}
+
+int main() {
+    stdio_init_all();
+    sleep_ms(2000);
+
+    i2c_init(I2C_PORT, I2C_BAUD_HZ);
+    gpio_set_function(SDA_PIN, GPIO_FUNC_I2C);
+    gpio_set_function(SCL_PIN, GPIO_FUNC_I2C);
+    gpio_pull_up(SDA_PIN);
+    gpio_pull_up(SCL_PIN);
+
+    disp.external_vcc = false;
+
+    // ssd1306_init resets the bus counters, so the sample is taken by hand.
+    const uint32_t t0 = time_us_32();
+    const bool ready = ssd1306_init(&disp, 128, 64, DISPLAY_ADDRESS, I2C_PORT);
+    BusSample init_sample = {time_us_32() - t0, disp.i2c_transfer_count, disp.i2c_byte_count};
+
+    uint32_t counter = 0;
+
+    while (true) {
+        printf("\n--- OLED BUS COST ---\n");
+        if (!ready) {
+            printf("display_bench.ready=0 (ssd1306_init failed)\n");
+        } else {
+            print_sample("init", &init_sample);
+            bench_commands();
+            bench_refresh(&counter);
+        }
+        sleep_ms(REPORT_PERIOD_MS);
+    }
+}
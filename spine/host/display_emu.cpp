@@ -0,0 +1,118 @@
+#include <stdio.h>
+#include <string.h>
+
+extern "C" {
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+#include "display_glyphs.h"
+}
+
+#include "ssd1306_emu.h"
+
+/*
+ * Host run of the OLED driver against the SSD1306 emulator.
+ *
+ * - Renders the Spine status screen through the unmodified driver and
+ *   writes what the panel would show as a PGM.
+ * - After every refresh, checks that the emulated GDDRAM equals the
+ *   driver's framebuffer (catches addressing and window bugs).
+ * - Reports bus cost per refresh: transactions, bytes, GDDRAM bytes.
+ *
+ * Usage: display_emu [output.pgm]   (default: status.pgm)
+ */
+
+static const uint32_t DISPLAY_W      = 128u;
+static const uint32_t DISPLAY_H      = 64u;
+static const uint8_t  DISPLAY_ADDR   = 0x3C;
+static const uint32_t PGM_SCALE      = 4u;
+static const uint32_t DIGIT_CHANGES  = 10u;
+
+static ssd1306_t disp;
+static host::Ssd1306Emu emu;
+static uint32_t frame_mismatch_count = 0;
+
+static void draw_status(uint32_t counter) {
+    char line[16];
+    snprintf(line, sizeof(line), "T+%04lu", (unsigned long)(counter % 10000u));
+    ssd1306_clear(&disp);
+    ssd1306_draw_string_cached(&disp, 20, 10, &glyph_cache_font_8x5_x2, "TITAN");
+    ssd1306_draw_string_cached(&disp, 25, 35, &glyph_cache_font_8x5_x1, "S2T ROVER");
+    ssd1306_draw_string_cached(&disp, 40, 48, &glyph_cache_font_8x5_x1, line);
+}
+
+static bool gddram_matches_buffer() {
+    for (uint32_t page = 0; page < disp.pages; ++page) {
+        if (memcmp(emu.gddram[page], disp.buffer + page * disp.width, disp.width) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void show_and_report(const char* name) {
+    const host::Ssd1306Counters before = emu.counters;
+    ssd1306_show(&disp);
+    const host::Ssd1306Counters& after = emu.counters;
+
+    if (!gddram_matches_buffer()) {
+        frame_mismatch_count++;
+    }
+
+    printf("display_emu.%s transfers=%u bytes=%u commands=%u gddram_bytes=%u\n",
+           name,
+           after.transaction_count - before.transaction_count,
+           after.byte_count - before.byte_count,
+           after.command_count - before.command_count,
+           after.data_byte_count - before.data_byte_count);
+}
+
+int main(int argc, char** argv) {
+    const char* pgm_path = (argc > 1) ? argv[1] : "status.pgm";
+
+    host::ssd1306_emu_reset(&emu);
+    if (!host::ssd1306_emu_attach(&emu, i2c0, DISPLAY_ADDR)) {
+        fprintf(stderr, "display_emu: attach failed\n");
+        return 1;
+    }
+
+    disp.external_vcc = false;
+    const host::Ssd1306Counters before_init = emu.counters;
+    if (!ssd1306_init(&disp, DISPLAY_W, DISPLAY_H, DISPLAY_ADDR, i2c0)) {
+        fprintf(stderr, "display_emu: ssd1306_init failed\n");
+        return 1;
+    }
+    printf("display_emu.init transfers=%u bytes=%u commands=%u\n",
+           emu.counters.transaction_count - before_init.transaction_count,
+           emu.counters.byte_count - before_init.byte_count,
+           emu.counters.command_count - before_init.command_count);
+
+    ssd1306_clear(&disp);
+    show_and_report("show_clear");
+
+    uint32_t counter = 0;
+    draw_status(counter);
+    show_and_report("show_status");
+
+    draw_status(counter);
+    show_and_report("show_unchanged");
+
+    for (uint32_t i = 0; i < DIGIT_CHANGES; ++i) {
+        draw_status(++counter);
+        show_and_report("show_digit");
+    }
+
+    ssd1306_invalidate(&disp);
+    show_and_report("show_full");
+
+    if (!host::ssd1306_emu_write_pgm(&emu, pgm_path, DISPLAY_W, DISPLAY_H, 0, PGM_SCALE)) {
+        fprintf(stderr, "display_emu: cannot write %s\n", pgm_path);
+        return 1;
+    }
+
+    printf("display_emu.unknown_command_count=%u\n", emu.counters.unknown_command_count);
+    printf("display_emu.frame_mismatch_count=%u\n", frame_mismatch_count);
+    printf("display_emu.pgm=%s\n", pgm_path);
+
+    ssd1306_deinit(&disp);
+    return (frame_mismatch_count == 0 && emu.counters.unknown_command_count == 0) ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+#include <stdio.h>
+
+#include <chrono>
+
+#include "pico/stdlib.h"
+#include "host_hal.h"
+#include "sim_check.h"
+
+#include "proto_framer.h"
+#include "proto_wire.h"
+#include "spine_event_log.h"
+
+/*
+ * Event log ring and its S2B_EVENT_LOG dump, read back through the
+ * Spine's own framer:
+ *
+ *   1. 50 events, dump            -> both rings in order, core1 empty
+ *   2. 1000 more events, dump     -> exactly the newest ring's worth
+ *   3. dump with the host stalled -> no progress, nothing lost; completes
+ *                                    once the host reads again
+ *   4. ring lapped mid-dump       -> overwritten records skipped, counted
+ *                                    and flagged; everything sent intact
+ *
+ * Also prints the host cost of one record call. Exit status is 0 only if
+ * every check holds.
+ */
+
+static constexpr uint32_t FIRST_EVENT_COUNT  = 50u;
+static constexpr uint32_t WRAP_EVENT_COUNT   = 1000u;
+static constexpr uint32_t LAP_EVENT_COUNT    = 200u;
+static constexpr uint32_t SERVICE_MAX_RUNS   = 1000u;
+static constexpr uint32_t COST_RECORD_COUNT  = 1000000u;
+static constexpr uint16_t SIM_EVENT_ID       = 0x7001u;
+
+struct DumpReadBack {
+    uint32_t frame_count;
+    uint32_t record_count[spine::EVENT_LOG_CORE_COUNT];
+    uint32_t last_frame_count[spine::EVENT_LOG_CORE_COUNT];
+    uint32_t gap_frame_count;
+    uint32_t order_error_count;     // sim records whose arg0 is not increasing
+    uint32_t first_sim_arg0;
+    uint32_t last_sim_arg0;
+    bool     have_sim_arg0;
+};
+
+static void on_frame(const uint8_t* packet, std::size_t packet_len, void* ctx) {
+    DumpReadBack* rb = static_cast<DumpReadBack*>(ctx);
+    (void)packet_len;
+    if (packet[proto::OFFSET_MSG_TYPE] != proto::MSG_ID_S2B_EVENT_LOG) {
+        return;
+    }
+
+    const uint8_t* payload = packet + proto::HEADER_SIZE_BYTES;
+    const uint32_t core = payload[spine::EVENT_LOG_OFFSET_CORE];
+    const uint32_t count = payload[spine::EVENT_LOG_OFFSET_RECORD_COUNT];
+    const uint8_t flags = payload[spine::EVENT_LOG_OFFSET_FLAGS];
+    if (core >= spine::EVENT_LOG_CORE_COUNT) {
+        rb->order_error_count++;
+        return;
+    }
+
+    rb->frame_count++;
+    rb->record_count[core] += count;
+    if ((flags & spine::EVENT_LOG_FLAG_LAST_FRAME) != 0u) {
+        rb->last_frame_count[core]++;
+    }
+    if ((flags & spine::EVENT_LOG_FLAG_GAP) != 0u) {
+        rb->gap_frame_count++;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint8_t* r = payload + spine::EVENT_LOG_FRAME_HEADER_BYTES + i * spine::EVENT_LOG_RECORD_BYTES;
+        if (proto::get_u16_le(r + spine::EVENT_LOG_RECORD_OFFSET_EVENT_ID) != SIM_EVENT_ID) {
+            continue;
+        }
+        const uint32_t arg0 = proto::get_u32_le(r + spine::EVENT_LOG_RECORD_OFFSET_ARG0);
+        const uint32_t arg1 = proto::get_u32_le(r + spine::EVENT_LOG_RECORD_OFFSET_ARG1);
+        if (arg1 != ~arg0 || (rb->have_sim_arg0 && arg0 <= rb->last_sim_arg0)) {
+            rb->order_error_count++;
+        }
+        if (!rb->have_sim_arg0) {
+            rb->first_sim_arg0 = arg0;
+        }
+        rb->have_sim_arg0 = true;
+        rb->last_sim_arg0 = arg0;
+    }
+}
+
+static uint32_t s_next_arg0 = 1u;
+
+static void record_events(uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        spine::spine_event_log_record(SIM_EVENT_ID, s_next_arg0, ~s_next_arg0);
+        s_next_arg0++;
+    }
+}
+
+static bool dump_done() {
+    static uint32_t dumps_seen = 0;
+    spine::EventLogCounters c;
+    spine::spine_event_log_get_counters(&c);
+    if (c.dump_count != dumps_seen) {
+        dumps_seen = c.dump_count;
+        return true;
+    }
+    return false;
+}
+
+// Service the dump until it completes, reading the link after every run.
+static DumpReadBack run_dump(int fd, proto::Framer* framer) {
+    DumpReadBack rb{};
+    spine::spine_event_log_request_dump();
+    for (uint32_t run = 0; run < SERVICE_MAX_RUNS; ++run) {
+        spine::spine_event_log_service_dump();
+        sim::read_back(fd, framer, on_frame, &rb);
+        if (dump_done()) {
+            break;
+        }
+    }
+    return rb;
+}
+
+int main() {
+    sim::begin("event_log_sim");
+    host_stdio_set_input_fd(-1);
+
+    const int link_fd = sim::open_link();
+    if (link_fd < 0) {
+        return 1;
+    }
+
+    proto::Framer framer;
+    proto::proto_framer_init(&framer);
+    spine::spine_event_log_init();
+    spine::EventLogCounters c{};
+
+    // 1. Ring not yet full. The dump records its own EVENT_LOG_DUMP first.
+    record_events(FIRST_EVENT_COUNT);
+    DumpReadBack rb = run_dump(link_fd, &framer);
+    sim::check("small_core0_records", rb.record_count[0] == FIRST_EVENT_COUNT + 1u);
+    sim::check("small_core1_empty", rb.record_count[1] == 0u && rb.last_frame_count[1] == 1u);
+    sim::check("small_in_order", rb.order_error_count == 0u && rb.first_sim_arg0 == 1u &&
+                                 rb.last_sim_arg0 == FIRST_EVENT_COUNT);
+    sim::check("small_frame_count", rb.frame_count ==
+               (FIRST_EVENT_COUNT + 1u + spine::EVENT_LOG_RECORDS_PER_FRAME - 1u) /
+                   spine::EVENT_LOG_RECORDS_PER_FRAME + 1u);
+
+    // 2. Wrapped ring: the newest EVENT_LOG_RECORDS_PER_CORE records.
+    record_events(WRAP_EVENT_COUNT);
+    rb = run_dump(link_fd, &framer);
+    sim::check("wrap_core0_records", rb.record_count[0] == spine::EVENT_LOG_RECORDS_PER_CORE - 1u);
+    sim::check("wrap_newest", rb.last_sim_arg0 == s_next_arg0 - 1u && rb.order_error_count == 0u &&
+                              rb.gap_frame_count == 0u);
+
+    // 3. Stalled link: nothing sent, nothing lost, then completion.
+    host_cdc_set_tx_stalled(true);
+    spine::spine_event_log_get_counters(&c);
+    const uint32_t frames_before = c.dump_frame_count;
+    const uint32_t lost_before = c.dump_lost_record_count;
+    spine::spine_event_log_request_dump();
+    for (uint32_t run = 0; run < 10u; ++run) {
+        spine::spine_event_log_service_dump();
+    }
+    spine::spine_event_log_get_counters(&c);
+    // The first frame fits the idle FIFO; nothing after it does.
+    sim::check("stalled_no_progress", c.dump_frame_count - frames_before <= 1u);
+    host_cdc_set_tx_stalled(false);
+    rb = DumpReadBack{};
+    for (uint32_t run = 0; run < SERVICE_MAX_RUNS && !dump_done(); ++run) {
+        spine::spine_event_log_service_dump();
+        sim::read_back(link_fd, &framer, on_frame, &rb);
+    }
+    spine::spine_event_log_get_counters(&c);
+    sim::check("stalled_completes", rb.last_frame_count[0] == 1u && rb.last_frame_count[1] == 1u);
+    sim::check("stalled_nothing_lost", c.dump_lost_record_count == lost_before && rb.order_error_count == 0u);
+
+    // 4. Lapped mid-dump.
+    rb = DumpReadBack{};
+    spine::spine_event_log_request_dump();
+    spine::spine_event_log_service_dump();
+    sim::read_back(link_fd, &framer, on_frame, &rb);
+    record_events(LAP_EVENT_COUNT);
+    for (uint32_t run = 0; run < SERVICE_MAX_RUNS && !dump_done(); ++run) {
+        spine::spine_event_log_service_dump();
+        sim::read_back(link_fd, &framer, on_frame, &rb);
+    }
+    spine::spine_event_log_get_counters(&c);
+    sim::check("lapped_lost_counted", c.dump_lost_record_count > lost_before && rb.gap_frame_count == 1u);
+    sim::check("lapped_sent_intact", rb.order_error_count == 0u && rb.last_frame_count[0] == 1u);
+
+    // Cost of one record on this host (informative).
+    const auto t0 = std::chrono::steady_clock::now();
+    record_events(COST_RECORD_COUNT);
+    const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+
+    spine::spine_event_log_get_counters(&c);
+    printf("event_log_sim.records_per_frame=%lu\n", (unsigned long)spine::EVENT_LOG_RECORDS_PER_FRAME);
+    printf("event_log_sim.dump_frame_count=%lu\n", (unsigned long)c.dump_frame_count);
+    printf("event_log_sim.dump_lost_record_count=%lu\n", (unsigned long)c.dump_lost_record_count);
+    printf("event_log_sim.host_record_ns=%.1f\n", ns / COST_RECORD_COUNT);
+    return sim::finish();
+}
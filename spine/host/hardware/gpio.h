@@ -0,0 +1,48 @@
+#ifndef SPINE_HOST_HARDWARE_GPIO_H
+#define SPINE_HOST_HARDWARE_GPIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Host stand-in for hardware/gpio.h. Pin state is kept in memory and can
+ * be inspected with host_gpio_* (host_hal.h). Inputs read the pull state.
+ */
+
+#define NUM_BANK0_GPIOS 30
+
+#define GPIO_IN  false
+#define GPIO_OUT true
+
+enum gpio_function {
+    GPIO_FUNC_XIP  = 0,
+    GPIO_FUNC_SPI  = 1,
+    GPIO_FUNC_UART = 2,
+    GPIO_FUNC_I2C  = 3,
+    GPIO_FUNC_PWM  = 4,
+    GPIO_FUNC_SIO  = 5,
+    GPIO_FUNC_PIO0 = 6,
+    GPIO_FUNC_PIO1 = 7,
+    GPIO_FUNC_GPCK = 8,
+    GPIO_FUNC_USB  = 9,
+    GPIO_FUNC_NULL = 0x1f,
+};
+
+void gpio_init(unsigned int gpio);
+void gpio_set_function(unsigned int gpio, enum gpio_function fn);
+void gpio_set_dir(unsigned int gpio, bool out);
+void gpio_put(unsigned int gpio, bool value);
+bool gpio_get(unsigned int gpio);
+void gpio_pull_up(unsigned int gpio);
+void gpio_pull_down(unsigned int gpio);
+void gpio_disable_pulls(unsigned int gpio);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPINE_HOST_HARDWARE_GPIO_H
@@ -0,0 +1,35 @@
+#ifndef SPINE_HOST_HARDWARE_I2C_H
+#define SPINE_HOST_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Host stand-in for the blocking I2C master API.
+ *
+ * Devices are host models attached per bus and address (host_i2c_attach
+ * in host_hal.h). A transfer to an address with no device attached fails
+ * like a NACK (PICO_ERROR_GENERIC).
+ */
+
+typedef struct i2c_inst i2c_inst_t;
+
+extern i2c_inst_t i2c0_inst;
+extern i2c_inst_t i2c1_inst;
+
+#define i2c0 (&i2c0_inst)
+#define i2c1 (&i2c1_inst)
+
+unsigned int i2c_init(i2c_inst_t *i2c, unsigned int baudrate);
+void i2c_deinit(i2c_inst_t *i2c);
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPINE_HOST_HARDWARE_I2C_H
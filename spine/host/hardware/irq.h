@@ -0,0 +1,34 @@
+#ifndef SPINE_HOST_HARDWARE_IRQ_H
+#define SPINE_HOST_HARDWARE_IRQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Host stand-in for hardware/irq.h. There is no interrupt controller:
+ * priorities are recorded, alarm "IRQs" are serialised by the
+ * save_and_disable_interrupts() lock instead.
+ */
+
+#define TIMER_IRQ_0 0
+#define TIMER_IRQ_1 1
+#define TIMER_IRQ_2 2
+#define TIMER_IRQ_3 3
+
+#define PICO_HIGHEST_IRQ_PRIORITY 0x00
+#define PICO_DEFAULT_IRQ_PRIORITY 0x80
+#define PICO_LOWEST_IRQ_PRIORITY  0xff
+
+void irq_set_priority(unsigned int num, uint8_t hardware_priority);
+uint32_t irq_get_priority(unsigned int num);
+void irq_set_enabled(unsigned int num, bool enabled);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPINE_HOST_HARDWARE_IRQ_H
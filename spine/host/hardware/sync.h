@@ -0,0 +1,33 @@
+#ifndef SPINE_HOST_HARDWARE_SYNC_H
+#define SPINE_HOST_HARDWARE_SYNC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Host stand-in for hardware/sync.h.
+ *
+ * "Disabling interrupts" takes one process-wide recursive lock that every
+ * alarm callback also holds while it runs, so a critical section excludes
+ * alarm IRQs exactly as on the RP2040 (and, stricter than hardware, on
+ * both cores).
+ */
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+
+static inline void __dmb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __sev(void) {}
+static inline void __wfe(void) {}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPINE_HOST_HARDWARE_SYNC_H
@@ -0,0 +1,91 @@
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+#include "host_hal.h"
+#include "sim_check.h"
+
+#include "spine_safety.h"
+#include "spine_timing.h"
+
+/*
+ * Hold timeout and periodic task timing on the virtual clock.
+ *
+ * Runs the real spine_timing / spine_safety code with time advanced in
+ * exact steps, so the Contract v0.2 deadlines can be checked to the
+ * microsecond with no scheduler noise:
+ *
+ *   1. keepalives every 200 ms for 2 s     -> no hold timeout
+ *   2. silence for 499 ms                  -> still no timeout
+ *   3. one more millisecond (500 ms)       -> exactly one timeout, 0 us late
+ *   4. a 100 ms periodic task over 1 s     -> due 10 times, none skipped
+ *
+ * Exit status is 0 only if every check holds.
+ */
+
+static constexpr uint32_t KEEPALIVE_PERIOD_US = 200u * spine::US_PER_MS;   // B2S heartbeat
+static constexpr uint32_t KEEPALIVE_WINDOW_US = 2000u * spine::US_PER_MS;
+static constexpr uint32_t TASK_PERIOD_US      = 100u * spine::US_PER_MS;
+static constexpr uint32_t TASK_WINDOW_US      = 1000u * spine::US_PER_MS;
+static constexpr uint32_t TASK_BUDGET_US      = 1000u;
+
+static void count_task_run(void* ctx) {
+    (void)ctx;
+}
+
+static spine::PeriodicTask sim_task = {
+    "sim_task", TASK_PERIOD_US, TASK_BUDGET_US, count_task_run, nullptr, 0u
+};
+
+int main() {
+    sim::begin("hold_timeout_sim");
+    host_stdio_set_input_fd(-1);
+    if (!host_clock_use_virtual()) {
+        fprintf(stderr, "hold_timeout_sim: virtual clock unavailable\n");
+        return 1;
+    }
+
+    spine::spine_safety_init();
+    if (!spine::spine_timing_init(spine::DEFAULT_HOLD_TIMEOUT_US)) {
+        fprintf(stderr, "hold_timeout_sim: timing init failed\n");
+        return 1;
+    }
+    spine::spine_safety_mark_ready();
+
+    spine::TimingMetrics m{};
+
+    // 1. Keepalives well inside the hold timeout.
+    for (uint32_t t = 0; t < KEEPALIVE_WINDOW_US; t += KEEPALIVE_PERIOD_US) {
+        spine::spine_timing_keepalive_received();
+        host_clock_advance_us(KEEPALIVE_PERIOD_US);
+    }
+    spine::spine_timing_get_metrics(&m);
+    sim::check("keepalive_no_timeout", m.hold_timeout_count == 0u);
+
+    // 2./3. Silence: the deadline is exactly one hold timeout after the
+    // last keepalive.
+    spine::spine_timing_keepalive_received();
+    host_clock_advance_us(spine::DEFAULT_HOLD_TIMEOUT_US - spine::US_PER_MS);
+    spine::spine_timing_get_metrics(&m);
+    sim::check("silence_499ms_no_timeout", m.hold_timeout_count == 0u);
+
+    host_clock_advance_us(spine::US_PER_MS);
+    spine::spine_timing_get_metrics(&m);
+    sim::check("silence_500ms_timeout", m.hold_timeout_count == 1u);
+    sim::check("timeout_latency_zero", m.timeout_to_safe_last_us == 0u);
+
+    // 4. Periodic task cadence.
+    if (!spine::spine_timing_add_periodic_task(&sim_task)) {
+        fprintf(stderr, "hold_timeout_sim: add task failed\n");
+        return 1;
+    }
+    for (uint32_t t = 0; t < TASK_WINDOW_US; t += TASK_PERIOD_US) {
+        host_clock_advance_us(TASK_PERIOD_US);
+        spine::spine_timing_run_due_tasks();
+    }
+    sim::check("task_run_count", sim_task.run_count == TASK_WINDOW_US / TASK_PERIOD_US);
+    sim::check("task_skipped_count", sim_task.skipped_count == 0u);
+
+    printf("hold_timeout_sim.keepalive_count=%lu\n", (unsigned long)m.keepalive_count);
+    printf("hold_timeout_sim.virtual_time_us=%llu\n", (unsigned long long)time_us_64());
+    return sim::finish();
+}
@@ -0,0 +1,27 @@
+#include "host_hal.h"
+#include "ssd1306_emu.h"
+
+/*
+ * Host "board": the devices a Rover Spine has on its buses, attached
+ * before main() runs so scout_spine and bus_scan find them where the
+ * hardware would have them.
+ *
+ *   i2c0 @ 0x3C  SSD1306 128x64 OLED (GP4 SDA / GP5 SCL on the rover)
+ */
+
+static constexpr uint8_t BOARD_OLED_ADDR = 0x3C;
+
+namespace {
+
+struct HostBoard {
+    host::Ssd1306Emu oled;
+
+    HostBoard() {
+        host::ssd1306_emu_reset(&oled);
+        (void)host::ssd1306_emu_attach(&oled, i2c0, BOARD_OLED_ADDR);
+    }
+};
+
+HostBoard s_board;
+
+} // namespace
@@ -0,0 +1,97 @@
+#include "hardware/gpio.h"
+#include "host_hal.h"
+
+#include <atomic>
+
+/*
+ * GPIO pins as memory. Outputs remember their level and count level
+ * changes (LED heartbeat checks); inputs read back their pull.
+ */
+
+enum HostPull : uint8_t {
+    HOST_PULL_NONE = 0u,
+    HOST_PULL_UP   = 1u,
+    HOST_PULL_DOWN = 2u,
+};
+
+struct HostGpio {
+    std::atomic<bool>     output;
+    std::atomic<bool>     level;
+    std::atomic<uint8_t>  pull;
+    std::atomic<uint8_t>  function;
+    std::atomic<uint32_t> toggle_count;
+};
+
+static HostGpio s_gpio[NUM_BANK0_GPIOS];
+
+static HostGpio* pin(unsigned int gpio) {
+    return (gpio < NUM_BANK0_GPIOS) ? &s_gpio[gpio] : nullptr;
+}
+
+void gpio_init(unsigned int gpio) {
+    if (HostGpio* p = pin(gpio)) {
+        p->output = false;
+        p->level = false;
+        p->function = GPIO_FUNC_SIO;
+        p->toggle_count = 0u;
+    }
+}
+
+void gpio_set_function(unsigned int gpio, enum gpio_function fn) {
+    if (HostGpio* p = pin(gpio)) {
+        p->function = static_cast<uint8_t>(fn);
+    }
+}
+
+void gpio_set_dir(unsigned int gpio, bool out) {
+    if (HostGpio* p = pin(gpio)) {
+        p->output = out;
+    }
+}
+
+void gpio_put(unsigned int gpio, bool value) {
+    if (HostGpio* p = pin(gpio)) {
+        if (p->level.exchange(value) != value) {
+            p->toggle_count++;
+        }
+    }
+}
+
+bool gpio_get(unsigned int gpio) {
+    const HostGpio* p = pin(gpio);
+    if (p == nullptr) {
+        return false;
+    }
+    if (p->output) {
+        return p->level;
+    }
+    return p->pull == HOST_PULL_UP;
+}
+
+void gpio_pull_up(unsigned int gpio) {
+    if (HostGpio* p = pin(gpio)) {
+        p->pull = HOST_PULL_UP;
+    }
+}
+
+void gpio_pull_down(unsigned int gpio) {
+    if (HostGpio* p = pin(gpio)) {
+        p->pull = HOST_PULL_DOWN;
+    }
+}
+
+void gpio_disable_pulls(unsigned int gpio) {
+    if (HostGpio* p = pin(gpio)) {
+        p->pull = HOST_PULL_NONE;
+    }
+}
+
+bool host_gpio_level(unsigned int gpio) {
+    const HostGpio* p = pin(gpio);
+    return (p != nullptr) && p->level;
+}
+
+uint32_t host_gpio_toggle_count(unsigned int gpio) {
+    const HostGpio* p = pin(gpio);
+    return (p != nullptr) ? p->toggle_count.load() : 0u;
+}
@@ -0,0 +1,92 @@
+#ifndef SPINE_HOST_HAL_H
+#define SPINE_HOST_HAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "hardware/i2c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Host-only controls of the Pico SDK stand-in (SPINE_PLATFORM=host).
+ * None of this exists on the RP2040; only host programs and the host
+ * board file call it.
+ */
+
+// --- clock ---
+
+/*
+ * Switch to the virtual clock. Must be called before any alarm pool is
+ * created (returns false otherwise). From then on time only moves in
+ * host_clock_advance_us() and sleep_*().
+ */
+bool host_clock_use_virtual(void);
+bool host_clock_is_virtual(void);
+
+/*
+ * Virtual clock only: advance by `us`, running every alarm that falls due
+ * on the way in deadline order, with time set to each alarm's deadline
+ * while its callback runs.
+ */
+void host_clock_advance_us(uint64_t us);
+
+// --- gpio ---
+
+bool     host_gpio_level(unsigned int gpio);        // driven output level
+uint32_t host_gpio_toggle_count(unsigned int gpio); // output level changes since init
+
+// --- i2c ---
+
+#define HOST_I2C_MAX_DEVICES 4
+
+// One complete transaction; return bytes transferred (or PICO_ERROR_GENERIC).
+typedef int (*host_i2c_write_fn)(void *ctx, const uint8_t *src, size_t len);
+typedef int (*host_i2c_read_fn)(void *ctx, uint8_t *dst, size_t len);
+
+// read may be NULL: reads are then NACKed.
+bool host_i2c_attach(i2c_inst_t *i2c, uint8_t addr, host_i2c_write_fn write,
+                     host_i2c_read_fn read, void *ctx);
+void host_i2c_detach_all(i2c_inst_t *i2c);
+
+// --- stdio ---
+
+/*
+ * getchar_timeout_us() serves bytes queued here first, then the input fd
+ * (stdin by default; -1 disables it, e.g. for self-contained simulations).
+ */
+size_t host_stdio_push_rx(const uint8_t *bytes, size_t len);
+void   host_stdio_set_input_fd(int fd);
+
+// --- usb cdc (tusb.h) ---
+
+// Where flushed CDC TX bytes go (stdout by default; -1 discards them).
+void     host_cdc_set_output_fd(int fd);
+
+// Host side stops reading: the TX FIFO fills and flushes deliver nothing.
+void     host_cdc_set_tx_stalled(bool stalled);
+
+// Bytes flushed to the host side since start.
+uint64_t host_cdc_tx_byte_count(void);
+
+// Where the RX thread reads (stdin by default; -1 disables it). Set
+// before tusb_init().
+void     host_cdc_set_input_fd(int fd);
+
+/*
+ * Queue bytes on the USB host side, as if written to the tty. The next
+ * tud_task() delivers them as CDC OUT packets. Stops early once
+ * HOST_CDC_RX_PENDING_BYTES are waiting (nobody is running tud_task()).
+ * Returns bytes accepted.
+ */
+#define HOST_CDC_RX_PENDING_BYTES 4096
+size_t   host_cdc_push_rx(const uint8_t *bytes, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPINE_HOST_HAL_H
@@ -0,0 +1,72 @@
+#include "hardware/i2c.h"
+#include "host_hal.h"
+
+/*
+ * Host I2C bus: a small table of attached device models per instance.
+ * Transactions are delivered whole; there is no bus timing.
+ */
+
+struct HostI2cDevice {
+    uint8_t           address;
+    host_i2c_write_fn write;
+    host_i2c_read_fn  read;
+    void*             ctx;
+};
+
+struct i2c_inst {
+    HostI2cDevice devices[HOST_I2C_MAX_DEVICES];
+    uint32_t      device_count;
+};
+
+i2c_inst_t i2c0_inst;
+i2c_inst_t i2c1_inst;
+
+static HostI2cDevice* find_device(i2c_inst_t* i2c, uint8_t addr) {
+    for (uint32_t i = 0; i < i2c->device_count; ++i) {
+        if (i2c->devices[i].address == addr) {
+            return &i2c->devices[i];
+        }
+    }
+    return nullptr;
+}
+
+bool host_i2c_attach(i2c_inst_t* i2c, uint8_t addr, host_i2c_write_fn write,
+                     host_i2c_read_fn read, void* ctx) {
+    if (i2c == nullptr || write == nullptr || find_device(i2c, addr) != nullptr ||
+        i2c->device_count >= HOST_I2C_MAX_DEVICES) {
+        return false;
+    }
+    i2c->devices[i2c->device_count++] = HostI2cDevice{addr, write, read, ctx};
+    return true;
+}
+
+void host_i2c_detach_all(i2c_inst_t* i2c) {
+    i2c->device_count = 0;
+}
+
+unsigned int i2c_init(i2c_inst_t* i2c, unsigned int baudrate) {
+    (void)i2c;
+    return baudrate;
+}
+
+void i2c_deinit(i2c_inst_t* i2c) {
+    (void)i2c;
+}
+
+int i2c_write_blocking(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop) {
+    (void)nostop;
+    HostI2cDevice* dev = find_device(i2c, addr);
+    if (dev == nullptr) {
+        return PICO_ERROR_GENERIC;
+    }
+    return dev->write(dev->ctx, src, len);
+}
+
+int i2c_read_blocking(i2c_inst_t* i2c, uint8_t addr, uint8_t* dst, size_t len, bool nostop) {
+    (void)nostop;
+    HostI2cDevice* dev = find_device(i2c, addr);
+    if (dev == nullptr || dev->read == nullptr) {
+        return PICO_ERROR_GENERIC;
+    }
+    return dev->read(dev->ctx, dst, len);
+}
@@ -0,0 +1,13 @@
+#ifndef SPINE_HOST_INTERNAL_H
+#define SPINE_HOST_INTERNAL_H
+
+// Shared between host HAL translation units only.
+
+namespace host {
+
+// Core number reported by get_core_num() for the calling thread.
+void set_core_num(unsigned int core_num);
+
+} // namespace host
+
+#endif // SPINE_HOST_INTERNAL_H
@@ -0,0 +1,121 @@
+#include "pico/multicore.h"
+#include "pico/stdlib.h"
+#include "host_internal.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/*
+ * core1 and the inter-core FIFOs.
+ *
+ * Each direction is a ring of HOST_MULTICORE_FIFO_DEPTH words. Which ring
+ * a call pushes to or pops from depends on the calling thread's core,
+ * exactly like the SIO FIFO registers.
+ */
+
+struct CoreFifo {
+    std::mutex              lock;
+    std::condition_variable changed;
+    uint32_t                words[HOST_MULTICORE_FIFO_DEPTH];
+    uint32_t                head;
+    uint32_t                count;
+};
+
+// s_fifo[n] carries words to core n.
+static CoreFifo s_fifo[2];
+
+static thread_local unsigned int t_core_num = 0u;
+
+namespace host {
+
+void set_core_num(unsigned int core_num) {
+    t_core_num = core_num;
+}
+
+} // namespace host
+
+uint get_core_num(void) {
+    return t_core_num;
+}
+
+static CoreFifo& tx_fifo() { return s_fifo[t_core_num ^ 1u]; }
+static CoreFifo& rx_fifo() { return s_fifo[t_core_num]; }
+
+void multicore_launch_core1(void (*entry)(void)) {
+    std::thread([entry] {
+        host::set_core_num(1u);
+        entry();
+    }).detach();
+}
+
+bool multicore_fifo_rvalid(void) {
+    CoreFifo& f = rx_fifo();
+    std::lock_guard<std::mutex> guard(f.lock);
+    return f.count > 0u;
+}
+
+bool multicore_fifo_wready(void) {
+    CoreFifo& f = tx_fifo();
+    std::lock_guard<std::mutex> guard(f.lock);
+    return f.count < HOST_MULTICORE_FIFO_DEPTH;
+}
+
+bool multicore_fifo_push_timeout_us(uint32_t data, uint64_t timeout_us) {
+    CoreFifo& f = tx_fifo();
+    std::unique_lock<std::mutex> guard(f.lock);
+    if (!f.changed.wait_for(guard, std::chrono::microseconds(timeout_us),
+                            [&f] { return f.count < HOST_MULTICORE_FIFO_DEPTH; })) {
+        return false;
+    }
+    f.words[(f.head + f.count) % HOST_MULTICORE_FIFO_DEPTH] = data;
+    f.count++;
+    f.changed.notify_all();
+    return true;
+}
+
+void multicore_fifo_push_blocking(uint32_t data) {
+    CoreFifo& f = tx_fifo();
+    std::unique_lock<std::mutex> guard(f.lock);
+    f.changed.wait(guard, [&f] { return f.count < HOST_MULTICORE_FIFO_DEPTH; });
+    f.words[(f.head + f.count) % HOST_MULTICORE_FIFO_DEPTH] = data;
+    f.count++;
+    f.changed.notify_all();
+}
+
+// Caller holds f.lock and f.count > 0.
+static uint32_t pop_locked(CoreFifo& f) {
+    const uint32_t data = f.words[f.head];
+    f.head = (f.head + 1u) % HOST_MULTICORE_FIFO_DEPTH;
+    f.count--;
+    f.changed.notify_all();
+    return data;
+}
+
+uint32_t multicore_fifo_pop_blocking(void) {
+    CoreFifo& f = rx_fifo();
+    std::unique_lock<std::mutex> guard(f.lock);
+    f.changed.wait(guard, [&f] { return f.count > 0u; });
+    return pop_locked(f);
+}
+
+bool multicore_fifo_pop_timeout_us(uint64_t timeout_us, uint32_t* out) {
+    CoreFifo& f = rx_fifo();
+    std::unique_lock<std::mutex> guard(f.lock);
+    if (!f.changed.wait_for(guard, std::chrono::microseconds(timeout_us),
+                            [&f] { return f.count > 0u; })) {
+        return false;
+    }
+    *out = pop_locked(f);
+    return true;
+}
+
+void multicore_fifo_drain(void) {
+    CoreFifo& f = rx_fifo();
+    std::lock_guard<std::mutex> guard(f.lock);
+    f.head = 0u;
+    f.count = 0u;
+    f.changed.notify_all();
+}
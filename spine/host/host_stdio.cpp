@@ -0,0 +1,95 @@
+#include "pico/stdlib.h"
+#include "host_hal.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+
+#include <poll.h>
+#include <unistd.h>
+
+/*
+ * stdio: output is the process stdout; input is a queue of injected bytes
+ * followed by a file descriptor (stdin unless changed).
+ *
+ * On the virtual clock a read that finds nothing advances time by the
+ * timeout instead of waiting, so a polling loop still makes progress.
+ */
+
+static constexpr size_t HOST_STDIO_RX_CAPACITY = 4096u;
+
+static std::mutex       s_rx_lock;
+static uint8_t          s_rx[HOST_STDIO_RX_CAPACITY];
+static size_t           s_rx_head = 0u;
+static size_t           s_rx_count = 0u;
+static std::atomic<int> s_input_fd{STDIN_FILENO};
+
+bool stdio_init_all(void) {
+    // USB CDC delivers each printf promptly; match that on a pipe.
+    std::setvbuf(stdout, nullptr, _IOLBF, 0);
+    return true;
+}
+
+size_t host_stdio_push_rx(const uint8_t* bytes, size_t len) {
+    std::lock_guard<std::mutex> guard(s_rx_lock);
+    size_t pushed = 0u;
+    while (pushed < len && s_rx_count < HOST_STDIO_RX_CAPACITY) {
+        s_rx[(s_rx_head + s_rx_count) % HOST_STDIO_RX_CAPACITY] = bytes[pushed++];
+        s_rx_count++;
+    }
+    return pushed;
+}
+
+void host_stdio_set_input_fd(int fd) {
+    s_input_fd.store(fd);
+}
+
+static int pop_injected() {
+    std::lock_guard<std::mutex> guard(s_rx_lock);
+    if (s_rx_count == 0u) {
+        return PICO_ERROR_TIMEOUT;
+    }
+    const uint8_t b = s_rx[s_rx_head];
+    s_rx_head = (s_rx_head + 1u) % HOST_STDIO_RX_CAPACITY;
+    s_rx_count--;
+    return b;
+}
+
+static int read_fd(int timeout_ms) {
+    const int fd = s_input_fd.load();
+    if (fd < 0) {
+        return PICO_ERROR_TIMEOUT;
+    }
+
+    pollfd p{fd, POLLIN, 0};
+    if (::poll(&p, 1, timeout_ms) <= 0 || (p.revents & (POLLIN | POLLHUP)) == 0) {
+        return PICO_ERROR_TIMEOUT;
+    }
+
+    uint8_t b = 0u;
+    if (::read(fd, &b, 1) != 1) {
+        // EOF: stop polling a closed pipe, the link just goes quiet.
+        s_input_fd.store(-1);
+        return PICO_ERROR_TIMEOUT;
+    }
+    return b;
+}
+
+int getchar_timeout_us(uint32_t timeout_us) {
+    const int injected = pop_injected();
+    if (injected != PICO_ERROR_TIMEOUT) {
+        return injected;
+    }
+
+    if (host_clock_is_virtual()) {
+        const int c = read_fd(0);
+        if (c == PICO_ERROR_TIMEOUT) {
+            host_clock_advance_us(timeout_us);
+        }
+        return c;
+    }
+
+    // poll() has ms resolution; round a non-zero timeout up.
+    const int timeout_ms = static_cast<int>((timeout_us + 999u) / 1000u);
+    return read_fd(timeout_ms);
+}
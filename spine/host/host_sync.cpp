@@ -0,0 +1,61 @@
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+#include <atomic>
+#include <mutex>
+
+/*
+ * Interrupt masking and priorities.
+ *
+ * The "interrupts disabled" state is a recursive lock: thread code holds
+ * it between save_and_disable_interrupts() and restore_interrupts(), and
+ * host_time holds it around every alarm callback.
+ */
+
+static constexpr unsigned int HOST_IRQ_COUNT = 32u;
+
+static std::recursive_mutex& irq_lock() {
+    static std::recursive_mutex lock;
+    return lock;
+}
+
+struct IrqPriorities {
+    std::atomic<uint8_t> level[HOST_IRQ_COUNT];
+
+    IrqPriorities() {
+        for (unsigned int i = 0; i < HOST_IRQ_COUNT; ++i) {
+            level[i].store(PICO_DEFAULT_IRQ_PRIORITY, std::memory_order_relaxed);
+        }
+    }
+};
+
+static IrqPriorities& irq_priorities() {
+    static IrqPriorities priorities;
+    return priorities;
+}
+
+uint32_t save_and_disable_interrupts(void) {
+    irq_lock().lock();
+    return 0;
+}
+
+void restore_interrupts(uint32_t status) {
+    (void)status;
+    irq_lock().unlock();
+}
+
+void irq_set_priority(unsigned int num, uint8_t hardware_priority) {
+    if (num < HOST_IRQ_COUNT) {
+        irq_priorities().level[num].store(hardware_priority, std::memory_order_relaxed);
+    }
+}
+
+uint32_t irq_get_priority(unsigned int num) {
+    return (num < HOST_IRQ_COUNT) ? irq_priorities().level[num].load(std::memory_order_relaxed)
+                                  : PICO_DEFAULT_IRQ_PRIORITY;
+}
+
+void irq_set_enabled(unsigned int num, bool enabled) {
+    (void)num;
+    (void)enabled;
+}
@@ -0,0 +1,363 @@
+#include "pico/time.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "host_hal.h"
+#include "host_internal.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Clock and alarm pools.
+ *
+ * Real clock: microseconds of CLOCK_MONOTONIC since process start. Each
+ * pool has one thread standing in for its timer IRQ.
+ *
+ * Virtual clock: time is a counter. host_clock_advance_us() (and sleep_*)
+ * move it forward and fire due alarms in deadline order on the calling
+ * thread. No pool threads exist, so runs are deterministic.
+ *
+ * Either way a callback runs with the interrupt lock held and the pool
+ * lock released, so callbacks may add or cancel alarms.
+ */
+
+static constexpr unsigned int HOST_HARDWARE_ALARM_COUNT = 4u;
+static constexpr unsigned int DEFAULT_POOL_ALARM_NUM = 3u;   // as in the SDK
+static constexpr unsigned int DEFAULT_POOL_MAX_TIMERS = 16u;
+
+struct AlarmEntry {
+    bool             in_use;
+    alarm_id_t       id;
+    uint64_t         target_us;
+    alarm_callback_t callback;
+    void*            user_data;
+};
+
+struct alarm_pool {
+    unsigned int            hardware_alarm_num;
+    unsigned int            core_num;
+    std::mutex              lock;
+    std::condition_variable wake;
+    std::vector<AlarmEntry> entries;
+    alarm_id_t              next_id;
+};
+
+static std::atomic<bool>     s_virtual_clock{false};
+static std::atomic<uint64_t> s_virtual_now_us{0};
+
+static std::mutex   s_pools_lock;
+static alarm_pool*  s_pools[HOST_HARDWARE_ALARM_COUNT];
+static alarm_pool*  s_default_pool = nullptr;
+
+static std::chrono::steady_clock::time_point boot_time() {
+    static const std::chrono::steady_clock::time_point boot = std::chrono::steady_clock::now();
+    return boot;
+}
+
+// Anchor "boot" at load time rather than at the first clock read.
+static const bool s_boot_anchored = (boot_time(), true);
+
+uint64_t time_us_64(void) {
+    if (s_virtual_clock.load(std::memory_order_acquire)) {
+        return s_virtual_now_us.load(std::memory_order_acquire);
+    }
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - boot_time()).count());
+}
+
+uint32_t time_us_32(void) {
+    return static_cast<uint32_t>(time_us_64());
+}
+
+absolute_time_t get_absolute_time(void) {
+    return from_us_since_boot(time_us_64());
+}
+
+bool host_clock_use_virtual(void) {
+    std::lock_guard<std::mutex> guard(s_pools_lock);
+    for (unsigned int i = 0; i < HOST_HARDWARE_ALARM_COUNT; ++i) {
+        if (s_pools[i] != nullptr) {
+            return false;
+        }
+    }
+    s_virtual_now_us.store(time_us_64(), std::memory_order_release);
+    s_virtual_clock.store(true, std::memory_order_release);
+    return true;
+}
+
+bool host_clock_is_virtual(void) {
+    return s_virtual_clock.load(std::memory_order_acquire);
+}
+
+// --- pool internals ---
+
+// Caller holds pool->lock.
+static AlarmEntry* earliest_entry(alarm_pool* pool) {
+    AlarmEntry* best = nullptr;
+    for (AlarmEntry& e : pool->entries) {
+        if (e.in_use && (best == nullptr || e.target_us < best->target_us)) {
+            best = &e;
+        }
+    }
+    return best;
+}
+
+// Caller holds pool->lock.
+static AlarmEntry* entry_by_id(alarm_pool* pool, alarm_id_t id) {
+    for (AlarmEntry& e : pool->entries) {
+        if (e.in_use && e.id == id) {
+            return &e;
+        }
+    }
+    return nullptr;
+}
+
+// Caller holds pool->lock. Returns false if the pool is full.
+static bool insert_entry(alarm_pool* pool, alarm_id_t id, uint64_t target_us,
+                         alarm_callback_t callback, void* user_data) {
+    for (AlarmEntry& e : pool->entries) {
+        if (!e.in_use) {
+            e = AlarmEntry{true, id, target_us, callback, user_data};
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Fire the pool's earliest alarm if it is due by `limit_us`. Takes the
+ * interrupt lock first, so thread code inside a critical section can
+ * still cancel an alarm that is due but has not started.
+ */
+static bool fire_next_due(alarm_pool* pool, uint64_t limit_us) {
+    const uint32_t irq_state = save_and_disable_interrupts();
+
+    AlarmEntry fired;
+    {
+        std::lock_guard<std::mutex> guard(pool->lock);
+        AlarmEntry* e = earliest_entry(pool);
+        if (e == nullptr || e->target_us > limit_us) {
+            restore_interrupts(irq_state);
+            return false;
+        }
+        fired = *e;
+        e->in_use = false;
+    }
+
+    if (s_virtual_clock.load(std::memory_order_acquire)) {
+        s_virtual_now_us.store(fired.target_us, std::memory_order_release);
+    }
+
+    const int64_t again = fired.callback(fired.id, fired.user_data);
+
+    if (again != 0) {
+        const uint64_t next_us = (again < 0) ? fired.target_us + static_cast<uint64_t>(-again)
+                                             : time_us_64() + static_cast<uint64_t>(again);
+        std::lock_guard<std::mutex> guard(pool->lock);
+        (void)insert_entry(pool, fired.id, next_us, fired.callback, fired.user_data);
+        pool->wake.notify_all();
+    }
+
+    restore_interrupts(irq_state);
+    return true;
+}
+
+static void pool_irq_thread(alarm_pool* pool) {
+    host::set_core_num(pool->core_num);
+
+    std::unique_lock<std::mutex> guard(pool->lock);
+    while (true) {
+        AlarmEntry* e = earliest_entry(pool);
+        if (e == nullptr) {
+            pool->wake.wait(guard);
+            continue;
+        }
+        const uint64_t now_us = time_us_64();
+        if (e->target_us > now_us) {
+            pool->wake.wait_for(guard, std::chrono::microseconds(e->target_us - now_us));
+            continue;
+        }
+        guard.unlock();
+        (void)fire_next_due(pool, time_us_64());
+        guard.lock();
+    }
+}
+
+void host_clock_advance_us(uint64_t us) {
+    if (!s_virtual_clock.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    const uint64_t target_us = s_virtual_now_us.load(std::memory_order_acquire) + us;
+
+    while (true) {
+        // Earliest due alarm across every pool.
+        alarm_pool* due_pool = nullptr;
+        uint64_t due_us = target_us;
+        {
+            std::lock_guard<std::mutex> pools_guard(s_pools_lock);
+            for (unsigned int i = 0; i < HOST_HARDWARE_ALARM_COUNT; ++i) {
+                alarm_pool* pool = s_pools[i];
+                if (pool == nullptr) {
+                    continue;
+                }
+                std::lock_guard<std::mutex> guard(pool->lock);
+                const AlarmEntry* e = earliest_entry(pool);
+                if (e != nullptr && e->target_us <= due_us) {
+                    due_us = e->target_us;
+                    due_pool = pool;
+                }
+            }
+        }
+        if (due_pool == nullptr || !fire_next_due(due_pool, target_us)) {
+            break;
+        }
+    }
+
+    s_virtual_now_us.store(target_us, std::memory_order_release);
+}
+
+void sleep_us(uint64_t us) {
+    if (s_virtual_clock.load(std::memory_order_acquire)) {
+        host_clock_advance_us(us);
+        return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us(static_cast<uint64_t>(ms) * 1000u);
+}
+
+// --- SDK alarm pool API ---
+
+alarm_pool_t* alarm_pool_create(unsigned int hardware_alarm_num, unsigned int max_timers) {
+    if (hardware_alarm_num >= HOST_HARDWARE_ALARM_COUNT || max_timers == 0u) {
+        return nullptr;
+    }
+
+    alarm_pool* pool = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(s_pools_lock);
+        if (s_pools[hardware_alarm_num] != nullptr) {
+            return nullptr; // alarm already claimed
+        }
+        pool = new alarm_pool();
+        pool->hardware_alarm_num = hardware_alarm_num;
+        pool->core_num = get_core_num();
+        pool->entries.resize(max_timers, AlarmEntry{false, 0, 0, nullptr, nullptr});
+        pool->next_id = 1;
+        s_pools[hardware_alarm_num] = pool;
+    }
+
+    if (!s_virtual_clock.load(std::memory_order_acquire)) {
+        std::thread(pool_irq_thread, pool).detach();
+    }
+    return pool;
+}
+
+alarm_id_t alarm_pool_add_alarm_at(alarm_pool_t* pool, absolute_time_t time,
+                                   alarm_callback_t callback, void* user_data,
+                                   bool fire_if_past) {
+    if (pool == nullptr || callback == nullptr) {
+        return -1;
+    }
+
+    uint64_t target_us = to_us_since_boot(time);
+    const uint64_t now_us = time_us_64();
+    if (target_us <= now_us) {
+        if (!fire_if_past) {
+            return 0;
+        }
+        target_us = now_us;
+    }
+
+    std::lock_guard<std::mutex> guard(pool->lock);
+    const alarm_id_t id = pool->next_id;
+    if (!insert_entry(pool, id, target_us, callback, user_data)) {
+        return -1;
+    }
+    // Ids stay positive; wrap skips 0 and negatives like the SDK.
+    pool->next_id = (pool->next_id == INT32_MAX) ? 1 : pool->next_id + 1;
+    pool->wake.notify_all();
+    return id;
+}
+
+alarm_id_t alarm_pool_add_alarm_in_us(alarm_pool_t* pool, uint64_t us,
+                                      alarm_callback_t callback, void* user_data,
+                                      bool fire_if_past) {
+    return alarm_pool_add_alarm_at(pool, from_us_since_boot(time_us_64() + us),
+                                   callback, user_data, fire_if_past);
+}
+
+bool alarm_pool_cancel_alarm(alarm_pool_t* pool, alarm_id_t alarm_id) {
+    if (pool == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(pool->lock);
+    AlarmEntry* e = entry_by_id(pool, alarm_id);
+    if (e == nullptr) {
+        return false;
+    }
+    e->in_use = false;
+    pool->wake.notify_all();
+    return true;
+}
+
+static int64_t repeating_timer_fire(alarm_id_t id, void* user_data) {
+    (void)id;
+    repeating_timer_t* rt = static_cast<repeating_timer_t*>(user_data);
+    // Same sign convention as an alarm return value.
+    return rt->callback(rt) ? rt->delay_us : 0;
+}
+
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t* pool, int64_t delay_us,
+                                       repeating_timer_callback_t callback,
+                                       void* user_data, repeating_timer_t* out) {
+    if (pool == nullptr || callback == nullptr || out == nullptr) {
+        return false;
+    }
+    if (delay_us == 0) {
+        delay_us = 1;
+    }
+
+    out->delay_us = delay_us;
+    out->pool = pool;
+    out->callback = callback;
+    out->user_data = user_data;
+
+    const uint64_t first_us = static_cast<uint64_t>(delay_us < 0 ? -delay_us : delay_us);
+    out->alarm_id = alarm_pool_add_alarm_in_us(pool, first_us, repeating_timer_fire, out, true);
+    return out->alarm_id > 0;
+}
+
+bool cancel_repeating_timer(repeating_timer_t* timer) {
+    if (timer == nullptr || timer->pool == nullptr) {
+        return false;
+    }
+    return alarm_pool_cancel_alarm(timer->pool, timer->alarm_id);
+}
+
+static alarm_pool* default_pool() {
+    static std::once_flag once;
+    std::call_once(once, [] {
+        s_default_pool = alarm_pool_create(DEFAULT_POOL_ALARM_NUM, DEFAULT_POOL_MAX_TIMERS);
+    });
+    return s_default_pool;
+}
+
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void* user_data, bool fire_if_past) {
+    return alarm_pool_add_alarm_in_us(default_pool(), us, callback, user_data, fire_if_past);
+}
+
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void* user_data, bool fire_if_past) {
+    return add_alarm_in_us(static_cast<uint64_t>(ms) * 1000u, callback, user_data, fire_if_past);
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+    return alarm_pool_cancel_alarm(default_pool(), alarm_id);
+}
@@ -0,0 +1,214 @@
+#include "tusb.h"
+#include "host_hal.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include <unistd.h>
+
+/*
+ * USB CDC TX: a byte FIFO of CFG_TUD_CDC_TX_BUFSIZE drained to an fd.
+ * On the RP2040 the USB IRQ drains it in the background; here every call
+ * drains it first, as if that had happened. Stalling the host side leaves
+ * the FIFO full, which is how a real link backs up when the Brain stops
+ * reading.
+ */
+
+static std::mutex            s_tx_lock;
+static uint8_t               s_tx[CFG_TUD_CDC_TX_BUFSIZE];
+static uint32_t              s_tx_count = 0u;
+static std::atomic<int>      s_output_fd{STDOUT_FILENO};
+static std::atomic<bool>     s_stalled{false};
+static std::atomic<uint64_t> s_delivered{0u};
+
+void host_cdc_set_output_fd(int fd) {
+    s_output_fd.store(fd);
+}
+
+void host_cdc_set_tx_stalled(bool stalled) {
+    s_stalled.store(stalled);
+}
+
+uint64_t host_cdc_tx_byte_count(void) {
+    return s_delivered.load();
+}
+
+bool tud_cdc_connected(void) {
+    return true;
+}
+
+// Caller holds s_tx_lock. Returns bytes delivered.
+static uint32_t drain_locked() {
+    if (s_stalled.load() || s_tx_count == 0u) {
+        return 0u;
+    }
+
+    const int fd = s_output_fd.load();
+    uint32_t done = 0u;
+    while (fd >= 0 && done < s_tx_count) {
+        const ssize_t n = ::write(fd, s_tx + done, s_tx_count - done);
+        if (n <= 0) {
+            break;  // a broken pipe drops the rest, as a detached host would
+        }
+        done += static_cast<uint32_t>(n);
+    }
+
+    const uint32_t flushed = s_tx_count;
+    s_delivered.fetch_add(flushed);
+    s_tx_count = 0u;
+    return flushed;
+}
+
+uint32_t tud_cdc_write_available(void) {
+    std::lock_guard<std::mutex> guard(s_tx_lock);
+    drain_locked();
+    return CFG_TUD_CDC_TX_BUFSIZE - s_tx_count;
+}
+
+uint32_t tud_cdc_write(void const* buffer, uint32_t bufsize) {
+    std::lock_guard<std::mutex> guard(s_tx_lock);
+    drain_locked();
+    const uint32_t space = CFG_TUD_CDC_TX_BUFSIZE - s_tx_count;
+    const uint32_t n = (bufsize < space) ? bufsize : space;
+    std::memcpy(s_tx + s_tx_count, buffer, n);
+    s_tx_count += n;
+    return n;
+}
+
+uint32_t tud_cdc_write_flush(void) {
+    std::lock_guard<std::mutex> guard(s_tx_lock);
+    return drain_locked();
+}
+
+/*
+ * USB CDC RX: bytes the USB host has written wait in a pending queue
+ * until tud_task() takes them, one OUT packet (CFG_TUD_CDC_EP_BUFSIZE) at
+ * a time, into a FIFO of CFG_TUD_CDC_RX_BUFSIZE, calling tud_cdc_rx_cb()
+ * after each. While the FIFO has no room the packets stay pending, as
+ * TinyUSB leaves the endpoint un-armed and the USB host's writes back up.
+ *
+ * The FIFO is touched only by the thread running tud_task() (core1 on
+ * the Spine); the pending queue is shared with the reader thread and
+ * host_cdc_push_rx callers.
+ */
+
+static uint8_t                 s_rx[CFG_TUD_CDC_RX_BUFSIZE];
+static uint32_t                s_rx_head = 0u;
+static uint32_t                s_rx_count = 0u;
+
+static std::mutex              s_pending_lock;
+static std::condition_variable s_pending_space;
+static uint8_t                 s_pending[HOST_CDC_RX_PENDING_BYTES];
+static uint32_t                s_pending_head = 0u;
+static uint32_t                s_pending_count = 0u;
+
+static std::atomic<int>        s_input_fd{STDIN_FILENO};
+static std::once_flag          s_rx_started;
+
+void host_cdc_set_input_fd(int fd) {
+    s_input_fd.store(fd);
+}
+
+uint32_t tud_cdc_available(void) {
+    return s_rx_count;
+}
+
+uint32_t tud_cdc_read(void* buffer, uint32_t bufsize) {
+    uint8_t* out = static_cast<uint8_t*>(buffer);
+    const uint32_t n = (bufsize < s_rx_count) ? bufsize : s_rx_count;
+    for (uint32_t i = 0u; i < n; ++i) {
+        out[i] = s_rx[s_rx_head];
+        s_rx_head = (s_rx_head + 1u) % CFG_TUD_CDC_RX_BUFSIZE;
+    }
+    s_rx_count -= n;
+    return n;
+}
+
+// Caller holds s_pending_lock. Returns bytes queued.
+static size_t queue_pending_locked(const uint8_t* bytes, size_t len) {
+    size_t n = 0u;
+    while (n < len && s_pending_count < HOST_CDC_RX_PENDING_BYTES) {
+        s_pending[(s_pending_head + s_pending_count) % HOST_CDC_RX_PENDING_BYTES] = bytes[n++];
+        s_pending_count++;
+    }
+    return n;
+}
+
+size_t host_cdc_push_rx(const uint8_t* bytes, size_t len) {
+    std::lock_guard<std::mutex> guard(s_pending_lock);
+    return queue_pending_locked(bytes, len);
+}
+
+// Takes the next OUT packet if the FIFO has room; returns its length.
+static uint32_t receive_packet() {
+    std::lock_guard<std::mutex> guard(s_pending_lock);
+    const uint32_t space = CFG_TUD_CDC_RX_BUFSIZE - s_rx_count;
+    uint32_t n = (s_pending_count < CFG_TUD_CDC_EP_BUFSIZE) ? s_pending_count
+                                                             : CFG_TUD_CDC_EP_BUFSIZE;
+    if (n > space) {
+        n = space;
+    }
+    for (uint32_t i = 0u; i < n; ++i) {
+        s_rx[(s_rx_head + s_rx_count + i) % CFG_TUD_CDC_RX_BUFSIZE] =
+            s_pending[(s_pending_head + i) % HOST_CDC_RX_PENDING_BYTES];
+    }
+    s_rx_count += n;
+    s_pending_head = (s_pending_head + n) % HOST_CDC_RX_PENDING_BYTES;
+    s_pending_count -= n;
+    if (n > 0u) {
+        s_pending_space.notify_all();
+    }
+    return n;
+}
+
+void tud_task(void) {
+    {
+        // IN transfers complete here on the RP2040.
+        std::lock_guard<std::mutex> guard(s_tx_lock);
+        drain_locked();
+    }
+    while (receive_packet() > 0u) {
+        if (tud_cdc_rx_cb) {
+            tud_cdc_rx_cb(0u);
+        }
+    }
+}
+
+static void rx_thread() {
+    uint8_t packet[CFG_TUD_CDC_EP_BUFSIZE];
+    while (true) {
+        const int fd = s_input_fd.load();
+        if (fd < 0) {
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(s_pending_lock);
+            s_pending_space.wait(lock, [] {
+                return HOST_CDC_RX_PENDING_BYTES - s_pending_count >= sizeof(packet);
+            });
+        }
+
+        const ssize_t n = ::read(fd, packet, sizeof(packet));
+        if (n <= 0) {
+            return;  // EOF: the link just goes quiet
+        }
+
+        // A host_cdc_push_rx caller may have taken the space meanwhile.
+        std::unique_lock<std::mutex> lock(s_pending_lock);
+        s_pending_space.wait(lock, [n] {
+            return HOST_CDC_RX_PENDING_BYTES - s_pending_count >= static_cast<uint32_t>(n);
+        });
+        queue_pending_locked(packet, static_cast<size_t>(n));
+    }
+}
+
+bool tusb_init(void) {
+    std::call_once(s_rx_started, [] {
+        std::thread(rx_thread).detach();
+    });
+    return true;
+}
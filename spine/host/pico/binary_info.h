@@ -0,0 +1,6 @@
+#ifndef SPINE_HOST_PICO_BINARY_INFO_H
+#define SPINE_HOST_PICO_BINARY_INFO_H
+
+// Binary info only exists in RP2040 images; nothing to declare on host.
+
+#endif // SPINE_HOST_PICO_BINARY_INFO_H
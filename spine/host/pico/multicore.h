@@ -0,0 +1,32 @@
+#ifndef SPINE_HOST_PICO_MULTICORE_H
+#define SPINE_HOST_PICO_MULTICORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Host stand-in for pico/multicore.h. core1 is a thread; the inter-core
+ * FIFOs are two bounded queues with the RP2040 depth.
+ */
+
+#define HOST_MULTICORE_FIFO_DEPTH 8
+
+void multicore_launch_core1(void (*entry)(void));
+
+bool multicore_fifo_rvalid(void);
+bool multicore_fifo_wready(void);
+void multicore_fifo_push_blocking(uint32_t data);
+bool multicore_fifo_push_timeout_us(uint32_t data, uint64_t timeout_us);
+uint32_t multicore_fifo_pop_blocking(void);
+bool multicore_fifo_pop_timeout_us(uint64_t timeout_us, uint32_t *out);
+void multicore_fifo_drain(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPINE_HOST_PICO_MULTICORE_H
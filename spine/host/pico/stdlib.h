@@ -0,0 +1,44 @@
+#ifndef SPINE_HOST_PICO_STDLIB_H
+#define SPINE_HOST_PICO_STDLIB_H
+
+/*
+ * Host (Linux) stand-in for pico/stdlib.h: the subset of the Pico SDK the
+ * Spine uses, backed by host_hal. Selected with SPINE_PLATFORM=host.
+ * Host-only controls (virtual clock, device models, injected input) are
+ * in host_hal.h.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef unsigned int uint;
+
+#define PICO_OK             0
+#define PICO_ERROR_GENERIC (-1)
+#define PICO_ERROR_TIMEOUT (-2)
+
+#define PICO_DEFAULT_LED_PIN 25
+
+bool stdio_init_all(void);
+
+// Next byte of stdio input, or PICO_ERROR_TIMEOUT if none arrives in time.
+int getchar_timeout_us(uint32_t timeout_us);
+
+// Core running the caller: 0 for main(), 1 for multicore_launch_core1().
+uint get_core_num(void);
+
+static inline void tight_loop_contents(void) {}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPINE_HOST_PICO_STDLIB_H
@@ -0,0 +1,79 @@
+#ifndef SPINE_HOST_PICO_TIME_H
+#define SPINE_HOST_PICO_TIME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Host stand-in for pico/time.h and hardware/timer.h.
+ *
+ * Time is microseconds since process start (real clock) or a virtual
+ * clock advanced explicitly by host_clock_advance_us(). Alarm callbacks
+ * run as "IRQs": on a per-pool thread (real clock) or inside
+ * host_clock_advance_us() (virtual clock), in both cases holding the lock
+ * taken by save_and_disable_interrupts().
+ */
+
+typedef uint64_t absolute_time_t;
+
+static inline absolute_time_t from_us_since_boot(uint64_t us) { return us; }
+static inline uint64_t to_us_since_boot(absolute_time_t t) { return t; }
+
+uint64_t time_us_64(void);
+uint32_t time_us_32(void);
+absolute_time_t get_absolute_time(void);
+
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+
+typedef int32_t alarm_id_t;
+
+/*
+ * Return 0 to stop, <0 to re-fire that many us after the previous target,
+ * >0 to re-fire that many us after the callback returns.
+ */
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+typedef struct alarm_pool alarm_pool_t;
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+
+struct repeating_timer {
+    int64_t delay_us;
+    alarm_pool_t *pool;
+    alarm_id_t alarm_id;
+    repeating_timer_callback_t callback;
+    void *user_data;
+};
+
+alarm_pool_t *alarm_pool_create(unsigned int hardware_alarm_num, unsigned int max_timers);
+
+// >0: alarm id; 0: time already passed and !fire_if_past; -1: pool full.
+alarm_id_t alarm_pool_add_alarm_at(alarm_pool_t *pool, absolute_time_t time,
+                                   alarm_callback_t callback, void *user_data,
+                                   bool fire_if_past);
+alarm_id_t alarm_pool_add_alarm_in_us(alarm_pool_t *pool, uint64_t us,
+                                      alarm_callback_t callback, void *user_data,
+                                      bool fire_if_past);
+bool alarm_pool_cancel_alarm(alarm_pool_t *pool, alarm_id_t alarm_id);
+
+// delay_us < 0: start-to-start period; > 0: end-to-start.
+bool alarm_pool_add_repeating_timer_us(alarm_pool_t *pool, int64_t delay_us,
+                                       repeating_timer_callback_t callback,
+                                       void *user_data, repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
+
+// Default pool (created on first use).
+alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void *user_data, bool fire_if_past);
+alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past);
+bool cancel_alarm(alarm_id_t alarm_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPINE_HOST_PICO_TIME_H
@@ -0,0 +1,237 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define RASTER_BENCH_HAVE_TSC 1
+#endif
+
+extern "C" {
+#include "hardware/i2c.h"
+#include "ssd1306.h"
+#include "display_glyphs.h"
+}
+
+#include "ssd1306_emu.h"
+
+/*
+ * Host benchmark for the OLED framebuffer primitives.
+ *
+ * Each primitive is run ITERATIONS times on a 128x64 buffer; the report is
+ * nanoseconds and (on x86) TSC cycles per call. The pre-span per-pixel
+ * implementations are kept here as references so every run shows the
+ * speedup, and the span fills, blits and cached glyphs are checked for
+ * byte-identical output.
+ *
+ * Host numbers rank the kernels; absolute M0+ cost is several times
+ * higher and float math there is a software library call.
+ */
+
+static const uint32_t ITERATIONS    = 20000u;
+static const uint32_t DISPLAY_W     = 128u;
+static const uint32_t DISPLAY_H     = 64u;
+static const uint8_t  DISPLAY_ADDR  = 0x3C;
+static const uint64_t NS_PER_S      = 1000000000ull;
+
+static ssd1306_t disp;
+static host::Ssd1306Emu emu;
+
+static uint64_t now_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * NS_PER_S + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t now_cycles() {
+#if defined(RASTER_BENCH_HAVE_TSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// --- reference (per-pixel) implementations, as before the span kernels ---
+
+static void ref_draw_line_float(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    if(x1>x2) {
+        int32_t t=x1; x1=x2; x2=t;
+        t=y1; y1=y2; y2=t;
+    }
+    if(x1==x2) {
+        if(y1>y2) {
+            int32_t t=y1; y1=y2; y2=t;
+        }
+        for(int32_t i=y1; i<=y2; ++i)
+            ssd1306_draw_pixel(p, x1, i);
+        return;
+    }
+    float m=(float)(y2-y1)/(float)(x2-x1);
+    for(int32_t i=x1; i<=x2; ++i) {
+        float y=m*(float)(i-x1)+(float)y1;
+        ssd1306_draw_pixel(p, i, (uint32_t)y);
+    }
+}
+
+static void ref_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t w, uint32_t h) {
+    for(uint32_t i=0; i<w; ++i)
+        for(uint32_t j=0; j<h; ++j)
+            ssd1306_draw_pixel(p, x+i, y+j);
+}
+
+static void ref_clear_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t w, uint32_t h) {
+    for(uint32_t i=0; i<w; ++i)
+        for(uint32_t j=0; j<h; ++j)
+            ssd1306_clear_pixel(p, x+i, y+j);
+}
+
+static void ref_blit(ssd1306_t *p, uint32_t x, uint32_t y, const uint8_t *bitmap, uint32_t w, uint32_t pages) {
+    for(uint32_t bp=0; bp<pages; ++bp)
+        for(uint32_t i=0; i<w; ++i)
+            for(uint32_t bit=0; bit<8; ++bit)
+                if(bitmap[bp*w+i]&(1u<<bit))
+                    ssd1306_draw_pixel(p, x+i, y+bp*8+bit);
+}
+
+// --- cases ---
+
+static uint8_t sprite[2*32];
+
+static void case_line_diag()       { ssd1306_draw_line(&disp, 0, 0, 127, 63); }
+static void case_line_diag_ref()   { ref_draw_line_float(&disp, 0, 0, 127, 63); }
+static void case_hline()           { ssd1306_draw_line(&disp, 0, 21, 127, 21); }
+static void case_hline_ref()       { ref_draw_line_float(&disp, 0, 21, 127, 21); }
+static void case_vline()           { ssd1306_draw_line(&disp, 40, 0, 40, 63); }
+static void case_vline_ref()       { ref_draw_line_float(&disp, 40, 0, 40, 63); }
+static void case_rect()            { ssd1306_draw_square(&disp, 10, 5, 64, 32); }
+static void case_rect_ref()        { ref_draw_square(&disp, 10, 5, 64, 32); }
+static void case_clear_rect()      { ssd1306_clear_square(&disp, 10, 5, 64, 32); }
+static void case_clear_rect_ref()  { ref_clear_square(&disp, 10, 5, 64, 32); }
+static void case_frame()           { ssd1306_draw_empty_square(&disp, 3, 3, 100, 50); }
+static void case_blit_aligned()    { ssd1306_blit(&disp, 20, 16, sprite, 32, 2); }
+static void case_blit_aligned_ref(){ ref_blit(&disp, 20, 16, sprite, 32, 2); }
+static void case_blit_shifted()    { ssd1306_blit(&disp, 20, 19, sprite, 32, 2); }
+static void case_blit_shifted_ref(){ ref_blit(&disp, 20, 19, sprite, 32, 2); }
+static void case_string()          { ssd1306_draw_string(&disp, 25, 35, 1, "S2T ROVER"); }
+static void case_string_x2()       { ssd1306_draw_string(&disp, 20, 10, 2, "TITAN"); }
+static void case_cached_x1()       { ssd1306_draw_string_cached(&disp, 25, 35, &glyph_cache_font_8x5_x1, "S2T ROVER"); }
+static void case_cached_x2()       { ssd1306_draw_string_cached(&disp, 20, 10, &glyph_cache_font_8x5_x2, "TITAN"); }
+static void case_cached_x1_y40()   { ssd1306_draw_string_cached(&disp, 25, 40, &glyph_cache_font_8x5_x1, "S2T ROVER"); }
+static void case_string_x1_y40()   { ssd1306_draw_string(&disp, 25, 40, 1, "S2T ROVER"); }
+static void case_status_screen()   { ssd1306_clear(&disp); case_string_x2(); case_string(); }
+static void case_status_cached()   { ssd1306_clear(&disp); case_cached_x2(); case_cached_x1(); }
+
+struct BenchCase {
+    const char *name;
+    void (*run)();
+};
+
+static const BenchCase CASES[] = {
+    {"line_diag",        case_line_diag},
+    {"line_diag_ref",    case_line_diag_ref},
+    {"hline",            case_hline},
+    {"hline_ref",        case_hline_ref},
+    {"vline",            case_vline},
+    {"vline_ref",        case_vline_ref},
+    {"rect_64x32",       case_rect},
+    {"rect_64x32_ref",   case_rect_ref},
+    {"clear_64x32",      case_clear_rect},
+    {"clear_64x32_ref",  case_clear_rect_ref},
+    {"frame_100x50",     case_frame},
+    {"blit_32x16",       case_blit_aligned},
+    {"blit_32x16_ref",   case_blit_aligned_ref},
+    {"blit_32x16_y3",    case_blit_shifted},
+    {"blit_32x16_y3_ref",case_blit_shifted_ref},
+    {"string_x1",        case_string},
+    {"string_x2",        case_string_x2},
+    {"cached_x1",        case_cached_x1},
+    {"cached_x1_y40",    case_cached_x1_y40},
+    {"cached_x2",        case_cached_x2},
+    {"status_screen",    case_status_screen},
+    {"status_cached",    case_status_cached},
+};
+
+static void run_case(const BenchCase *c) {
+    ssd1306_clear(&disp);
+    c->run(); // warm
+
+    const uint64_t t0 = now_ns();
+    const uint64_t c0 = now_cycles();
+    for (uint32_t i = 0; i < ITERATIONS; ++i) {
+        c->run();
+    }
+    const uint64_t c1 = now_cycles();
+    const uint64_t t1 = now_ns();
+
+    printf("raster_bench.%s ns_per_op=%.1f cycles_per_op=%.0f\n",
+           c->name,
+           (double)(t1 - t0) / ITERATIONS,
+           (double)(c1 - c0) / ITERATIONS);
+}
+
+// Fast paths must produce exactly what the per-pixel loops produced.
+static uint32_t check_equivalence() {
+    static uint8_t expected[DISPLAY_W * DISPLAY_H / 8];
+    uint32_t mismatches = 0;
+
+    struct Pair { void (*fast)(); void (*ref)(); };
+    static const Pair PAIRS[] = {
+        {case_hline, case_hline_ref},
+        {case_vline, case_vline_ref},
+        {case_rect, case_rect_ref},
+        {case_blit_aligned, case_blit_aligned_ref},
+        {case_blit_shifted, case_blit_shifted_ref},
+        {case_cached_x1, case_string},
+        {case_cached_x1_y40, case_string_x1_y40},
+        {case_cached_x2, case_string_x2},
+    };
+
+    for (size_t i = 0; i < sizeof(PAIRS) / sizeof(PAIRS[0]); ++i) {
+        ssd1306_clear(&disp);
+        PAIRS[i].ref();
+        memcpy(expected, disp.buffer, disp.bufsize);
+
+        ssd1306_clear(&disp);
+        PAIRS[i].fast();
+        if (memcmp(expected, disp.buffer, disp.bufsize) != 0) {
+            mismatches++;
+        }
+    }
+
+    // Clearing: start from a full buffer and punch the same hole.
+    memset(disp.buffer, 0xFF, disp.bufsize);
+    case_clear_rect_ref();
+    memcpy(expected, disp.buffer, disp.bufsize);
+    memset(disp.buffer, 0xFF, disp.bufsize);
+    case_clear_rect();
+    if (memcmp(expected, disp.buffer, disp.bufsize) != 0) {
+        mismatches++;
+    }
+
+    return mismatches;
+}
+
+int main() {
+    host::ssd1306_emu_reset(&emu);
+    host::ssd1306_emu_attach(&emu, i2c0, DISPLAY_ADDR);
+
+    if (!ssd1306_init(&disp, DISPLAY_W, DISPLAY_H, DISPLAY_ADDR, i2c0)) {
+        fprintf(stderr, "raster_bench: ssd1306_init failed\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < sizeof(sprite); ++i) {
+        sprite[i] = (uint8_t)rand();
+    }
+
+    const uint32_t mismatches = check_equivalence();
+    printf("raster_bench.mismatch_count=%u\n", mismatches);
+
+    for (size_t i = 0; i < sizeof(CASES) / sizeof(CASES[0]); ++i) {
+        run_case(&CASES[i]);
+    }
+
+    ssd1306_deinit(&disp);
+    return mismatches == 0 ? 0 : 1;
+}
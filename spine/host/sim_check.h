@@ -0,0 +1,74 @@
+#ifndef SPINE_HOST_SIM_CHECK_H
+#define SPINE_HOST_SIM_CHECK_H
+
+#include <stdio.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "host_hal.h"
+#include "proto_framer.h"
+
+/*
+ * Harness shared by the host simulations (one translation unit each).
+ *
+ * Every result line is `<sim>.<check>=ok|FAIL`; sim::finish() prints
+ * `<sim>.failure_count=N` and returns the exit status, 0 only if every
+ * check held. open_link() points the CDC TX at a non-blocking pipe so
+ * read_back() can push whatever the Spine sent through its own framer.
+ */
+
+namespace sim {
+
+static const char* s_name = "sim";
+static uint32_t    s_failure_count = 0u;
+
+// Once, first thing in main(): the prefix of every result line.
+static inline void begin(const char* name) {
+    s_name = name;
+    s_failure_count = 0u;
+}
+
+static inline void check(const char* check_name, bool ok) {
+    printf("%s.%s=%s\n", s_name, check_name, ok ? "ok" : "FAIL");
+    if (!ok) {
+        s_failure_count++;
+    }
+}
+
+static inline int finish() {
+    printf("%s.failure_count=%lu\n", s_name, (unsigned long)s_failure_count);
+    return (s_failure_count == 0u) ? 0 : 1;
+}
+
+// CDC TX goes to a pipe; returns its read end, or -1.
+static inline int open_link() {
+    int link[2];
+    if (pipe(link) != 0 || fcntl(link[0], F_SETFL, O_NONBLOCK) != 0) {
+        fprintf(stderr, "%s: pipe failed\n", s_name);
+        return -1;
+    }
+    host_cdc_set_output_fd(link[1]);
+    return link[0];
+}
+
+// Frames everything the pipe holds; returns bytes read.
+static inline std::size_t read_back(int fd, proto::Framer* framer,
+                                    proto::FramerPacketCallback on_packet, void* ctx) {
+    uint8_t chunk[4096];
+    std::size_t total = 0u;
+    while (true) {
+        const ssize_t n = read(fd, chunk, sizeof(chunk));
+        if (n <= 0) {
+            return total;
+        }
+        proto::proto_framer_push(framer, chunk, static_cast<std::size_t>(n), on_packet, ctx);
+        total += static_cast<std::size_t>(n);
+    }
+}
+
+} // namespace sim
+
+#endif // SPINE_HOST_SIM_CHECK_H
@@ -0,0 +1,248 @@
+#include "ssd1306_emu.h"
+#include "host_hal.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace host {
+
+// Control byte (SSD1306 datasheet 8.1.5.2).
+static constexpr uint8_t CONTROL_CO_BIT = 0x80u;  // 1: one byte, then another control byte
+static constexpr uint8_t CONTROL_DC_BIT = 0x40u;  // 1: data, 0: command
+
+static constexpr uint8_t PGM_WHITE = 255u;
+static constexpr uint8_t PGM_BLACK = 0u;
+
+// Argument bytes that follow each multi-byte opcode.
+static uint8_t command_arg_count(uint8_t opcode) {
+    switch (opcode) {
+    case 0x20: // memory addressing mode
+    case 0x81: // contrast
+    case 0x8D: // charge pump
+    case 0xA8: // multiplex ratio
+    case 0xD3: // display offset
+    case 0xD5: // clock divide
+    case 0xD9: // pre-charge
+    case 0xDA: // COM pins
+    case 0xDB: // VCOMH deselect
+        return 1u;
+    case 0x21: // column address
+    case 0x22: // page address
+    case 0xA3: // vertical scroll area
+        return 2u;
+    case 0x29: // vertical + right scroll
+    case 0x2A: // vertical + left scroll
+        return 5u;
+    case 0x26: // right scroll
+    case 0x27: // left scroll
+        return 6u;
+    default:
+        return 0u;
+    }
+}
+
+void ssd1306_emu_reset(Ssd1306Emu* emu) {
+    std::memset(emu, 0, sizeof(*emu));
+    emu->address_mode = SSD1306_ADDR_PAGE;
+    emu->column_end = SSD1306_EMU_COLUMNS - 1u;
+    emu->page_end = SSD1306_EMU_PAGES - 1u;
+    emu->contrast = 0x7Fu;
+}
+
+static void apply_command(Ssd1306Emu* emu, uint8_t opcode, const uint8_t* args) {
+    emu->counters.command_count++;
+
+    switch (opcode) {
+    case 0x20:
+        emu->address_mode = args[0] & 0x03u;
+        return;
+    case 0x21:
+        emu->column_start = args[0] & 0x7Fu;
+        emu->column_end = args[1] & 0x7Fu;
+        emu->column = emu->column_start;
+        return;
+    case 0x22:
+        emu->page_start = args[0] & 0x07u;
+        emu->page_end = args[1] & 0x07u;
+        emu->page = emu->page_start;
+        return;
+    case 0x81:
+        emu->contrast = args[0];
+        return;
+    case 0xA0: case 0xA1:
+        emu->segment_remap = (opcode & 1u) != 0u;
+        return;
+    case 0xA4: case 0xA5:
+        emu->entire_on = (opcode & 1u) != 0u;
+        return;
+    case 0xA6: case 0xA7:
+        emu->inverted = (opcode & 1u) != 0u;
+        return;
+    case 0xAE: case 0xAF:
+        emu->display_on = (opcode & 1u) != 0u;
+        return;
+    case 0xC0: case 0xC8:
+        emu->com_reverse = opcode == 0xC8u;
+        return;
+    case 0x8D: case 0xA8: case 0xD3: case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+    case 0xA3: case 0x26: case 0x27: case 0x29: case 0x2A:
+    case 0x2E: case 0x2F: case 0xE3:
+        return; // timing, power, scrolling, NOP: no effect on GDDRAM
+    default:
+        break;
+    }
+
+    if (opcode >= 0x40u && opcode <= 0x7Fu) {
+        emu->start_line = opcode & 0x3Fu;
+    } else if (opcode <= 0x0Fu) {
+        // Page mode lower column nibble.
+        emu->column = static_cast<uint8_t>((emu->column & 0xF0u) | opcode);
+    } else if (opcode <= 0x1Fu) {
+        // Page mode upper column nibble.
+        emu->column = static_cast<uint8_t>(((opcode & 0x07u) << 4) | (emu->column & 0x0Fu));
+    } else if (opcode >= 0xB0u && opcode <= 0xB7u) {
+        emu->page = opcode & 0x07u;
+    } else {
+        emu->counters.unknown_command_count++;
+    }
+}
+
+static void command_byte(Ssd1306Emu* emu, uint8_t b) {
+    if (emu->pending_args_needed > 0u) {
+        emu->pending_args[emu->pending_args_count++] = b;
+        if (emu->pending_args_count == emu->pending_args_needed) {
+            apply_command(emu, emu->pending_opcode, emu->pending_args);
+            emu->pending_args_needed = 0u;
+            emu->pending_args_count = 0u;
+        }
+        return;
+    }
+
+    const uint8_t needed = command_arg_count(b);
+    if (needed == 0u) {
+        apply_command(emu, b, nullptr);
+        return;
+    }
+    emu->pending_opcode = b;
+    emu->pending_args_needed = needed;
+    emu->pending_args_count = 0u;
+}
+
+static void data_byte(Ssd1306Emu* emu, uint8_t b) {
+    emu->gddram[emu->page % SSD1306_EMU_PAGES][emu->column % SSD1306_EMU_COLUMNS] = b;
+    emu->counters.data_byte_count++;
+
+    switch (emu->address_mode) {
+    case SSD1306_ADDR_HORIZONTAL:
+        if (emu->column >= emu->column_end) {
+            emu->column = emu->column_start;
+            emu->page = (emu->page >= emu->page_end) ? emu->page_start
+                                                     : static_cast<uint8_t>(emu->page + 1u);
+        } else {
+            emu->column++;
+        }
+        break;
+    case SSD1306_ADDR_VERTICAL:
+        if (emu->page >= emu->page_end) {
+            emu->page = emu->page_start;
+            emu->column = (emu->column >= emu->column_end) ? emu->column_start
+                                                           : static_cast<uint8_t>(emu->column + 1u);
+        } else {
+            emu->page++;
+        }
+        break;
+    default:
+        // Page mode: column wraps within the page, page never advances.
+        emu->column = static_cast<uint8_t>((emu->column + 1u) % SSD1306_EMU_COLUMNS);
+        break;
+    }
+}
+
+std::size_t ssd1306_emu_write(Ssd1306Emu* emu, const uint8_t* bytes, std::size_t len) {
+    emu->counters.transaction_count++;
+    emu->counters.byte_count += static_cast<uint32_t>(len);
+
+    std::size_t i = 0;
+    while (i < len) {
+        const uint8_t control = bytes[i++];
+        const bool is_data = (control & CONTROL_DC_BIT) != 0u;
+
+        if (control & CONTROL_CO_BIT) {
+            // Exactly one byte follows, then another control byte.
+            if (i < len) {
+                is_data ? data_byte(emu, bytes[i]) : command_byte(emu, bytes[i]);
+                i++;
+            }
+            continue;
+        }
+
+        // Co=0: the rest of the transaction is one stream.
+        for (; i < len; ++i) {
+            is_data ? data_byte(emu, bytes[i]) : command_byte(emu, bytes[i]);
+        }
+    }
+
+    return len;
+}
+
+bool ssd1306_emu_pixel(const Ssd1306Emu* emu, uint32_t x, uint32_t y) {
+    if (!emu->display_on || x >= SSD1306_EMU_COLUMNS || y >= SSD1306_EMU_ROWS) {
+        return false;
+    }
+    const bool ram = emu->entire_on || ((emu->gddram[y >> 3][x] >> (y & 7u)) & 1u) != 0u;
+    return ram != emu->inverted;
+}
+
+bool ssd1306_emu_write_pgm(const Ssd1306Emu* emu,
+                           const char* path,
+                           uint32_t width,
+                           uint32_t height,
+                           uint32_t column_offset,
+                           uint32_t scale) {
+    if (path == nullptr || scale == 0u || width == 0u || height == 0u ||
+        column_offset + width > SSD1306_EMU_COLUMNS || height > SSD1306_EMU_ROWS) {
+        return false;
+    }
+
+    FILE* f = std::fopen(path, "wb");
+    if (f == nullptr) {
+        return false;
+    }
+
+    std::fprintf(f, "P5\n%u %u\n255\n", width * scale, height * scale);
+
+    uint8_t row[SSD1306_EMU_COLUMNS * SSD1306_EMU_MAX_PGM_SCALE];
+    const uint32_t row_len = width * scale;
+    bool ok = scale <= SSD1306_EMU_MAX_PGM_SCALE;
+
+    for (uint32_t y = 0; ok && y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            const uint8_t v = ssd1306_emu_pixel(emu, column_offset + x, y) ? PGM_WHITE : PGM_BLACK;
+            std::memset(row + x * scale, v, scale);
+        }
+        for (uint32_t s = 0; ok && s < scale; ++s) {
+            ok = std::fwrite(row, 1, row_len, f) == row_len;
+        }
+    }
+
+    return (std::fclose(f) == 0) && ok;
+}
+
+// Status byte (datasheet 8.1.5.1): D6 set while the display is off.
+static constexpr uint8_t STATUS_DISPLAY_OFF = 0x40u;
+
+static int emu_i2c_write(void* ctx, const uint8_t* src, std::size_t len) {
+    return static_cast<int>(ssd1306_emu_write(static_cast<Ssd1306Emu*>(ctx), src, len));
+}
+
+static int emu_i2c_read(void* ctx, uint8_t* dst, std::size_t len) {
+    const Ssd1306Emu* emu = static_cast<const Ssd1306Emu*>(ctx);
+    std::memset(dst, emu->display_on ? 0u : STATUS_DISPLAY_OFF, len);
+    return static_cast<int>(len);
+}
+
+bool ssd1306_emu_attach(Ssd1306Emu* emu, i2c_inst_t* i2c, uint8_t address) {
+    return host_i2c_attach(i2c, address, emu_i2c_write, emu_i2c_read, emu);
+}
+
+} // namespace host
@@ -0,0 +1,113 @@
+#ifndef SPINE_HOST_SSD1306_EMU_H
+#define SPINE_HOST_SSD1306_EMU_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "hardware/i2c.h"
+
+namespace host {
+
+/*
+ * SSD1306 controller emulator (host only).
+ *
+ * Consumes the same I2C write transactions the panel would see (control
+ * byte, then commands or data) and maintains the 128x8-page GDDRAM with
+ * the controller's addressing rules: horizontal / vertical / page mode,
+ * column and page windows, pointer wrap.
+ *
+ * Only what affects GDDRAM contents or what a frame looks like is
+ * modelled (addressing, display on/off, inversion, entire-on). Timing,
+ * scrolling and charge pump commands are parsed and counted, nothing more.
+ * Segment remap and COM scan direction are recorded but not applied: the
+ * driver configures them so the panel shows GDDRAM in reading order.
+ */
+
+static constexpr uint32_t SSD1306_EMU_COLUMNS = 128u;
+static constexpr uint32_t SSD1306_EMU_PAGES   = 8u;
+static constexpr uint32_t SSD1306_EMU_ROWS    = SSD1306_EMU_PAGES * 8u;
+
+// Longest command is a 6-argument scroll setup.
+static constexpr uint32_t SSD1306_EMU_MAX_ARGS = 6u;
+
+static constexpr uint32_t SSD1306_EMU_MAX_PGM_SCALE = 8u;
+
+enum Ssd1306AddressMode : uint8_t {
+    SSD1306_ADDR_HORIZONTAL = 0u,
+    SSD1306_ADDR_VERTICAL   = 1u,
+    SSD1306_ADDR_PAGE       = 2u,
+};
+
+struct Ssd1306Counters {
+    uint32_t transaction_count;   // I2C write transactions (start to stop)
+    uint32_t byte_count;          // bytes on the bus, control bytes included
+    uint32_t command_count;       // complete commands (opcode + arguments)
+    uint32_t data_byte_count;     // bytes written to GDDRAM
+    uint32_t unknown_command_count;
+};
+
+struct Ssd1306Emu {
+    uint8_t gddram[SSD1306_EMU_PAGES][SSD1306_EMU_COLUMNS];
+
+    // Addressing state.
+    uint8_t address_mode;
+    uint8_t column_start;
+    uint8_t column_end;
+    uint8_t page_start;
+    uint8_t page_end;
+    uint8_t column;
+    uint8_t page;
+
+    // Presentation state.
+    bool    display_on;
+    bool    inverted;
+    bool    entire_on;
+    uint8_t contrast;
+    uint8_t start_line;
+    bool    segment_remap;
+    bool    com_reverse;
+
+    // Multi-byte command in progress.
+    uint8_t pending_opcode;
+    uint8_t pending_args_needed;
+    uint8_t pending_args_count;
+    uint8_t pending_args[SSD1306_EMU_MAX_ARGS];
+
+    Ssd1306Counters counters;
+};
+
+// Power-on state: GDDRAM cleared, page addressing, display off.
+void ssd1306_emu_reset(Ssd1306Emu* emu);
+
+/*
+ * One I2C write transaction addressed to the panel.
+ * Returns the number of bytes accepted (always `len`, like an ACKing panel).
+ */
+std::size_t ssd1306_emu_write(Ssd1306Emu* emu, const uint8_t* bytes, std::size_t len);
+
+// Lit state of one panel pixel, after on/off, entire-on and inversion.
+bool ssd1306_emu_pixel(const Ssd1306Emu* emu, uint32_t x, uint32_t y);
+
+/*
+ * Write the visible `width` x `height` panel as a binary PGM (P5), each
+ * pixel enlarged to `scale` x `scale` (1..SSD1306_EMU_MAX_PGM_SCALE).
+ * `column_offset` selects the GDDRAM window a narrow panel shows (32 for
+ * 64-wide modules).
+ */
+bool ssd1306_emu_write_pgm(const Ssd1306Emu* emu,
+                           const char* path,
+                           uint32_t width,
+                           uint32_t height,
+                           uint32_t column_offset,
+                           uint32_t scale);
+
+/*
+ * Put the emulator on a host I2C bus at `address`, so the unmodified
+ * driver's i2c_write_blocking calls land in ssd1306_emu_write. Reads
+ * return the status byte (bus scans see the panel ACK).
+ */
+bool ssd1306_emu_attach(Ssd1306Emu* emu, i2c_inst_t* i2c, uint8_t address);
+
+} // namespace host
+
+#endif // SPINE_HOST_SSD1306_EMU_H
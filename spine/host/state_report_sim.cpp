@@ -0,0 +1,139 @@
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+#include "host_hal.h"
+#include "sim_check.h"
+#include "tusb.h"
+
+#include "proto_framer.h"
+#include "proto_wire.h"
+#include "spine_link_rx.h"
+#include "spine_safety.h"
+#include "spine_telemetry.h"
+
+/*
+ * S2B_STATE_REPORT streamer at 1 kHz on the virtual clock.
+ *
+ * Both task bodies are driven directly (snapshot, then report, once per
+ * period) and the CDC output is read back through the Spine's own framer:
+ *
+ *   1. link flowing for 1 s         -> 1000 reports, all valid, seq 0..999
+ *   2. host stops reading for 100 ms -> the TX FIFO takes a few frames,
+ *                                      the rest are dropped and counted;
+ *                                      no call ever waits
+ *   3. link back                    -> reports resume with a seq gap equal
+ *                                      to the drop count
+ *   4. three snapshots, one report  -> two counted as superseded
+ *
+ * Exit status is 0 only if every check holds.
+ */
+
+static constexpr uint32_t SIM_PERIOD_US       = spine::STATE_REPORT_MIN_PERIOD_US;
+static constexpr uint32_t FLOWING_PERIODS     = 1000u;
+static constexpr uint32_t STALLED_PERIODS     = 100u;
+static constexpr uint32_t RESUMED_PERIODS     = 10u;
+static constexpr std::size_t REPORT_FRAME_BYTES = proto::HEADER_SIZE_BYTES +
+    spine::STATE_REPORT_PAYLOAD_SIZE_BYTES + proto::TRAILER_SIZE_BYTES;
+
+struct ReadBack {
+    uint32_t report_count;
+    uint32_t layout_error_count;
+    uint32_t seq_gap_total;
+    uint32_t last_seq;
+    uint32_t last_snapshot_time_us;
+};
+
+static void on_report(const uint8_t* packet, std::size_t packet_len, void* ctx) {
+    ReadBack* rb = static_cast<ReadBack*>(ctx);
+    const uint8_t* payload = packet + proto::HEADER_SIZE_BYTES;
+
+    if (packet_len != REPORT_FRAME_BYTES ||
+        packet[proto::OFFSET_MSG_TYPE] != proto::MSG_ID_S2B_STATE_REPORT ||
+        payload[spine::STATE_REPORT_OFFSET_LAYOUT_VERSION] != spine::STATE_REPORT_LAYOUT_VERSION) {
+        rb->layout_error_count++;
+        return;
+    }
+
+    const uint32_t seq = proto::get_u16_le(packet + proto::OFFSET_SEQ);
+    if (rb->report_count > 0u) {
+        rb->seq_gap_total += ((seq - rb->last_seq) & 0xFFFFu) - 1u;
+    }
+    rb->last_seq = seq;
+    rb->last_snapshot_time_us = proto::get_u32_le(payload + spine::STATE_REPORT_OFFSET_SNAPSHOT_TIME_US);
+    rb->report_count++;
+}
+
+static void run_periods(uint32_t periods) {
+    for (uint32_t i = 0; i < periods; ++i) {
+        host_clock_advance_us(SIM_PERIOD_US);
+        spine::spine_telemetry_take_snapshot();
+        spine::spine_telemetry_send_report();
+    }
+}
+
+int main() {
+    sim::begin("state_report_sim");
+    host_stdio_set_input_fd(-1);
+    if (!host_clock_use_virtual()) {
+        fprintf(stderr, "state_report_sim: virtual clock unavailable\n");
+        return 1;
+    }
+
+    const int link_fd = sim::open_link();
+    if (link_fd < 0) {
+        return 1;
+    }
+
+    spine::spine_safety_init();
+    spine::spine_safety_mark_ready();
+
+    proto::Framer framer;
+    proto::proto_framer_init(&framer);
+    ReadBack rb{};
+    spine::TelemetryCounters c{};
+
+    // 1. Link flowing.
+    for (uint32_t i = 0; i < FLOWING_PERIODS; ++i) {
+        run_periods(1u);
+        sim::read_back(link_fd, &framer, on_report, &rb);
+    }
+    spine::spine_telemetry_get_counters(&c);
+    sim::check("flowing_sent", c.report_sent_count == FLOWING_PERIODS);
+    sim::check("flowing_valid", rb.report_count == FLOWING_PERIODS && rb.layout_error_count == 0u);
+    sim::check("flowing_no_drop", c.report_dropped_count == 0u && rb.seq_gap_total == 0u);
+    sim::check("snapshot_time", rb.last_snapshot_time_us == time_us_32());
+
+    // 2. Host stops reading.
+    host_cdc_set_tx_stalled(true);
+    const uint64_t stall_start_us = time_us_64();
+    run_periods(STALLED_PERIODS);
+    const uint64_t stall_elapsed_us = time_us_64() - stall_start_us;
+    spine::spine_telemetry_get_counters(&c);
+    const uint32_t fifo_frames = CFG_TUD_CDC_TX_BUFSIZE / REPORT_FRAME_BYTES;
+    sim::check("stalled_dropped", c.report_dropped_count == STALLED_PERIODS - fifo_frames);
+    sim::check("stalled_never_waits", stall_elapsed_us == STALLED_PERIODS * SIM_PERIOD_US);
+
+    // 3. Link back: the FIFO contents go out, then reports resume.
+    host_cdc_set_tx_stalled(false);
+    run_periods(RESUMED_PERIODS);
+    sim::read_back(link_fd, &framer, on_report, &rb);
+    spine::spine_telemetry_get_counters(&c);
+    sim::check("resumed_seq_gap", rb.seq_gap_total == c.report_dropped_count);
+    sim::check("resumed_all_valid",
+               rb.report_count == c.report_sent_count && rb.layout_error_count == 0u);
+
+    // 4. Snapshots faster than reports.
+    const uint32_t superseded_before = c.report_superseded_count;
+    spine::spine_telemetry_take_snapshot();
+    spine::spine_telemetry_take_snapshot();
+    spine::spine_telemetry_take_snapshot();
+    spine::spine_telemetry_send_report();
+    spine::spine_telemetry_get_counters(&c);
+    sim::check("superseded", c.report_superseded_count - superseded_before == 2u);
+    sim::check("torn", c.snapshot_torn_count == 0u);
+
+    printf("state_report_sim.report_sent_count=%lu\n", (unsigned long)c.report_sent_count);
+    printf("state_report_sim.report_dropped_count=%lu\n", (unsigned long)c.report_dropped_count);
+    printf("state_report_sim.cdc_tx_bytes=%llu\n", (unsigned long long)host_cdc_tx_byte_count());
+    return sim::finish();
+}
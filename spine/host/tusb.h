@@ -0,0 +1,48 @@
+#ifndef SPINE_HOST_TUSB_H
+#define SPINE_HOST_TUSB_H
+
+/*
+ * Host (Linux) stand-in for the TinyUSB CDC device calls the Spine uses.
+ * FIFO sizes come from the firmware's tusb_config.h.
+ *
+ * The TX FIFO has CFG_TUD_CDC_TX_BUFSIZE bytes. A flush delivers its
+ * contents to the host output fd unless the host side is stalled
+ * (host_cdc_set_tx_stalled), in which case the FIFO stays full, like a
+ * USB host that stopped reading.
+ *
+ * RX: bytes from the USB host side (the input fd, stdin by default, read
+ * by a thread that tusb_init() starts; or host_cdc_push_rx()) wait as
+ * un-received OUT packets. tud_task() moves them one CDC packet at a time
+ * into a FIFO of CFG_TUD_CDC_RX_BUFSIZE and calls tud_cdc_rx_cb() in the
+ * caller's context, the way TinyUSB does when an OUT transfer completes.
+ * As on the RP2040, nothing arrives unless someone runs tud_task().
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "tusb_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+bool     tusb_init(void);
+void     tud_task(void);
+
+bool     tud_cdc_connected(void);
+uint32_t tud_cdc_write_available(void);
+uint32_t tud_cdc_write(void const *buffer, uint32_t bufsize);
+uint32_t tud_cdc_write_flush(void);
+
+uint32_t tud_cdc_available(void);
+uint32_t tud_cdc_read(void *buffer, uint32_t bufsize);
+
+// Application callback, weak as in TinyUSB.
+void tud_cdc_rx_cb(uint8_t itf) __attribute__((weak));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPINE_HOST_TUSB_H
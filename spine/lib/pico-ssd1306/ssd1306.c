@@ -30,22 +30,35 @@ SOFTWARE.
 #include <string.h>
 #include <stdio.h>
 
+#ifdef SSD1306_DMA
+#include <hardware/dma.h>
+#endif
+
 #include "ssd1306.h"
 #include "font.h"
 
-inline static void swap(int32_t *a, int32_t *b) {
-    int32_t *t=a;
-    *a=*b;
-    *b=*t;
-}
-
-inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, char *name) {
-    switch(i2c_write_blocking(i2c, addr, src, len, false)) {
+/* With SPINE_LOG_ENABLED the errors go to the Spine's deferred-format log: no
+ * formatting and no USB from the display path. The log takes integers
+ * only, so the caller name becomes the transfer length. */
+#ifdef SPINE_LOG_ENABLED
+#include "spine_log.h"
+#define SSD1306_REPORT_NACK(name, len)    SPINE_LOG("ssd1306: addr not acknowledged (len=%u)", (len))
+#define SSD1306_REPORT_TIMEOUT(name, len) SPINE_LOG("ssd1306: i2c timeout (len=%u)", (len))
+#else
+#define SSD1306_REPORT_NACK(name, len)    printf("[%s] addr not acknowledged!\n", (name))
+#define SSD1306_REPORT_TIMEOUT(name, len) printf("[%s] timeout!\n", (name))
+#endif
+
+inline static void fancy_write(ssd1306_t *p, const uint8_t *src, size_t len, char *name) {
+    ++p->i2c_transfer_count;
+    p->i2c_byte_count+=len;
+
+    switch(i2c_write_blocking(p->i2c_i, p->address, src, len, false)) {
     case PICO_ERROR_GENERIC:
-        printf("[%s] addr not acknowledged!\n", name);
+        SSD1306_REPORT_NACK(name, len);
         break;
     case PICO_ERROR_TIMEOUT:
-        printf("[%s] timeout!\n", name);
+        SSD1306_REPORT_TIMEOUT(name, len);
         break;
     default:
         //printf("[%s] wrote successfully %lu bytes!\n", name, len);
@@ -55,7 +68,43 @@ inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src
 
 inline static void ssd1306_write(ssd1306_t *p, uint8_t val) {
     uint8_t d[2]= {0x00, val};
-    fancy_write(p->i2c_i, p->address, d, 2, "ssd1306_write");
+    fancy_write(p, d, 2, "ssd1306_write");
+}
+
+inline void ssd1306_cmd_begin(ssd1306_cmd_buf_t *b) {
+    b->bytes[0]=0x00; // Co=0, D/C#=0: every following byte is a command
+    b->len=0;
+}
+
+inline bool ssd1306_cmd_push(ssd1306_cmd_buf_t *b, uint8_t cmd) {
+    if(b->len>=SSD1306_CMD_BUF_SIZE)
+        return false;
+    b->bytes[1+b->len++]=cmd;
+    return true;
+}
+
+void ssd1306_cmd_send(ssd1306_t *p, ssd1306_cmd_buf_t *b) {
+    if(b->len==0)
+        return;
+    fancy_write(p, b->bytes, 1+b->len, "ssd1306_cmd_send");
+    b->len=0;
+}
+
+inline static void ssd1306_mark_dirty(ssd1306_t *p, uint32_t x, uint32_t page) {
+    if(x<p->dirty_x0[page]) p->dirty_x0[page]=x;
+    if(x>p->dirty_x1[page]) p->dirty_x1[page]=x;
+}
+
+inline static void ssd1306_mark_all_dirty(ssd1306_t *p) {
+    for(uint8_t i=0; i<p->pages; ++i) {
+        p->dirty_x0[i]=0;
+        p->dirty_x1[i]=p->width-1;
+    }
+}
+
+inline static void ssd1306_mark_all_clean(ssd1306_t *p) {
+    memset(p->dirty_x0, 0xff, sizeof(p->dirty_x0));
+    memset(p->dirty_x1, 0x00, sizeof(p->dirty_x1));
 }
 
 bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance) {
@@ -64,8 +113,20 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
     p->pages=height/8;
     p->address=address;
 
+    if(p->pages>SSD1306_MAX_PAGES)
+        return false;
+
     p->i2c_i=i2c_instance;
 
+    p->dma_chan=-1;
+    p->stream=NULL;
+    p->stream_cap=0;
+    p->async_busy=false;
+    p->async_busy_count=0;
+    p->async_error_count=0;
+    p->i2c_transfer_count=0;
+    p->i2c_byte_count=0;
+
 
     p->bufsize=(p->pages)*(p->width);
     if((p->buffer=malloc(p->bufsize+1))==NULL) {
@@ -75,6 +136,14 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 
     ++(p->buffer);
 
+    if((p->shadow=malloc(p->bufsize))==NULL) {
+        free(p->buffer-1);
+        p->bufsize=0;
+        return false;
+    }
+    p->shadow_valid=false;
+    ssd1306_mark_all_clean(p);
+
     // from https://github.com/makerportal/rpi-pico-ssd1306
     uint8_t cmds[]= {
         SET_DISP,
@@ -109,14 +178,26 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
         0x00,  // horizontal
     };
 
+    ssd1306_cmd_buf_t b;
+    ssd1306_cmd_begin(&b);
     for(size_t i=0; i<sizeof(cmds); ++i)
-        ssd1306_write(p, cmds[i]);
+        ssd1306_cmd_push(&b, cmds[i]);
+    ssd1306_cmd_send(p, &b);
 
     return true;
 }
 
 inline void ssd1306_deinit(ssd1306_t *p) {
+#ifdef SSD1306_DMA
+    if(p->dma_chan>=0) {
+        dma_channel_abort(p->dma_chan);
+        dma_channel_unclaim(p->dma_chan);
+        p->dma_chan=-1;
+    }
+#endif
+    free(p->stream);
     free(p->buffer-1);
+    free(p->shadow);
 }
 
 inline void ssd1306_poweroff(ssd1306_t *p) {
@@ -128,8 +209,11 @@ inline void ssd1306_poweron(ssd1306_t *p) {
 }
 
 inline void ssd1306_contrast(ssd1306_t *p, uint8_t val) {
-    ssd1306_write(p, SET_CONTRAST);
-    ssd1306_write(p, val);
+    ssd1306_cmd_buf_t b;
+    ssd1306_cmd_begin(&b);
+    ssd1306_cmd_push(&b, SET_CONTRAST);
+    ssd1306_cmd_push(&b, val);
+    ssd1306_cmd_send(p, &b);
 }
 
 inline void ssd1306_invert(ssd1306_t *p, uint8_t inv) {
@@ -138,52 +222,140 @@ inline void ssd1306_invert(ssd1306_t *p, uint8_t inv) {
 
 inline void ssd1306_clear(ssd1306_t *p) {
     memset(p->buffer, 0, p->bufsize);
+    ssd1306_mark_all_dirty(p);
 }
 
 void ssd1306_clear_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
     if(x>=p->width || y>=p->height) return;
 
     p->buffer[x+p->width*(y>>3)]&=~(0x1<<(y&0x07));
+    ssd1306_mark_dirty(p, x, y>>3);
 }
 
 void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
     if(x>=p->width || y>=p->height) return;
 
     p->buffer[x+p->width*(y>>3)]|=0x1<<(y&0x07); // y>>3==y/8 && y&0x7==y%8
+    ssd1306_mark_dirty(p, x, y>>3);
 }
 
-void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
-    if(x1>x2) {
-        swap(&x1, &x2);
-        swap(&y1, &y2);
+/*
+	sets (or clears) a clipped rectangle one page byte at a time: every
+	column of a page gets the same row mask, so an 8-row band is one OR
+*/
+static void ssd1306_fill_span(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool set) {
+    if(x>=p->width || y>=p->height || width==0 || height==0) return;
+    if(width>p->width-x) width=p->width-x;
+    if(height>p->height-y) height=p->height-y;
+
+    const uint32_t y_last=y+height-1;
+    const uint32_t page_first=y>>3;
+    const uint32_t page_last=y_last>>3;
+
+    for(uint32_t page=page_first; page<=page_last; ++page) {
+        const uint32_t top=page==page_first?(y&7):0;
+        const uint32_t bottom=page==page_last?(y_last&7):7;
+        const uint8_t mask=(uint8_t)((0xFFu<<top)&(0xFFu>>(7-bottom)));
+
+        uint8_t *dst=p->buffer+page*p->width+x;
+        if(set) {
+            for(uint32_t i=0; i<width; ++i)
+                dst[i]|=mask;
+        } else {
+            for(uint32_t i=0; i<width; ++i)
+                dst[i]&=(uint8_t)~mask;
+        }
+
+        ssd1306_mark_dirty(p, x, page);
+        ssd1306_mark_dirty(p, x+width-1, page);
     }
+}
+
+void ssd1306_draw_hline(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t len) {
+    ssd1306_fill_span(p, x, y, len, 1, true);
+}
 
-    if(x1==x2) {
-        if(y1>y2)
-            swap(&y1, &y2);
-        for(int32_t i=y1; i<=y2; ++i)
-            ssd1306_draw_pixel(p, x1, i);
+void ssd1306_draw_vline(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t len) {
+    ssd1306_fill_span(p, x, y, 1, len, true);
+}
+
+void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    if(y1==y2 || x1==x2) {
+        int32_t xa=x1<x2?x1:x2, xb=x1<x2?x2:x1;
+        int32_t ya=y1<y2?y1:y2, yb=y1<y2?y2:y1;
+        if(xb<0 || yb<0) return;
+        if(xa<0) xa=0;
+        if(ya<0) ya=0;
+        ssd1306_fill_span(p, xa, ya, xb-xa+1, yb-ya+1, true);
         return;
     }
 
-    float m=(float) (y2-y1) / (float) (x2-x1);
+    // integer bresenham, all octants; dx+dy+1 iterations at most
+    const int32_t dx=abs(x2-x1), sx=x1<x2?1:-1;
+    const int32_t dy=-abs(y2-y1), sy=y1<y2?1:-1;
+    int32_t err=dx+dy;
 
-    for(int32_t i=x1; i<=x2; ++i) {
-        float y=m*(float) (i-x1)+(float) y1;
-        ssd1306_draw_pixel(p, i, (uint32_t) y);
+    for(;;) {
+        ssd1306_draw_pixel(p, (uint32_t)x1, (uint32_t)y1); // negative wraps and is clipped
+        if(x1==x2 && y1==y2)
+            break;
+        const int32_t e2=2*err;
+        if(e2>=dy) {
+            err+=dy;
+            x1+=sx;
+        }
+        if(e2<=dx) {
+            err+=dx;
+            y1+=sy;
+        }
     }
 }
 
 void ssd1306_clear_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_clear_pixel(p, x+i, y+j);
+    ssd1306_fill_span(p, x, y, width, height, false);
 }
 
 void ssd1306_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_draw_pixel(p, x+i, y+j);
+    ssd1306_fill_span(p, x, y, width, height, true);
+}
+
+void ssd1306_blit(ssd1306_t *p, uint32_t x, uint32_t y, const uint8_t *bitmap, uint32_t width, uint32_t pages) {
+    if(x>=p->width || y>=p->height || width==0 || pages==0) return;
+
+    const uint32_t stride=width;
+    if(width>p->width-x) width=p->width-x;
+
+    const uint32_t shift=y&7;
+    const uint32_t page_first=y>>3;
+
+    for(uint32_t bp=0; bp<pages; ++bp) {
+        const uint32_t page=page_first+bp;
+        if(page>=p->pages)
+            break;
+
+        const uint8_t *src=bitmap+bp*stride;
+        uint8_t *dst=p->buffer+page*p->width+x;
+
+        if(shift==0) {
+            for(uint32_t i=0; i<width; ++i)
+                dst[i]|=src[i];
+        } else {
+            // each source byte straddles this page and the next
+            uint8_t *next=page+1<p->pages?dst+p->width:NULL;
+            for(uint32_t i=0; i<width; ++i) {
+                dst[i]|=(uint8_t)(src[i]<<shift);
+                if(next)
+                    next[i]|=(uint8_t)(src[i]>>(8-shift));
+            }
+            if(next) {
+                ssd1306_mark_dirty(p, x, page+1);
+                ssd1306_mark_dirty(p, x+width-1, page+1);
+            }
+        }
+
+        ssd1306_mark_dirty(p, x, page);
+        ssd1306_mark_dirty(p, x+width-1, page);
+    }
 }
 
 void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
@@ -227,6 +399,14 @@ void ssd1306_draw_string(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, c
     ssd1306_draw_string_with_font(p, x, y, scale, font_8x5, s);
 }
 
+void ssd1306_draw_string_cached(ssd1306_t *p, uint32_t x, uint32_t y, const ssd1306_glyph_cache_t *cache, const char *s) {
+    for(uint32_t x_n=x; *s && x_n<p->width; x_n+=cache->advance, ++s) {
+        if(*s<cache->first||*s>cache->last)
+            continue;
+        ssd1306_blit(p, x_n, y, cache->bitmaps+(uint32_t)(*s-cache->first)*cache->glyph_size, cache->width, cache->pages);
+    }
+}
+
 static inline uint32_t ssd1306_bmp_get_val(const uint8_t *data, const size_t offset, uint8_t size) {
     switch(size) {
     case 1:
@@ -290,17 +470,220 @@ inline void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long
     ssd1306_bmp_show_image_with_offset(p, data, size, 0, 0);
 }
 
+typedef struct {
+    uint8_t page0, page1, x0, x1;
+} ssd1306_window_t;
+
+/*
+	collects the windows that must be sent to bring the display in line
+	with the buffer, updates the shadow as if they were sent and marks
+	every page clean. returns the number of windows (at most pages).
+*/
+static uint8_t ssd1306_take_windows(ssd1306_t *p, ssd1306_window_t *w) {
+    uint8_t n=0;
+
+    if(!p->shadow_valid) {
+        w[n++]=(ssd1306_window_t) {0, p->pages-1, 0, p->width-1};
+        memcpy(p->shadow, p->buffer, p->bufsize);
+        p->shadow_valid=true;
+        ssd1306_mark_all_clean(p);
+        return n;
+    }
+
+    for(uint8_t page=0; page<p->pages; ++page) {
+        if(p->dirty_x0[page]>p->dirty_x1[page])
+            continue;
+
+        // shrink the touched range to the bytes that actually differ from
+        // what the display holds (clear + redraw of the same text sends nothing)
+        const uint8_t *row=p->buffer+page*p->width;
+        uint8_t *shadow_row=p->shadow+page*p->width;
+        int32_t x0=p->dirty_x0[page];
+        int32_t x1=p->dirty_x1[page];
+
+        while(x0<=x1 && row[x0]==shadow_row[x0]) ++x0;
+        while(x1>=x0 && row[x1]==shadow_row[x1]) --x1;
+
+        if(x0<=x1) {
+            w[n++]=(ssd1306_window_t) {page, page, (uint8_t)x0, (uint8_t)x1};
+            memcpy(shadow_row+x0, row+x0, (size_t)(x1-x0+1));
+        }
+    }
+
+    ssd1306_mark_all_clean(p);
+    return n;
+}
+
+inline static void ssd1306_window_cmds(const ssd1306_t *p, const ssd1306_window_t *w, ssd1306_cmd_buf_t *b) {
+    const uint8_t col_offset=p->width==64?32:0;
+
+    ssd1306_cmd_begin(b);
+    ssd1306_cmd_push(b, SET_COL_ADDR);
+    ssd1306_cmd_push(b, w->x0+col_offset);
+    ssd1306_cmd_push(b, w->x1+col_offset);
+    ssd1306_cmd_push(b, SET_PAGE_ADDR);
+    ssd1306_cmd_push(b, w->page0);
+    ssd1306_cmd_push(b, w->page1);
+}
+
+inline static uint8_t *ssd1306_window_start(const ssd1306_t *p, const ssd1306_window_t *w) {
+    return p->buffer+w->page0*p->width+w->x0;
+}
+
+inline static size_t ssd1306_window_len(const ssd1306_t *p, const ssd1306_window_t *w) {
+    return (size_t)(w->page1-w->page0)*p->width+(w->x1-w->x0)+1;
+}
+
+static void ssd1306_show_window(ssd1306_t *p, const ssd1306_window_t *w) {
+    ssd1306_cmd_buf_t b;
+    ssd1306_window_cmds(p, w, &b);
+    ssd1306_cmd_send(p, &b);
+
+    // the data control byte goes in front of the window; the byte it
+    // borrows (previous column, or the spare byte before the buffer) is
+    // put back afterwards
+    uint8_t *start=ssd1306_window_start(p, w);
+    const uint8_t saved=*(start-1);
+    *(start-1)=0x40;
+
+    fancy_write(p, start-1, ssd1306_window_len(p, w)+1, "ssd1306_show");
+
+    *(start-1)=saved;
+}
+
+void ssd1306_invalidate(ssd1306_t *p) {
+    p->shadow_valid=false;
+}
+
 void ssd1306_show(ssd1306_t *p) {
-    uint8_t payload[]= {SET_COL_ADDR, 0, p->width-1, SET_PAGE_ADDR, 0, p->pages-1};
-    if(p->width==64) {
-        payload[1]+=32;
-        payload[2]+=32;
+    ssd1306_window_t w[SSD1306_MAX_PAGES];
+    const uint8_t n=ssd1306_take_windows(p, w);
+
+    for(uint8_t i=0; i<n; ++i)
+        ssd1306_show_window(p, &w[i]);
+}
+
+#ifdef SSD1306_DMA
+
+/*
+	the whole refresh is one DMA stream of IC_DATA_CMD words. a STOP bit on
+	the last word of each transaction makes the controller issue a new
+	START for the next one, so commands and data windows go out back to
+	back without the CPU.
+*/
+inline static size_t ssd1306_stream_put(uint16_t *s, size_t n, uint8_t control, const uint8_t *src, size_t len) {
+    s[n++]=control;
+    for(size_t i=0; i<len; ++i)
+        s[n++]=src[i];
+    s[n-1]|=I2C_IC_DATA_CMD_STOP_BITS;
+    return n;
+}
+
+bool ssd1306_async_init(ssd1306_t *p) {
+    if(p->bufsize==0 || p->dma_chan>=0)
+        return false;
+
+    // worst case: one full-buffer window, or one window per page
+    p->stream_cap=p->bufsize+SSD1306_MAX_PAGES*(1+6+1);
+    if((p->stream=malloc(p->stream_cap*sizeof(uint16_t)))==NULL)
+        return false;
+
+    const int chan=dma_claim_unused_channel(false);
+    if(chan<0) {
+        free(p->stream);
+        p->stream=NULL;
+        return false;
+    }
+
+    dma_channel_config c=dma_channel_get_default_config(chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(p->i2c_i, true));
+    dma_channel_configure(chan, &c, &i2c_get_hw(p->i2c_i)->data_cmd, p->stream, 0, false);
+
+    p->dma_chan=chan;
+    return true;
+}
+
+ssd1306_async_status_t ssd1306_async_poll(ssd1306_t *p) {
+    if(!p->async_busy)
+        return SSD1306_ASYNC_IDLE;
+
+    i2c_hw_t *hw=i2c_get_hw(p->i2c_i);
+
+    if(hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        // stop feeding the flushed FIFO before releasing it from abort
+        dma_channel_abort(p->dma_chan);
+        (void)hw->clr_tx_abrt;
+        p->async_busy=false;
+        ++p->async_error_count;
+        // whatever reached the panel is unknown now
+        p->shadow_valid=false;
+        return SSD1306_ASYNC_ERROR;
+    }
+
+    if(dma_channel_is_busy(p->dma_chan)
+            || !(hw->status & I2C_IC_STATUS_TFE_BITS)
+            || (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS))
+        return SSD1306_ASYNC_BUSY;
+
+    p->async_busy=false;
+    return SSD1306_ASYNC_IDLE;
+}
+
+bool ssd1306_show_async(ssd1306_t *p) {
+    if(p->dma_chan<0) {
+        ssd1306_show(p);
+        return true;
     }
 
-    for(size_t i=0; i<sizeof(payload); ++i)
-        ssd1306_write(p, payload[i]);
+    if(ssd1306_async_poll(p)==SSD1306_ASYNC_BUSY) {
+        ++p->async_busy_count;
+        return false;
+    }
+
+    ssd1306_window_t w[SSD1306_MAX_PAGES];
+    const uint8_t nw=ssd1306_take_windows(p, w);
+    if(nw==0)
+        return true;
+
+    size_t n=0;
+    for(uint8_t i=0; i<nw; ++i) {
+        ssd1306_cmd_buf_t b;
+        ssd1306_window_cmds(p, &w[i], &b);
+        n=ssd1306_stream_put(p->stream, n, b.bytes[0], b.bytes+1, b.len);
+        n=ssd1306_stream_put(p->stream, n, 0x40, ssd1306_window_start(p, &w[i]), ssd1306_window_len(p, &w[i]));
+    }
 
-    *(p->buffer-1)=0x40;
+    p->i2c_transfer_count+=2*nw;
+    p->i2c_byte_count+=n;
 
-    fancy_write(p->i2c_i, p->address, p->buffer-1, p->bufsize+1, "ssd1306_show");
+    i2c_hw_t *hw=i2c_get_hw(p->i2c_i);
+    hw->enable=0;
+    hw->tar=p->address;
+    hw->enable=1;
+
+    p->async_busy=true;
+    dma_channel_transfer_from_buffer_now(p->dma_chan, p->stream, n);
+    return true;
 }
+
+#else
+
+bool ssd1306_async_init(ssd1306_t *p) {
+    (void)p;
+    return false;
+}
+
+ssd1306_async_status_t ssd1306_async_poll(ssd1306_t *p) {
+    (void)p;
+    return SSD1306_ASYNC_IDLE;
+}
+
+bool ssd1306_show_async(ssd1306_t *p) {
+    ssd1306_show(p);
+    return true;
+}
+
+#endif
@@ -56,6 +56,50 @@ typedef enum {
     SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+/**
+*	@brief maximum number of 8-pixel pages (ssd1306 drives at most 64 rows)
+*/
+#define SSD1306_MAX_PAGES 8
+
+/**
+*	@brief capacity of a command buffer (longest sequence is ssd1306_init)
+*/
+#define SSD1306_CMD_BUF_SIZE 32
+
+/**
+*	@brief command bytes collected for a single i2c transaction
+*/
+typedef struct {
+    uint8_t bytes[1+SSD1306_CMD_BUF_SIZE];	/**< control byte followed by the commands */
+    uint8_t len;	/**< number of queued commands */
+} ssd1306_cmd_buf_t;
+
+/**
+*	@brief font pre-rasterized at one scale into display byte format
+
+	Generated by tools/glyphcache from a font in the format described in
+	README.md. Each glyph is `pages` rows of `width` column bytes (the
+	layout ssd1306_blit takes), so drawing text is a sequence of byte ORs.
+*/
+typedef struct {
+    uint8_t width;		/**< glyph width in pixels (scaled) */
+    uint8_t pages;		/**< glyph height in 8-pixel pages (scaled) */
+    uint8_t advance;	/**< x step from one glyph to the next (scaled width + spacing) */
+    char first;			/**< first character stored */
+    char last;			/**< last character stored */
+    uint16_t glyph_size;	/**< bytes per glyph (width*pages) */
+    const uint8_t *bitmaps;	/**< glyphs first..last, glyph_size bytes each */
+} ssd1306_glyph_cache_t;
+
+/**
+*	@brief state of the asynchronous (DMA) refresh
+*/
+typedef enum {
+    SSD1306_ASYNC_IDLE,		/**< nothing in flight, next ssd1306_show_async starts immediately */
+    SSD1306_ASYNC_BUSY,		/**< previous frame still on the bus */
+    SSD1306_ASYNC_ERROR,	/**< previous frame aborted (NACK); next refresh is a full one */
+} ssd1306_async_status_t;
+
 /**
 *	@brief holds the configuration
 */
@@ -68,6 +112,18 @@ typedef struct {
     bool external_vcc; 	/**< whether display uses external vcc */ 
     uint8_t *buffer;	/**< display buffer */
     size_t bufsize;		/**< buffer size */
+    uint8_t *shadow;	/**< copy of what the display GDDRAM currently holds */
+    bool shadow_valid;	/**< false until the first full refresh (or after ssd1306_invalidate) */
+    uint8_t dirty_x0[SSD1306_MAX_PAGES];	/**< first touched column per page (dirty_x0>dirty_x1: page clean) */
+    uint8_t dirty_x1[SSD1306_MAX_PAGES];	/**< last touched column per page */
+    int dma_chan;		/**< DMA channel of the async refresh, -1 when not in use */
+    uint16_t *stream;	/**< IC_DATA_CMD words of the frame in flight */
+    size_t stream_cap;	/**< capacity of stream in words */
+    volatile bool async_busy;	/**< a frame has been handed to DMA and not yet polled complete */
+    uint32_t async_busy_count;	/**< ssd1306_show_async calls refused because a frame was in flight */
+    uint32_t async_error_count;	/**< async frames aborted by the i2c controller */
+    uint32_t i2c_transfer_count;	/**< i2c transactions issued (start to stop) */
+    uint32_t i2c_byte_count;	/**< bytes issued, control bytes included */
 } ssd1306_t;
 
 /**
@@ -130,11 +186,91 @@ void ssd1306_invert(ssd1306_t *p, uint8_t inv);
 /**
 	@brief display buffer, should be called on change
 
+	Only pages touched since the last call are considered, and within each
+	page only the column window that differs from what the display already
+	holds is sent. The first call after init (or ssd1306_invalidate) sends
+	the whole buffer.
+
 	@param[in] p : instance of display
 
 */
 void ssd1306_show(ssd1306_t *p);
 
+/**
+	@brief force the next ssd1306_show to send the whole buffer
+
+	Use when the display GDDRAM may no longer match what was last sent
+	(e.g. after the panel was power cycled or reset).
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_invalidate(ssd1306_t *p);
+
+/**
+	@brief start a command sequence
+
+	Commands pushed into the buffer are sent as one i2c transaction
+	(one start, address and stop) instead of one transaction per byte.
+
+	@param[out] b : command buffer
+*/
+void ssd1306_cmd_begin(ssd1306_cmd_buf_t *b);
+
+/**
+	@brief append one command (or command argument) byte
+
+	@param[in] b : command buffer
+	@param[in] cmd : command byte
+
+	@return false if the buffer is full (byte dropped)
+*/
+bool ssd1306_cmd_push(ssd1306_cmd_buf_t *b, uint8_t cmd);
+
+/**
+	@brief send the queued commands as a single transaction and empty the buffer
+
+	@param[in] p : instance of display
+	@param[in] b : command buffer
+*/
+void ssd1306_cmd_send(ssd1306_t *p, ssd1306_cmd_buf_t *b);
+
+/**
+	@brief enable the non-blocking refresh path
+
+	Claims a DMA channel paced by the i2c TX DREQ and allocates the
+	transfer stream. Only available when built with SSD1306_DMA; otherwise
+	returns false and ssd1306_show_async behaves like ssd1306_show.
+
+	@param[in] p : instance of display (after ssd1306_init)
+
+	@return true on success
+*/
+bool ssd1306_async_init(ssd1306_t *p);
+
+/**
+	@brief start sending the buffer and return without waiting
+
+	The changed windows are copied into the transfer stream before this
+	returns, so drawing into the buffer may continue immediately. While a
+	frame is in flight the i2c instance must not be used by anyone else
+	(including the blocking functions of this driver).
+
+	@param[in] p : instance of display
+
+	@return false if the previous frame is still in flight (nothing queued)
+*/
+bool ssd1306_show_async(ssd1306_t *p);
+
+/**
+	@brief check on the frame in flight
+
+	@param[in] p : instance of display
+
+	@return SSD1306_ASYNC_IDLE once the last byte has left the controller
+*/
+ssd1306_async_status_t ssd1306_async_poll(ssd1306_t *p);
+
 /**
 	@brief clear display buffer
 
@@ -172,6 +308,43 @@ void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y);
 */
 void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2);
 
+/**
+	@brief draw horizontal line (one page byte OR per column)
+
+	@param[in] p : instance of display
+	@param[in] x : x position of starting point
+	@param[in] y : y position of line
+	@param[in] len : length in pixels
+*/
+void ssd1306_draw_hline(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t len);
+
+/**
+	@brief draw vertical line (whole page bytes where the line spans a page)
+
+	@param[in] p : instance of display
+	@param[in] x : x position of line
+	@param[in] y : y position of starting point
+	@param[in] len : length in pixels
+*/
+void ssd1306_draw_vline(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t len);
+
+/**
+	@brief OR a bitmap in display byte format into the buffer
+
+	The bitmap is `pages` rows of `width` bytes; each byte is one column of
+	8 pixels, least significant bit on top (the GDDRAM layout). When y is a
+	multiple of 8 every byte is a single OR; otherwise each byte is split
+	across two pages. Clipped at the display edges.
+
+	@param[in] p : instance of display
+	@param[in] x : x position of top left corner
+	@param[in] y : y position of top left corner
+	@param[in] bitmap : page-major column bytes
+	@param[in] width : bitmap width in pixels (bytes per page row)
+	@param[in] pages : bitmap height in 8-pixel pages
+*/
+void ssd1306_blit(ssd1306_t *p, uint32_t x, uint32_t y, const uint8_t *bitmap, uint32_t width, uint32_t pages);
+
 /**
 	@brief clear square at given position with given size
 
@@ -271,4 +444,19 @@ void ssd1306_draw_string_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_
 */
 void ssd1306_draw_string(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const char *s);
 
+/**
+	@brief draws string from a pre-rasterized glyph cache
+
+	Same placement and spacing as ssd1306_draw_string_with_font with the
+	font and scale the cache was generated from. Byte-aligned y (multiple
+	of 8) makes every glyph a plain OR of its bytes.
+
+	@param[in] p : instance of display
+	@param[in] x : x starting position of text
+	@param[in] y : y starting position of text
+	@param[in] cache : glyph cache (see tools/glyphcache)
+	@param[in] s : text to draw
+*/
+void ssd1306_draw_string_cached(ssd1306_t *p, uint32_t x, uint32_t y, const ssd1306_glyph_cache_t *cache, const char *s);
+
 #endif
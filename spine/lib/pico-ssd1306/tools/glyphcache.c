@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../font.h"
+#include "../example/acme_5_outlines_font.h"
+#include "../example/bubblesstandard_font.h"
+#include "../example/crackers_font.h"
+#include "../example/BMSPA_font.h"
+
+/*
+	pre-rasterizes fonts at fixed scales into ssd1306_glyph_cache_t tables
+
+	usage: glyphcache <output.h> <font>:<scale> [<font>:<scale> ...]
+
+	the glyphs are rendered exactly like ssd1306_draw_char_with_font would
+	draw them at that scale, then stored as page-major column bytes
+*/
+
+#define MAX_SCALE 8
+
+typedef struct {
+    const char *name;
+    const uint8_t *font;
+} font_entry_t;
+
+static const font_entry_t fonts[]= {
+    {"font_8x5", font_8x5},
+    {"acme_font", acme_font},
+    {"bubblesstandard_font", bubblesstandard_font},
+    {"crackers_font", crackers_font},
+    {"BMSPA_font", BMSPA_font},
+};
+
+static const uint8_t *find_font(const char *name) {
+    for(size_t i=0; i<sizeof(fonts)/sizeof(fonts[0]); ++i)
+        if(strcmp(fonts[i].name, name)==0)
+            return fonts[i].font;
+    return NULL;
+}
+
+void normalize_name(char *name) {
+    for(size_t i=0; name[i]!=0; ++i) {
+        if(!(('a'<=name[i]&&name[i]<='z')||('A'<=name[i]&&name[i]<='Z')||('0'<=name[i]&&name[i]<='9')))
+            name[i]='_';
+    }
+}
+
+/* renders glyph c of font at scale into out (pages rows of width bytes) */
+static void rasterize(const uint8_t *font, uint32_t scale, char c, uint8_t *out, uint32_t width) {
+    const uint32_t parts_per_line=(font[0]>>3)+((font[0]&7)>0);
+
+    for(uint8_t w=0; w<font[1]; ++w) {
+        uint32_t pp=(c-font[3])*font[1]*parts_per_line+w*parts_per_line+5;
+        for(uint32_t lp=0; lp<parts_per_line; ++lp) {
+            uint8_t line=font[pp];
+
+            for(uint32_t j=0; j<8; ++j, line>>=1) {
+                if(!(line&1))
+                    continue;
+                for(uint32_t dx=0; dx<scale; ++dx) {
+                    for(uint32_t dy=0; dy<scale; ++dy) {
+                        const uint32_t col=w*scale+dx;
+                        const uint32_t row=((lp<<3)+j)*scale+dy;
+                        out[(row>>3)*width+col]|=1u<<(row&7);
+                    }
+                }
+            }
+
+            ++pp;
+        }
+    }
+}
+
+static int emit_cache(FILE *out, const char *font_name, uint32_t scale) {
+    const uint8_t *font=find_font(font_name);
+    if(font==NULL) {
+        fprintf(stderr, "Unknown font \"%s\"!\n", font_name);
+        return -1;
+    }
+
+    const uint32_t parts_per_line=(font[0]>>3)+((font[0]&7)>0);
+    const uint32_t width=font[1]*scale;
+    const uint32_t pages=parts_per_line*scale;
+    const uint32_t advance=(font[1]+font[2])*scale;
+    const uint32_t glyph_size=width*pages;
+    const uint32_t count=font[4]-font[3]+1;
+
+    if(width>255||advance>255||glyph_size>65535) {
+        fprintf(stderr, "%s at scale %u is too large!\n", font_name, scale);
+        return -1;
+    }
+
+    uint8_t *glyph=malloc(glyph_size);
+    if(glyph==NULL)
+        return -1;
+
+    fprintf(out, "static const uint8_t glyphs_%s_x%u[]= {\n", font_name, scale);
+    for(uint32_t i=0; i<count; ++i) {
+        const char c=(char)(font[3]+i);
+        memset(glyph, 0, glyph_size);
+        rasterize(font, scale, c, glyph, width);
+
+        fprintf(out, "    ");
+        for(uint32_t b=0; b<glyph_size; ++b)
+            fprintf(out, "0x%02x,", glyph[b]);
+        if(c>=' '&&c<='~'&&c!='\\')
+            fprintf(out, " // %c", c);
+        fprintf(out, "\n");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const ssd1306_glyph_cache_t glyph_cache_%s_x%u= {\n", font_name, scale);
+    fprintf(out, "    %u, %u, %u, %u, %u, %u, glyphs_%s_x%u\n",
+            width, pages, advance, font[3], font[4], glyph_size, font_name, scale);
+    fprintf(out, "};\n\n");
+
+    free(glyph);
+    return 0;
+}
+
+int main(int ac, char *as[]) {
+    if(ac<3) {
+        fprintf(stderr, "Usage: %s [output file] [font:scale] ...\n", as[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *out=fopen(as[1], "w");
+    if(out==NULL) {
+        fprintf(stderr, "Could not open \"%s\" for writing!\n", as[1]);
+        return EXIT_FAILURE;
+    }
+
+    const char *base=strrchr(as[1], '/');
+    char *guard=strdup(base?base+1:as[1]);
+    normalize_name(guard);
+
+    fprintf(out, "/* generated by pico-ssd1306/tools/glyphcache, do not edit\n *\n *   glyphcache <this file>");
+    for(int i=2; i<ac; ++i)
+        fprintf(out, " %s", as[i]);
+    fprintf(out, "\n */\n\n#ifndef _inc_%s\n#define _inc_%s\n\n#include \"ssd1306.h\"\n\n", guard, guard);
+
+    int rc=EXIT_SUCCESS;
+    for(int i=2; i<ac; ++i) {
+        char spec[128];
+        strncpy(spec, as[i], sizeof(spec)-1);
+        spec[sizeof(spec)-1]=0;
+
+        char *sep=strchr(spec, ':');
+        const int scale=sep?atoi(sep+1):0;
+        if(sep==NULL||scale<1||scale>MAX_SCALE) {
+            fprintf(stderr, "Bad spec \"%s\", expected font:scale (1..%d)!\n", as[i], MAX_SCALE);
+            rc=EXIT_FAILURE;
+            break;
+        }
+        *sep=0;
+
+        if(emit_cache(out, spec, (uint32_t)scale)!=0) {
+            rc=EXIT_FAILURE;
+            break;
+        }
+    }
+
+    fprintf(out, "#endif\n");
+
+    free(guard);
+    fclose(out);
+    return rc;
+}
@@ -1,4 +1,3 @@
-#include <stdio.h>
 #include "pico/stdlib.h"
 
 #ifdef __cplusplus
@@ -7,16 +6,153 @@ extern "C" {
 
 #include "hardware/i2c.h"
 #include "lib/pico-ssd1306/ssd1306.h"
+#include "display_glyphs.h"
 
 #ifdef __cplusplus
 }
 #endif
 
+#include "spine_ack.h"
+#include "spine_dispatch.h"
+#include "spine_event_log.h"
+#include "spine_link_rx.h"
+#include "spine_log.h"
+#include "spine_runtime.h"
+#include "spine_safety.h"
+#include "spine_telemetry.h"
+#include "spine_timing.h"
+
+#include "tusb.h"
+
 #define I2C_PORT i2c0
 #define SDA_PIN 4
 #define SCL_PIN 5
 
+// Periodic work (period and declared time budget, microseconds).
+// A full OLED refresh is ~25 ms at 400 kHz I2C. With the DMA path the task
+// only draws and queues the changed windows; the bus time is off-CPU.
+static constexpr uint32_t STATUS_DISPLAY_PERIOD_US = 1000u * spine::US_PER_MS;
+#if defined(SSD1306_DMA)
+static constexpr uint32_t STATUS_DISPLAY_BUDGET_US = 2u * spine::US_PER_MS;
+#else
+static constexpr uint32_t STATUS_DISPLAY_BUDGET_US = 30u * spine::US_PER_MS;
+#endif
+static constexpr uint32_t TELEMETRY_PERIOD_US      = 1000u * spine::US_PER_MS;
+static constexpr uint32_t TELEMETRY_BUDGET_US      = 100u;
+static constexpr uint32_t LED_BLINK_PERIOD_US      = 1000u * spine::US_PER_MS;
+static constexpr uint32_t LED_BLINK_BUDGET_US      = 50u;
+
+// S2B_STATE_REPORT stream. The contract period unless the build asks for a
+// denser stream (SPINE_STATE_REPORT_PERIOD_US, down to 1 ms).
+#if defined(SPINE_STATE_REPORT_PERIOD_US)
+static constexpr uint32_t STATE_REPORT_PERIOD_US = SPINE_STATE_REPORT_PERIOD_US;
+#else
+static constexpr uint32_t STATE_REPORT_PERIOD_US = spine::STATE_REPORT_PERIOD_US;
+#endif
+
+static ssd1306_t disp;
+
+static void run_status_display(void* ctx) {
+    (void)ctx;
+    ssd1306_clear(&disp);
+    // Pre-rasterized font_8x5 at x2 / x1 (display_glyphs.h): byte ORs only.
+    ssd1306_draw_string_cached(&disp, 20, 10, &glyph_cache_font_8x5_x2, "TITAN");
+    ssd1306_draw_string_cached(&disp, 25, 35, &glyph_cache_font_8x5_x1, "S2T ROVER");
+    // Never waits: a frame still in flight means this one is skipped.
+    (void)ssd1306_show_async(&disp);
+}
+
+static void run_telemetry(void* ctx) {
+    (void)ctx;
+
+    spine::TimingMetrics timing;
+    spine::spine_timing_get_metrics(&timing);
+
+    spine::DispatchCounters dispatch;
+    spine::spine_dispatch_get_counters(&dispatch);
+
+    spine::RuntimeCounters runtime;
+    spine::spine_runtime_get_counters(&runtime);
+
+    spine::TelemetryCounters reports;
+    spine::spine_telemetry_get_counters(&reports);
+
+    const proto::Framer* framer = spine::spine_link_rx_framer();
+
+    spine::LinkRxCounters rx;
+    spine::spine_link_rx_get_counters(&rx);
+
+    spine::LogCounters log;
+    spine::spine_log_get_counters(&log);
+
+    spine::AckCounters acks;
+    spine::spine_ack_get_counters(&acks);
+
+    // Deferred-format: each line costs a few stores; text is rebuilt on
+    // the Brain. At most SPINE_LOG_MAX_ARGS values per line.
+    SPINE_LOG("spine.state=%u spine.safety.last_fault=%u "
+              "spine.link.keepalive_count=%u spine.link.hold_timeout_count=%u",
+              spine::spine_safety_state(), spine::spine_safety_last_fault_code(),
+              timing.keepalive_count, timing.hold_timeout_count);
+    SPINE_LOG("spine.safety.timeout_to_safe_last_us=%u spine.safety.timeout_to_safe_max_us=%u "
+              "spine.link.packet_ok_count=%u spine.link.dropped_byte_count=%u",
+              timing.timeout_to_safe_last_us, timing.timeout_to_safe_max_us,
+              framer->packet_ok_count, framer->dropped_byte_count);
+    SPINE_LOG("spine.link.unknown_type_count=%u spine.link.mailbox_dropped_count=%u "
+              "spine.core0.load_permille=%u spine.core1.load_permille=%u",
+              dispatch.unknown_type_count, runtime.mailbox_dropped_count,
+              runtime.core0_load_permille, runtime.core1_load_permille);
+    SPINE_LOG("spine.link.rx_latency_last_us=%u spine.link.rx_latency_max_us=%u "
+              "spine.link.rx_latency_mean_us=%u spine.link.rx_overflow_byte_count=%u",
+              rx.latency_last_us, rx.latency_max_us, rx.latency_mean_us, rx.overflow_byte_count);
+    SPINE_LOG("spine.display.busy_count=%u spine.display.error_count=%u "
+              "spine.log.lost_record_count=%u spine.ack.dropped_count=%u",
+              disp.async_busy_count, disp.async_error_count, log.lost_record_count,
+              acks.dropped_count);
+    SPINE_LOG("spine.report.sent_count=%u spine.report.dropped_count=%u "
+              "spine.report.superseded_count=%u spine.report.torn_count=%u",
+              reports.report_sent_count, reports.report_dropped_count,
+              reports.report_superseded_count, reports.snapshot_torn_count);
+}
+
+static void run_led_blink(void* ctx) {
+    (void)ctx;
+    static bool led_state = false;
+    led_state = !led_state;
+    gpio_put(PICO_DEFAULT_LED_PIN, led_state);
+}
+
+// Core assignment: anything that can block on I2C or USB runs on core1,
+// leaving core0 to the mailbox, the safety state and the hold alarm IRQ.
+static constexpr uint32_t SAFETY_CORE = 0u;
+static constexpr uint32_t LINK_CORE   = 1u;
+
+static spine::PeriodicTask status_display_task = {
+    "status_display", STATUS_DISPLAY_PERIOD_US, STATUS_DISPLAY_BUDGET_US, run_status_display, nullptr, LINK_CORE
+};
+static spine::PeriodicTask telemetry_task = {
+    "telemetry", TELEMETRY_PERIOD_US, TELEMETRY_BUDGET_US, run_telemetry, nullptr, LINK_CORE
+};
+static spine::PeriodicTask led_blink_task = {
+    "led_blink", LED_BLINK_PERIOD_US, LED_BLINK_BUDGET_US, run_led_blink, nullptr, SAFETY_CORE
+};
+
+// Boot failure: the safety state never leaves INIT. core1 never starts,
+// so this core takes over the USB device stack and drains the log itself.
+[[noreturn]] static void remain_in_init() {
+    tusb_init();
+    while (true) {
+        tud_task();
+        spine::spine_log_drain();
+        tight_loop_contents();
+    }
+}
+
 int main() {
+    spine::spine_event_log_init();
+    spine::spine_event_log_record(spine::EVENT_BOOT, spine::DEFAULT_HOLD_TIMEOUT_US, 0u);
+    spine::spine_log_init();
+    spine::spine_safety_init();
     stdio_init_all();
     
     // 1. Wait for hardware to stabilize
@@ -29,33 +165,70 @@ int main() {
     gpio_pull_up(SDA_PIN);
     gpio_pull_up(SCL_PIN);
 
+    gpio_init(PICO_DEFAULT_LED_PIN);
+    gpio_set_dir(PICO_DEFAULT_LED_PIN, GPIO_OUT);
+
     // 3. Initialize OLED
-    ssd1306_t disp;
     disp.external_vcc = false;
     
     // If ssd1306_init fails, it usually returns false
     if (!ssd1306_init(&disp, 128, 64, 0x3C, I2C_PORT)) {
-        printf("OLED Init Failed!\n");
+        SPINE_LOG("OLED init failed");
     }
 
-    // 4. Force Clear and Update
+    // 4. Force Clear and Update (blocking, before anything time-critical runs)
     ssd1306_clear(&disp);
     ssd1306_show(&disp);
-    sleep_ms(100);
 
-    while (true) {
-        printf("Titan Spine: Running at 0x3C\n");
+    // From here on the display is refreshed through DMA when available.
+    if (!ssd1306_async_init(&disp)) {
+        SPINE_LOG("OLED async refresh unavailable; using blocking refresh");
+    }
 
-        ssd1306_clear(&disp);
-        ssd1306_draw_string(&disp, 20, 10, 2, "TITAN");
-        ssd1306_draw_string(&disp, 25, 35, 1, "S2T ROVER");
-        ssd1306_show(&disp);
+    // 5. Timing engine. The hold alarm is armed from here on: silence
+    //    since boot counts exactly like silence later.
+    spine::spine_dispatch_init();
 
-        static bool led_state = false;
-        led_state = !led_state;
-        gpio_put(PICO_DEFAULT_LED_PIN, led_state);
+    if (!spine::spine_timing_init(spine::DEFAULT_HOLD_TIMEOUT_US)) {
+        SPINE_LOG("Timing engine init failed; remaining in INIT");
+        remain_in_init();
+    }
 
-        sleep_ms(1000);
+    // A task that fails to register would silently never run, so boot
+    // stops in INIT instead, exactly like a timing engine failure.
+    if (!spine::spine_timing_add_periodic_task(&status_display_task) ||
+        !spine::spine_timing_add_periodic_task(&telemetry_task) ||
+        !spine::spine_timing_add_periodic_task(&led_blink_task)) {
+        SPINE_LOG("Main loop task registration failed; remaining in INIT");
+        remain_in_init();
+    }
+    if (!spine::spine_telemetry_init(STATE_REPORT_PERIOD_US)) {
+        SPINE_LOG("STATE_REPORT task registration failed; remaining in INIT");
+        remain_in_init();
+    }
+    if (!spine::spine_event_log_start_dump_task()) {
+        SPINE_LOG("Event log dump task registration failed; remaining in INIT");
+        remain_in_init();
+    }
+    if (!spine::spine_log_start_drain_task()) {
+        SPINE_LOG("Log drain task registration failed; remaining in INIT");
+        remain_in_init();
+    }
+
+    // 6. Hand link receive, framing and CRC validation to core1.
+    spine::spine_runtime_start_link_core();
+
+    spine::spine_safety_mark_ready();
+
+    // core0 safety loop: every pass is bounded (MAILBOX_SLOT_COUNT packets,
+    // then each due core0 task once). Nothing here sleeps or touches I2C.
+    while (true) {
+        const uint32_t start_us = time_us_32();
+        const uint32_t packets = spine::spine_runtime_drain_mailbox(spine::spine_dispatch_packet, nullptr);
+        const uint32_t tasks_run = spine::spine_timing_run_due_tasks();
+        const uint32_t elapsed_us = time_us_32() - start_us;
+
+        spine::spine_runtime_account_pass((packets > 0u || tasks_run > 0u) ? elapsed_us : 0u);
     }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+#include "hardware/structs/xip_ctrl.h"
+
+#include "proto_constants.h"
+#include "proto_crc.h"
+#include "proto_framer.h"
+#include "proto_packet.h"
+#include "proto_placement.h"
+#include "proto_wire.h"
+
+#if defined(PROTO_CRC32_BACKEND_DMA)
+#include "proto_crc_dma.h"
+#endif
+
+/*
+ * On-target worst-case cost of receiving one packet.
+ *
+ * Built twice from the same source (proto_bench_flash, proto_bench_ram),
+ * differing only in PROTO_HOT_PATH_RAM, so the two reports compare code
+ * placement and nothing else.
+ *
+ * For each payload size, every sample is taken twice:
+ *   warm: the code was just run, XIP cache hits
+ *   cold: XIP cache flushed first, as after an OLED refresh or any other
+ *         flash-heavy work on either core
+ * and the report gives the worst of ITERATIONS_PER_SIZE samples for
+ *   validate: proto_packet_validate on a complete packet
+ *   framer:   proto_framer_push of the same packet in one chunk
+ *             (framing + header check + validate + callback)
+ *
+ * Cycles come from SysTick on the processor clock (the M0+ has no DWT).
+ */
+
+static constexpr uint32_t SYSTICK_RELOAD_MAX   = 0x00FFFFFFu;
+static constexpr uint32_t SYSTICK_ENABLE_CPU   = 0x5u;  // ENABLE | CLKSOURCE=processor
+static constexpr uint32_t ITERATIONS_PER_SIZE  = 64u;
+static constexpr uint32_t REPORT_PERIOD_MS     = 5000u;
+
+static const size_t BENCH_PAYLOAD_SIZES[] = {0, 8, 32, 64, 128, proto::MAX_PAYLOAD_SIZE_BYTES};
+
+static uint8_t packet[proto::FRAMER_BUFFER_SIZE_BYTES];
+static proto::Framer framer;
+static volatile uint32_t delivered_count = 0;
+
+#if defined(PROTO_HOT_PATH_RAM)
+static const char* const PLACEMENT = "ram";
+#else
+static const char* const PLACEMENT = "flash";
+#endif
+
+struct WorstCase {
+    uint32_t warm_max;
+    uint32_t cold_max;
+};
+
+static inline uint32_t cycles_now() {
+    return systick_hw->cvr;
+}
+
+// SysTick counts down and wraps at 24 bits.
+static inline uint32_t cycles_between(uint32_t start, uint32_t end) {
+    return (start - end) & SYSTICK_RELOAD_MAX;
+}
+
+// Invalidate the whole XIP cache; the read back waits for completion.
+static inline void xip_cache_flush() {
+    xip_ctrl_hw->flush = 1u;
+    (void)xip_ctrl_hw->flush;
+}
+
+// Placed with the hot path: the firmware's callback cost is not under test.
+static void PROTO_HOT_FUNC(count_packet)(const uint8_t* buf, std::size_t len, void* ctx) {
+    (void)buf;
+    (void)len;
+    (void)ctx;
+    delivered_count = delivered_count + 1u;
+}
+
+// One valid B2S packet with `payload_len` pseudo-random payload bytes.
+static std::size_t build_packet(std::size_t payload_len) {
+    proto::put_u16_le(&packet[proto::OFFSET_MAGIC], proto::PROTO_MAGIC);
+    packet[proto::OFFSET_PROTO_MAJOR] = proto::PROTO_VERSION_MAJOR;
+    packet[proto::OFFSET_PROTO_MINOR] = proto::PROTO_VERSION_MINOR;
+    packet[proto::OFFSET_MSG_TYPE] = proto::MSG_ID_B2S_MOTION_SETPOINT;
+    packet[proto::OFFSET_FLAGS] = 0u;
+    packet[proto::OFFSET_SRC] = proto::NODE_ID_BRAIN;
+    packet[proto::OFFSET_DST] = proto::NODE_ID_SPINE;
+    proto::put_u16_le(&packet[proto::OFFSET_SEQ], 1u);
+    proto::put_u16_le(&packet[proto::OFFSET_PAYLOAD_LEN], static_cast<uint16_t>(payload_len));
+    proto::put_u16_le(&packet[proto::OFFSET_HEADER_CRC16], 0u);
+    proto::put_u16_le(&packet[proto::OFFSET_HEADER_CRC16],
+               proto::proto_crc16_ccitt_false(packet, proto::HEADER_SIZE_BYTES));
+
+    uint8_t* payload = packet + proto::HEADER_SIZE_BYTES;
+    for (std::size_t i = 0; i < payload_len; ++i) {
+        payload[i] = static_cast<uint8_t>(rand());
+    }
+
+    const uint32_t crc = proto::proto_crc32_iso_hdlc_sw(payload, payload_len);
+    uint8_t* trailer = payload + payload_len;
+    trailer[0] = static_cast<uint8_t>(crc);
+    trailer[1] = static_cast<uint8_t>(crc >> 8);
+    trailer[2] = static_cast<uint8_t>(crc >> 16);
+    trailer[3] = static_cast<uint8_t>(crc >> 24);
+
+    return proto::HEADER_SIZE_BYTES + payload_len + proto::TRAILER_SIZE_BYTES;
+}
+
+static uint32_t time_validate(std::size_t len, uint32_t overhead) {
+    const uint32_t t0 = cycles_now();
+    const proto::PacketStatus st = proto::proto_packet_validate(packet, len);
+    const uint32_t t1 = cycles_now();
+    return (st == proto::PacketStatus::OK) ? cycles_between(t0, t1) - overhead : SYSTICK_RELOAD_MAX;
+}
+
+static uint32_t time_framer(std::size_t len, uint32_t overhead) {
+    proto::proto_framer_init(&framer);
+    const uint32_t delivered_before = delivered_count;
+    const uint32_t t0 = cycles_now();
+    proto::proto_framer_push(&framer, packet, len, count_packet, nullptr);
+    const uint32_t t1 = cycles_now();
+    return (delivered_count == delivered_before + 1u) ? cycles_between(t0, t1) - overhead
+                                                      : SYSTICK_RELOAD_MAX;
+}
+
+static void track(WorstCase* w, uint32_t warm, uint32_t cold) {
+    if (warm > w->warm_max) w->warm_max = warm;
+    if (cold > w->cold_max) w->cold_max = cold;
+}
+
+static void bench_size(std::size_t payload_len, uint32_t overhead) {
+    const std::size_t len = build_packet(payload_len);
+    WorstCase validate = {0, 0};
+    WorstCase framed = {0, 0};
+
+    for (uint32_t i = 0; i < ITERATIONS_PER_SIZE; ++i) {
+        xip_cache_flush();
+        const uint32_t validate_cold = time_validate(len, overhead);
+        const uint32_t validate_warm = time_validate(len, overhead);
+        track(&validate, validate_warm, validate_cold);
+
+        xip_cache_flush();
+        const uint32_t framer_cold = time_framer(len, overhead);
+        const uint32_t framer_warm = time_framer(len, overhead);
+        track(&framed, framer_warm, framer_cold);
+    }
+
+    printf("proto_bench.placement=%s payload_bytes=%u "
+           "validate_warm_cycles_max=%lu validate_cold_cycles_max=%lu "
+           "framer_warm_cycles_max=%lu framer_cold_cycles_max=%lu\n",
+           PLACEMENT, (unsigned)payload_len,
+           (unsigned long)validate.warm_max, (unsigned long)validate.cold_max,
+           (unsigned long)framed.warm_max, (unsigned long)framed.cold_max);
+}
+
+int main() {
+    stdio_init_all();
+    sleep_ms(2000);
+
+    systick_hw->rvr = SYSTICK_RELOAD_MAX;
+    systick_hw->cvr = 0;
+    systick_hw->csr = SYSTICK_ENABLE_CPU;
+
+#if defined(PROTO_CRC32_BACKEND_DMA)
+    const bool dma_ready = proto::proto_crc32_dma_init();
+#else
+    const bool dma_ready = false;
+#endif
+
+    // Cost of the measurement itself, subtracted from every sample.
+    const uint32_t t0 = cycles_now();
+    const uint32_t t1 = cycles_now();
+    const uint32_t overhead = cycles_between(t0, t1);
+
+    while (true) {
+        printf("\n--- PACKET RECEIVE WORST CASE (%s) ---\n", PLACEMENT);
+        printf("proto_bench.crc32_backend=%s\n", dma_ready ? "dma" : "sw");
+        for (size_t i = 0; i < sizeof(BENCH_PAYLOAD_SIZES) / sizeof(BENCH_PAYLOAD_SIZES[0]); ++i) {
+            bench_size(BENCH_PAYLOAD_SIZES[i], overhead);
+        }
+        sleep_ms(REPORT_PERIOD_MS);
+    }
+}
@@ -6,7 +6,7 @@
 
 /*
  * Wire-format constants and layout definitions for Brain <-> Spine
- * Message Contract v0.1.
+ * Message Contract v0.2.
  *
  * This file defines immutable packet layout only:
  * - constants
@@ -32,7 +32,11 @@ static constexpr uint16_t PROTO_MAGIC = 0x5332u;
 
 // Protocol version (u8/u8) as carried in every packet header.
 static constexpr uint8_t PROTO_VERSION_MAJOR = 0u;
-static constexpr uint8_t PROTO_VERSION_MINOR = 1u;
+static constexpr uint8_t PROTO_VERSION_MINOR = 2u;
+
+// Node identifiers (Section 6).
+static constexpr uint8_t NODE_ID_BRAIN = 0x00u;
+static constexpr uint8_t NODE_ID_SPINE = 0x01u;
 
 //
 // 2) PACKET SIZES (BYTES)
@@ -84,11 +88,53 @@ static constexpr std::size_t OFFSET_HEADER_CRC16  = 12u; // u16
 static constexpr std::size_t OFFSET_PAYLOAD_CRC32_IN_TRAILER = 0u; // u32
 
 //
-// 5) Layout sanity checks (compile-time)
+// 5) MESSAGE TYPE IDS (Section 8)
+//
+
+// Brain -> Spine (0x10 - 0x2F)
+static constexpr uint8_t MSG_ID_B2S_HELLO           = 0x10u;
+static constexpr uint8_t MSG_ID_B2S_HEARTBEAT       = 0x11u;
+static constexpr uint8_t MSG_ID_B2S_MOTION_ENABLE   = 0x12u;
+static constexpr uint8_t MSG_ID_B2S_MOTION_SETPOINT = 0x13u;
+
+// Spine -> Brain (0x80 - 0x9F)
+static constexpr uint8_t MSG_ID_S2B_IDENTITY     = 0x80u;
+static constexpr uint8_t MSG_ID_S2B_HEARTBEAT    = 0x81u;
+static constexpr uint8_t MSG_ID_S2B_STATE_REPORT = 0x82u;
+static constexpr uint8_t MSG_ID_S2B_ACK          = 0x83u;
+static constexpr uint8_t MSG_ID_S2B_FAULT        = 0x84u;
+
+// Diagnostic extensions (provisional; not part of Contract v0.2). Taken
+// from the top of each range so contract additions never collide.
+static constexpr uint8_t MSG_ID_B2S_EVENT_LOG_REQUEST = 0x2Fu;
+static constexpr uint8_t MSG_ID_S2B_EVENT_LOG         = 0x9Fu;
+static constexpr uint8_t MSG_ID_S2B_LOG               = 0x9Eu;
+
+//
+// 6) SPINE STATE VALUES (Section 7) and FAULT CODES (Section 11)
+//
+
+static constexpr uint8_t SPINE_STATE_INIT    = 0x00u;
+static constexpr uint8_t SPINE_STATE_SAFE    = 0x01u;
+static constexpr uint8_t SPINE_STATE_ENABLED = 0x02u;
+static constexpr uint8_t SPINE_STATE_FAULT   = 0x03u;
+
+static constexpr uint16_t FAULT_CODE_NONE                  = 0u;
+static constexpr uint16_t FAULT_CODE_CRC_HEADER_FAIL       = 1001u;
+static constexpr uint16_t FAULT_CODE_CRC_PAYLOAD_FAIL      = 1002u;
+static constexpr uint16_t FAULT_CODE_UNKNOWN_MSG_TYPE      = 1003u;
+static constexpr uint16_t FAULT_CODE_SESSION_INVALID       = 1004u;
+static constexpr uint16_t FAULT_CODE_KEEPALIVE_TIMEOUT     = 1005u;
+static constexpr uint16_t FAULT_CODE_INVALID_AXIS_ID       = 1006u;
+static constexpr uint16_t FAULT_CODE_SETPOINT_OUT_OF_RANGE = 1007u;
+static constexpr uint16_t FAULT_CODE_INTERNAL_ERROR        = 1099u;
+
+//
+// 7) Layout sanity checks (compile-time)
 //
 
-static_assert(HEADER_SIZE_BYTES == 14u, "header size must match contract v0.1");
-static_assert(TRAILER_SIZE_BYTES == 4u, "trailer size must match contract v0.1");
+static_assert(HEADER_SIZE_BYTES == 14u, "header size must match contract v0.2");
+static_assert(TRAILER_SIZE_BYTES == 4u, "trailer size must match contract v0.2");
 static_assert(OFFSET_HEADER_CRC16 + 2u == HEADER_SIZE_BYTES,
               "header_crc16 must be the final header field (u16)");
 
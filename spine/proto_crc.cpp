@@ -1,8 +1,13 @@
 #include "proto_crc.h"
+#include "proto_placement.h"
+
+#if defined(PROTO_CRC32_BACKEND_DMA)
+#include "proto_crc_dma.h"
+#endif
 
 namespace proto {
 
-uint16_t proto_crc16_ccitt_false(const uint8_t* data, std::size_t len) {
+uint16_t PROTO_HOT_FUNC(proto_crc16_ccitt_false)(const uint8_t* data, std::size_t len) {
     if (len == 0) {
         return 0xFFFFu;
     }
@@ -27,7 +32,17 @@ uint16_t proto_crc16_ccitt_false(const uint8_t* data, std::size_t len) {
     return crc;
 }
 
-uint32_t proto_crc32_iso_hdlc(const uint8_t* data, std::size_t len) {
+uint32_t PROTO_HOT_FUNC(proto_crc32_iso_hdlc)(const uint8_t* data, std::size_t len) {
+#if defined(PROTO_CRC32_BACKEND_DMA)
+    uint32_t crc = 0;
+    if (proto_crc32_dma_try(data, len, &crc)) {
+        return crc;
+    }
+#endif
+    return proto_crc32_iso_hdlc_sw(data, len);
+}
+
+uint32_t PROTO_HOT_FUNC(proto_crc32_iso_hdlc_sw)(const uint8_t* data, std::size_t len) {
     if (len == 0) {
         return 0;
     }
@@ -20,9 +20,19 @@ uint16_t proto_crc16_ccitt_false(const uint8_t* data, std::size_t len);
  *
  * Contract rule: if len==0, return 0.
  * NOTE: data may be nullptr only if len==0.
+ *
+ * Uses the DMA sniffer backend (proto_crc_dma.h) when it is compiled in
+ * (PROTO_CRC32_BACKEND_DMA), initialized, and owned by the calling core;
+ * otherwise the software path below. Both produce identical results.
  */
 uint32_t proto_crc32_iso_hdlc(const uint8_t* data, std::size_t len);
 
+/*
+ * Software CRC-32/ISO-HDLC. Always available; reference for the hardware
+ * backend and the only path on host builds.
+ */
+uint32_t proto_crc32_iso_hdlc_sw(const uint8_t* data, std::size_t len);
+
 } // namespace proto
 
 #endif // PROTO_CRC_H
@@ -0,0 +1,82 @@
+#include "proto_crc_dma.h"
+#include "proto_placement.h"
+
+#include "hardware/dma.h"
+#include "pico/stdlib.h"
+
+namespace proto {
+
+static constexpr int      CHANNEL_UNCLAIMED   = -1;
+static constexpr uint32_t CRC32_SEED          = 0xFFFFFFFFu;
+
+// DMA_SNIFF_CTRL_CALC: "Calculate a CRC-32 (IEEE802.3 polynomial) with
+// bit reversed data" (RP2040 datasheet, 2.5.5.2).
+static constexpr uint32_t SNIFF_CALC_CRC32_BIT_REVERSED = 0x1u;
+
+static int s_channel = CHANNEL_UNCLAIMED;
+static uint32_t s_owner_core = 0;
+
+// The channel writes every byte here; only the sniffer sees the stream.
+static volatile uint8_t s_sink_byte;
+
+bool proto_crc32_dma_init() {
+    if (s_channel != CHANNEL_UNCLAIMED) {
+        return true;
+    }
+
+    const int channel = dma_claim_unused_channel(false);
+    if (channel < 0) {
+        return false;
+    }
+
+    dma_channel_config cfg = dma_channel_get_default_config(static_cast<uint>(channel));
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_8);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, DREQ_FORCE);
+    channel_config_set_sniff_enable(&cfg, true);
+    dma_channel_set_config(static_cast<uint>(channel), &cfg, false);
+    dma_channel_set_write_addr(static_cast<uint>(channel), &s_sink_byte, false);
+
+    s_owner_core = get_core_num();
+    s_channel = channel;
+    return true;
+}
+
+bool PROTO_HOT_FUNC(proto_crc32_dma_try)(const uint8_t* data, std::size_t len, uint32_t* out) {
+    if (s_channel == CHANNEL_UNCLAIMED || out == nullptr) {
+        return false;
+    }
+    if (get_core_num() != s_owner_core) {
+        return false;
+    }
+
+    // Contract rule: empty payload CRC is 0, not the CRC of nothing.
+    if (len == 0) {
+        *out = 0;
+        return true;
+    }
+    if (data == nullptr) {
+        *out = 0;
+        return true;
+    }
+
+    const uint channel = static_cast<uint>(s_channel);
+
+    dma_sniffer_enable(channel, SNIFF_CALC_CRC32_BIT_REVERSED, true);
+    // dma_sniffer_enable() rewrites SNIFF_CTRL, so output shaping goes after.
+    hw_set_bits(&dma_hw->sniff_ctrl, DMA_SNIFF_CTRL_OUT_REV_BITS | DMA_SNIFF_CTRL_OUT_INV_BITS);
+    dma_hw->sniff_data = CRC32_SEED;
+
+    dma_channel_transfer_from_buffer_now(channel, data, static_cast<uint32_t>(len));
+
+    // Bounded: an unpaced channel moves one byte per bus cycle,
+    // MAX_PAYLOAD_SIZE_BYTES at most.
+    dma_channel_wait_for_finish_blocking(channel);
+
+    *out = dma_hw->sniff_data;
+    dma_sniffer_disable();
+    return true;
+}
+
+} // namespace proto
@@ -0,0 +1,40 @@
+#ifndef PROTO_CRC_DMA_H
+#define PROTO_CRC_DMA_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace proto {
+
+/*
+ * Hardware CRC-32/ISO-HDLC backend using the RP2040 DMA sniffer.
+ *
+ * The payload is streamed through one DMA channel (8-bit reads, no write
+ * increment) with the sniffer in bit-reversed CRC-32 mode:
+ *   seed 0xFFFFFFFF, calc mode CRC-32 (bit-reversed data)  -> refin=true
+ *   OUT_REV                                                -> refout=true
+ *   OUT_INV                                                -> xorout=0xFFFFFFFF
+ * The result is bit-identical to proto_crc32_iso_hdlc_sw().
+ *
+ * Ownership: the sniffer is a single global block. The channel and sniffer
+ * belong to the core that called proto_crc32_dma_init(); calls from any
+ * other core return false so the caller falls back to software.
+ * Not for IRQ context.
+ *
+ * Only compiled when PROTO_CRC32_BACKEND_DMA is defined (pico builds).
+ */
+
+/*
+ * Claim a DMA channel for the sniffer. Returns false if none is free.
+ */
+bool proto_crc32_dma_init();
+
+/*
+ * Compute the payload CRC in hardware. Returns false (and leaves *out
+ * untouched) if the backend is unavailable on the calling core.
+ */
+bool proto_crc32_dma_try(const uint8_t* data, std::size_t len, uint32_t* out);
+
+} // namespace proto
+
+#endif // PROTO_CRC_DMA_H
@@ -0,0 +1,58 @@
+#include "proto_encoder.h"
+#include "proto_constants.h"
+#include "proto_crc.h"
+#include "proto_wire.h"
+
+#include <cstring>
+
+namespace proto {
+
+EncodeStatus proto_packet_encode(uint8_t* out,
+                                 std::size_t out_cap,
+                                 std::size_t* out_len,
+                                 uint8_t msg_type,
+                                 uint8_t flags,
+                                 uint16_t seq,
+                                 const uint8_t* payload,
+                                 std::size_t payload_len)
+{
+    if (out == nullptr || out_len == nullptr) {
+        return EncodeStatus::ERR_OUT_NULL;
+    }
+    if (payload == nullptr && payload_len > 0u) {
+        return EncodeStatus::ERR_PAYLOAD_NULL;
+    }
+    if (payload_len > MAX_PAYLOAD_SIZE_BYTES) {
+        return EncodeStatus::ERR_PAYLOAD_LEN;
+    }
+
+    const std::size_t total_len = HEADER_SIZE_BYTES + payload_len + TRAILER_SIZE_BYTES;
+    if (out_cap < total_len) {
+        return EncodeStatus::ERR_OUT_SHORT;
+    }
+
+    put_u16_le(out + OFFSET_MAGIC, PROTO_MAGIC);
+    out[OFFSET_PROTO_MAJOR] = PROTO_VERSION_MAJOR;
+    out[OFFSET_PROTO_MINOR] = PROTO_VERSION_MINOR;
+    out[OFFSET_MSG_TYPE]    = msg_type;
+    out[OFFSET_FLAGS]       = flags;
+    out[OFFSET_SRC]         = NODE_ID_SPINE;
+    out[OFFSET_DST]         = NODE_ID_BRAIN;
+    put_u16_le(out + OFFSET_SEQ, seq);
+    put_u16_le(out + OFFSET_PAYLOAD_LEN, static_cast<uint16_t>(payload_len));
+
+    // header_crc16 covers the header with its own field zeroed.
+    put_u16_le(out + OFFSET_HEADER_CRC16, 0u);
+    put_u16_le(out + OFFSET_HEADER_CRC16, proto_crc16_ccitt_false(out, HEADER_SIZE_BYTES));
+
+    if (payload_len > 0u) {
+        std::memcpy(out + HEADER_SIZE_BYTES, payload, payload_len);
+    }
+    put_u32_le(out + HEADER_SIZE_BYTES + payload_len + OFFSET_PAYLOAD_CRC32_IN_TRAILER,
+               proto_crc32_iso_hdlc(out + HEADER_SIZE_BYTES, payload_len));
+
+    *out_len = total_len;
+    return EncodeStatus::OK;
+}
+
+} // namespace proto
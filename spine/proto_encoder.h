@@ -0,0 +1,49 @@
+#ifndef PROTO_ENCODER_H
+#define PROTO_ENCODER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace proto {
+
+/**
+ * @brief Packet encoding result codes.
+ */
+enum class EncodeStatus {
+    OK,
+    ERR_OUT_NULL,        // Output buffer or length pointer is null
+    ERR_PAYLOAD_NULL,    // payload is null but payload_len > 0
+    ERR_PAYLOAD_LEN,     // payload_len above MAX_PAYLOAD_SIZE_BYTES
+    ERR_OUT_SHORT        // out_cap cannot hold header + payload + trailer
+};
+
+/**
+ * @brief Encode one Spine -> Brain packet into a contiguous buffer.
+ *
+ * Writes the header (magic, version, src = Spine, dst = Brain, header
+ * CRC16), copies the payload and appends the payload CRC32 trailer, all
+ * little-endian. The result passes proto_packet_validate.
+ *
+ * No transport I/O, no allocation. Work is bounded by payload_len.
+ *
+ * @param out          Destination buffer.
+ * @param out_cap      Size of `out` in bytes.
+ * @param out_len      Receives the encoded packet length on success.
+ * @param msg_type     Message type (MSG_ID_S2B_*).
+ * @param flags        Header flags byte.
+ * @param seq          Sender sequence number.
+ * @param payload      Payload bytes; may be null only if payload_len == 0.
+ * @param payload_len  Payload length in bytes.
+ */
+EncodeStatus proto_packet_encode(uint8_t* out,
+                                 std::size_t out_cap,
+                                 std::size_t* out_len,
+                                 uint8_t msg_type,
+                                 uint8_t flags,
+                                 uint16_t seq,
+                                 const uint8_t* payload,
+                                 std::size_t payload_len);
+
+} // namespace proto
+
+#endif // PROTO_ENCODER_H
@@ -0,0 +1,126 @@
+#include "proto_framer.h"
+#include "proto_header.h"
+#include "proto_packet.h"
+#include "proto_placement.h"
+
+#include <cstring>
+
+namespace proto {
+
+static void PROTO_HOT_FUNC(framer_discard_front)(Framer* framer, std::size_t count) {
+    if (count >= framer->fill_len) {
+        framer->fill_len = 0;
+        return;
+    }
+    std::memmove(framer->buffer, framer->buffer + count, framer->fill_len - count);
+    framer->fill_len -= count;
+}
+
+void proto_framer_init(Framer* framer) {
+    if (framer == nullptr) {
+        return;
+    }
+    framer->fill_len = 0;
+    framer->dropped_byte_count = 0;
+    framer->header_error_count = 0;
+    framer->packet_error_count = 0;
+    framer->packet_ok_count = 0;
+}
+
+/*
+ * Try to extract one packet from the front of the buffer.
+ *
+ * Returns true if the buffer changed (bytes consumed or discarded) and the
+ * caller should try again; false if more input is required.
+ */
+static bool PROTO_HOT_FUNC(framer_step)(Framer* framer, FramerPacketCallback callback, void* callback_ctx) {
+    const uint8_t magic_lo = static_cast<uint8_t>(PROTO_MAGIC & 0xFFu);
+    const uint8_t magic_hi = static_cast<uint8_t>((PROTO_MAGIC >> 8) & 0xFFu);
+
+    if (framer->fill_len < 2u) {
+        return false;
+    }
+
+    if (framer->buffer[0] != magic_lo || framer->buffer[1] != magic_hi) {
+        framer_discard_front(framer, 1u);
+        framer->dropped_byte_count++;
+        return true;
+    }
+
+    if (framer->fill_len < HEADER_SIZE_BYTES) {
+        return false;
+    }
+
+    Header header;
+    if (proto_header_parse_and_validate(&header, framer->buffer, HEADER_SIZE_BYTES) != HeaderStatus::OK) {
+        framer_discard_front(framer, 1u);
+        framer->header_error_count++;
+        framer->dropped_byte_count++;
+        return true;
+    }
+
+    const std::size_t packet_len =
+        HEADER_SIZE_BYTES + static_cast<std::size_t>(header.payload_len) + TRAILER_SIZE_BYTES;
+
+    if (framer->fill_len < packet_len) {
+        return false;
+    }
+
+    if (proto_packet_validate(framer->buffer, packet_len) != PacketStatus::OK) {
+        framer_discard_front(framer, 1u);
+        framer->packet_error_count++;
+        framer->dropped_byte_count++;
+        return true;
+    }
+
+    framer->packet_ok_count++;
+    callback(framer->buffer, packet_len, callback_ctx);
+    framer_discard_front(framer, packet_len);
+    return true;
+}
+
+void PROTO_HOT_FUNC(proto_framer_push)(Framer* framer,
+                                       const uint8_t* data,
+                                       std::size_t len,
+                                       FramerPacketCallback callback,
+                                       void* callback_ctx) {
+    if (framer == nullptr || callback == nullptr) {
+        return;
+    }
+    if (data == nullptr && len != 0) {
+        return;
+    }
+
+    std::size_t in_idx = 0;
+
+    // Bounded: every pass copies input, discards a byte, or consumes a packet.
+    while (true) {
+        const std::size_t space = FRAMER_BUFFER_SIZE_BYTES - framer->fill_len;
+        std::size_t take = len - in_idx;
+        if (take > space) {
+            take = space;
+        }
+        if (take > 0) {
+            std::memcpy(framer->buffer + framer->fill_len, data + in_idx, take);
+            framer->fill_len += take;
+            in_idx += take;
+        }
+
+        if (framer_step(framer, callback, callback_ctx)) {
+            continue;
+        }
+
+        if (in_idx >= len) {
+            return;
+        }
+
+        // Buffer full yet no packet can complete: only reachable if the
+        // payload cap and buffer size disagree. Drop a byte to stay live.
+        if (framer->fill_len == FRAMER_BUFFER_SIZE_BYTES) {
+            framer_discard_front(framer, 1u);
+            framer->dropped_byte_count++;
+        }
+    }
+}
+
+} // namespace proto
@@ -0,0 +1,66 @@
+#ifndef PROTO_FRAMER_H
+#define PROTO_FRAMER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "proto_constants.h"
+
+namespace proto {
+
+/*
+ * Largest packet the framer can hold: header + capped payload + trailer.
+ */
+static constexpr std::size_t FRAMER_BUFFER_SIZE_BYTES =
+    HEADER_SIZE_BYTES + MAX_PAYLOAD_SIZE_BYTES + TRAILER_SIZE_BYTES;
+
+/**
+ * @brief Receives one fully validated packet.
+ *
+ * `packet` points into the framer buffer and is only valid for the duration
+ * of the call.
+ */
+typedef void (*FramerPacketCallback)(const uint8_t* packet,
+                                     std::size_t packet_len,
+                                     void* ctx);
+
+/**
+ * @brief Stream framer / resynchronizer state.
+ *
+ * Owned by exactly one receive context. Not safe for concurrent pushes.
+ */
+struct Framer {
+    uint8_t     buffer[FRAMER_BUFFER_SIZE_BYTES];
+    std::size_t fill_len;
+
+    // Diagnostic counters (wrap silently).
+    uint32_t dropped_byte_count;   // bytes discarded while resynchronizing
+    uint32_t header_error_count;   // magic matched, header rejected
+    uint32_t packet_error_count;   // header accepted, packet rejected
+    uint32_t packet_ok_count;      // packets delivered to the callback
+};
+
+/**
+ * @brief Reset framer state and counters.
+ */
+void proto_framer_init(Framer* framer);
+
+/**
+ * @brief Feed raw transport bytes into the framer.
+ *
+ * Every complete packet that passes proto_packet_validate is delivered to
+ * `callback`. Corrupt candidates are resolved by discarding a single byte
+ * and rescanning for magic, so one bad length field cannot swallow the
+ * packets that follow it.
+ *
+ * Work per call is bounded by len + FRAMER_BUFFER_SIZE_BYTES discards.
+ */
+void proto_framer_push(Framer* framer,
+                       const uint8_t* data,
+                       std::size_t len,
+                       FramerPacketCallback callback,
+                       void* callback_ctx);
+
+} // namespace proto
+
+#endif // PROTO_FRAMER_H
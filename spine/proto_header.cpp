@@ -1,10 +1,11 @@
 #include "proto_header.h"
 #include "proto_constants.h"
 #include "proto_crc.h"
+#include "proto_placement.h"
 
 namespace proto {
 
-HeaderStatus proto_header_parse_and_validate(
+HeaderStatus PROTO_HOT_FUNC(proto_header_parse_and_validate)(
     Header* out,
     const uint8_t* buf,
     std::size_t buf_len)
@@ -2,10 +2,11 @@
 #include "proto_constants.h"
 #include "proto_header.h"
 #include "proto_crc.h"
+#include "proto_placement.h"
 
 namespace proto {
 
-PacketStatus proto_packet_validate(const uint8_t* buf, std::size_t buf_len) {
+PacketStatus PROTO_HOT_FUNC(proto_packet_validate)(const uint8_t* buf, std::size_t buf_len) {
     if (buf == nullptr) {
         return PacketStatus::ERR_BUF_NULL;
     }
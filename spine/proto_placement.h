@@ -0,0 +1,24 @@
+#ifndef PROTO_PLACEMENT_H
+#define PROTO_PLACEMENT_H
+
+/*
+ * Code placement for the packet receive hot path.
+ *
+ * PROTO_HOT_FUNC(name) wraps the definition of every function a received
+ * packet passes through (framer, header and packet validation, CRCs).
+ * With PROTO_HOT_PATH_RAM the linker places them in SRAM
+ * (__not_in_flash_func), so validation latency no longer depends on
+ * whether the OLED / I2C drivers just evicted them from the 16 KB XIP
+ * cache. Without it they stay in flash like the rest of the image.
+ *
+ * Host builds never define PROTO_HOT_PATH_RAM.
+ */
+
+#if defined(PROTO_HOT_PATH_RAM)
+#include "pico/platform.h"
+#define PROTO_HOT_FUNC(name) __not_in_flash_func(name)
+#else
+#define PROTO_HOT_FUNC(name) name
+#endif
+
+#endif // PROTO_PLACEMENT_H
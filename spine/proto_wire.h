@@ -0,0 +1,39 @@
+#ifndef PROTO_WIRE_H
+#define PROTO_WIRE_H
+
+#include <cstdint>
+
+namespace proto {
+
+/*
+ * Little-endian field access for the wire format (header fields and
+ * payload layouts alike). Byte-wise, so alignment never matters.
+ */
+
+static inline void put_u16_le(uint8_t* dst, uint16_t v) {
+    dst[0] = static_cast<uint8_t>(v & 0xFFu);
+    dst[1] = static_cast<uint8_t>(v >> 8);
+}
+
+static inline void put_u32_le(uint8_t* dst, uint32_t v) {
+    dst[0] = static_cast<uint8_t>(v & 0xFFu);
+    dst[1] = static_cast<uint8_t>((v >> 8) & 0xFFu);
+    dst[2] = static_cast<uint8_t>((v >> 16) & 0xFFu);
+    dst[3] = static_cast<uint8_t>(v >> 24);
+}
+
+static inline uint16_t get_u16_le(const uint8_t* src) {
+    return static_cast<uint16_t>(static_cast<uint16_t>(src[0]) |
+                                 (static_cast<uint16_t>(src[1]) << 8));
+}
+
+static inline uint32_t get_u32_le(const uint8_t* src) {
+    return static_cast<uint32_t>(src[0]) |
+           (static_cast<uint32_t>(src[1]) << 8) |
+           (static_cast<uint32_t>(src[2]) << 16) |
+           (static_cast<uint32_t>(src[3]) << 24);
+}
+
+} // namespace proto
+
+#endif // PROTO_WIRE_H
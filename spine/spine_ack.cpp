@@ -0,0 +1,109 @@
+#include "spine_ack.h"
+#include "proto_encoder.h"
+#include "proto_framer.h"
+#include "proto_wire.h"
+#include "spine_link_tx.h"
+
+#include <cstring>
+
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+
+namespace spine {
+
+static constexpr uint32_t QUEUE_INDEX_MASK = ACK_QUEUE_DEPTH - 1u;
+
+struct PendingAck {
+    uint32_t rx_time_us;
+    uint16_t seq;
+    uint8_t  msg_type;
+    uint8_t  echo[ACK_ECHO_BYTES];
+};
+
+/*
+ * SPSC ring. head is written only by core0 (producer), tail only by
+ * core1 (consumer). Free-running counters.
+ */
+static PendingAck s_queue[ACK_QUEUE_DEPTH];
+static volatile uint32_t s_head = 0;
+static volatile uint32_t s_tail = 0;
+
+static volatile uint32_t s_posted_count = 0;
+static volatile uint32_t s_sent_count = 0;
+static volatile uint32_t s_dropped_count = 0;
+
+// core1 only.
+static uint16_t s_seq = 0;
+static uint8_t  s_frame[proto::FRAMER_BUFFER_SIZE_BYTES];
+
+void spine_ack_post(uint8_t msg_type, uint16_t seq, const uint8_t* payload, std::size_t payload_len) {
+    const uint32_t now_us = time_us_32();
+    const uint32_t head = s_head;
+
+    s_posted_count = s_posted_count + 1u;
+    if (head - s_tail >= ACK_QUEUE_DEPTH) {
+        s_dropped_count = s_dropped_count + 1u;
+        return;
+    }
+
+    PendingAck* ack = &s_queue[head & QUEUE_INDEX_MASK];
+    ack->rx_time_us = now_us;
+    ack->seq = seq;
+    ack->msg_type = msg_type;
+    std::memset(ack->echo, 0, sizeof(ack->echo));
+    if (payload != nullptr) {
+        std::memcpy(ack->echo, payload, (payload_len < ACK_ECHO_BYTES) ? payload_len : ACK_ECHO_BYTES);
+    }
+
+    // Publish the entry before the index that makes it visible.
+    __dmb();
+    s_head = head + 1u;
+}
+
+uint32_t spine_ack_service() {
+    uint32_t sent = 0;
+
+    while (sent < ACK_QUEUE_DEPTH) {
+        const uint32_t tail = s_tail;
+        if (tail == s_head) {
+            break;
+        }
+        __dmb();
+
+        const PendingAck* ack = &s_queue[tail & QUEUE_INDEX_MASK];
+        uint8_t payload[ACK_PAYLOAD_SIZE_BYTES];
+        payload[ACK_OFFSET_ACKED_MSG_TYPE] = ack->msg_type;
+        payload[ACK_OFFSET_LAYOUT_VERSION] = ACK_LAYOUT_VERSION;
+        proto::put_u16_le(payload + ACK_OFFSET_ACKED_SEQ, ack->seq);
+        proto::put_u32_le(payload + ACK_OFFSET_RX_TIME_US, ack->rx_time_us);
+        std::memcpy(payload + ACK_OFFSET_ECHO, ack->echo, ACK_ECHO_BYTES);
+        proto::put_u32_le(payload + ACK_OFFSET_TX_TIME_US, time_us_32());
+
+        std::size_t frame_len = 0;
+        if (proto::proto_packet_encode(s_frame, sizeof(s_frame), &frame_len, proto::MSG_ID_S2B_ACK,
+                                       0u, s_seq, payload, sizeof(payload)) != proto::EncodeStatus::OK ||
+            !spine_link_tx_send(s_frame, frame_len)) {
+            break;  // retried next pass
+        }
+
+        // Finish reading the entry before handing it back to the producer.
+        __dmb();
+        s_tail = tail + 1u;
+        s_seq++;
+        sent++;
+    }
+
+    s_sent_count = s_sent_count + sent;
+    return sent;
+}
+
+void spine_ack_get_counters(AckCounters* out) {
+    if (out == nullptr) {
+        return;
+    }
+    out->posted_count = s_posted_count;
+    out->sent_count = s_sent_count;
+    out->dropped_count = s_dropped_count;
+}
+
+} // namespace spine
@@ -0,0 +1,79 @@
+#ifndef SPINE_ACK_H
+#define SPINE_ACK_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "proto_constants.h"
+
+namespace spine {
+
+/*
+ * S2B_ACK for B2S_HEARTBEAT and B2S_HELLO (round-trip probe support).
+ *
+ * core0 posts an acknowledgement after dispatching the packet; core1, the
+ * only CDC writer, sends it on its next loop pass. The ACK carries the
+ * acknowledged type and seq, Spine timestamps for receipt and
+ * transmission, and echoes the first ACK_ECHO_BYTES of the request
+ * payload (the Brain's send timestamp), so the Brain can match replies by
+ * seq and measure round trip and clock offset (link_rtt_probe).
+ *
+ * The pending queue is a single-producer / single-consumer ring. A full
+ * queue drops the new ACK and counts it; an ACK the link refuses stays
+ * queued for the next pass. Neither core ever waits.
+ *
+ * The S2B_ACK payload below is provisional: contract v0.2 names S2B_ACK
+ * but this tree carries no payload definition for it.
+ */
+
+/*
+ * S2B_ACK payload, layout version 1 (little-endian):
+ *
+ *   0   acked_msg_type  u8
+ *   1   layout_version  u8
+ *   2   acked_seq       u16
+ *   4   rx_time_us      u32  time_us_32() when core0 dispatched the request
+ *   8   tx_time_us      u32  time_us_32() when core1 encoded this ACK
+ *   12  echo            8 B  request payload bytes 0..7 (zero-padded)
+ */
+static constexpr uint8_t ACK_LAYOUT_VERSION = 1u;
+
+static constexpr std::size_t ACK_OFFSET_ACKED_MSG_TYPE = 0u;
+static constexpr std::size_t ACK_OFFSET_LAYOUT_VERSION = 1u;
+static constexpr std::size_t ACK_OFFSET_ACKED_SEQ      = 2u;
+static constexpr std::size_t ACK_OFFSET_RX_TIME_US     = 4u;
+static constexpr std::size_t ACK_OFFSET_TX_TIME_US     = 8u;
+static constexpr std::size_t ACK_OFFSET_ECHO           = 12u;
+static constexpr std::size_t ACK_ECHO_BYTES            = 8u;
+static constexpr std::size_t ACK_PAYLOAD_SIZE_BYTES    = 20u;
+
+// ACKs waiting for core1. Power of two. Covers a probe well above the
+// contract heartbeat rate while core1 runs a long task.
+static constexpr uint32_t ACK_QUEUE_DEPTH = 8u;
+
+static_assert((ACK_QUEUE_DEPTH & (ACK_QUEUE_DEPTH - 1u)) == 0u,
+              "ACK_QUEUE_DEPTH must be a power of two");
+
+struct AckCounters {
+    uint32_t posted_count;
+    uint32_t sent_count;
+    uint32_t dropped_count;    // queue full when posted
+};
+
+/*
+ * core0. Queue an ACK for a dispatched request. `payload` may be null
+ * when payload_len is 0.
+ */
+void spine_ack_post(uint8_t msg_type, uint16_t seq, const uint8_t* payload, std::size_t payload_len);
+
+/*
+ * core1. Send queued ACKs until the queue is empty or the link refuses
+ * one. Bounded by ACK_QUEUE_DEPTH. Returns ACKs sent.
+ */
+uint32_t spine_ack_service();
+
+void spine_ack_get_counters(AckCounters* out);
+
+} // namespace spine
+
+#endif // SPINE_ACK_H
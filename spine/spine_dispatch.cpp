@@ -0,0 +1,71 @@
+#include "spine_dispatch.h"
+#include "spine_ack.h"
+#include "spine_event_log.h"
+#include "spine_timing.h"
+#include "proto_constants.h"
+#include "proto_header.h"
+
+namespace spine {
+
+static DispatchCounters s_counters;
+
+void spine_dispatch_init() {
+    s_counters.heartbeat_count = 0;
+    s_counters.ignored_count = 0;
+    s_counters.unknown_type_count = 0;
+    s_counters.misaddressed_count = 0;
+}
+
+void spine_dispatch_packet(const uint8_t* packet, std::size_t packet_len, void* ctx) {
+    (void)ctx;
+
+    proto::Header header;
+    if (proto::proto_header_parse_and_validate(&header, packet, packet_len) != proto::HeaderStatus::OK) {
+        return;
+    }
+
+    if (header.src != proto::NODE_ID_BRAIN || header.dst != proto::NODE_ID_SPINE) {
+        s_counters.misaddressed_count++;
+        spine_event_log_record(EVENT_MISADDRESSED, header.src, header.dst);
+        return;
+    }
+
+    switch (header.msg_type) {
+    case proto::MSG_ID_B2S_HEARTBEAT:
+        s_counters.heartbeat_count++;
+        spine_timing_keepalive_received();
+        spine_ack_post(header.msg_type, header.seq, packet + proto::HEADER_SIZE_BYTES, header.payload_len);
+        return;
+
+    case proto::MSG_ID_B2S_HELLO:
+        // No session handling yet; acknowledged for round-trip probing.
+        s_counters.ignored_count++;
+        spine_ack_post(header.msg_type, header.seq, packet + proto::HEADER_SIZE_BYTES, header.payload_len);
+        return;
+
+    case proto::MSG_ID_B2S_MOTION_ENABLE:
+    case proto::MSG_ID_B2S_MOTION_SETPOINT:
+        // Motion is not implemented; setpoints and enables are ignored.
+        s_counters.ignored_count++;
+        return;
+
+    case proto::MSG_ID_B2S_EVENT_LOG_REQUEST:
+        // Diagnostic only: core1 sends the dump when the link has room.
+        spine_event_log_request_dump();
+        return;
+
+    default:
+        s_counters.unknown_type_count++;
+        spine_event_log_record(EVENT_UNKNOWN_MSG, header.msg_type, header.seq);
+        return;
+    }
+}
+
+void spine_dispatch_get_counters(DispatchCounters* out) {
+    if (out == nullptr) {
+        return;
+    }
+    *out = s_counters;
+}
+
+} // namespace spine
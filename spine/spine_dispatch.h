@@ -0,0 +1,39 @@
+#ifndef SPINE_DISPATCH_H
+#define SPINE_DISPATCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace spine {
+
+/*
+ * Packet dispatcher stub (Backlog B-014).
+ *
+ * Routes packets that already passed proto_packet_validate by msg_type.
+ * Only B2S_HEARTBEAT has behavior today: it is the sole keepalive
+ * (Contract v0.2 Section 3.2). B2S_HEARTBEAT and B2S_HELLO are answered
+ * with S2B_ACK (spine_ack). B2S_EVENT_LOG_REQUEST (diagnostic
+ * extension) schedules an event log dump and touches no state.
+ * Everything else is counted and ignored; unknown message types MUST NOT
+ * trigger action.
+ */
+
+struct DispatchCounters {
+    uint32_t heartbeat_count;
+    uint32_t ignored_count;        // defined types without behavior yet
+    uint32_t unknown_type_count;
+    uint32_t misaddressed_count;   // src/dst do not describe Brain -> Spine
+};
+
+void spine_dispatch_init();
+
+/*
+ * FramerPacketCallback-compatible entry point. `ctx` is unused.
+ */
+void spine_dispatch_packet(const uint8_t* packet, std::size_t packet_len, void* ctx);
+
+void spine_dispatch_get_counters(DispatchCounters* out);
+
+} // namespace spine
+
+#endif // SPINE_DISPATCH_H
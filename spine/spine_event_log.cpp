@@ -0,0 +1,237 @@
+#include "spine_event_log.h"
+#include "proto_encoder.h"
+#include "proto_framer.h"
+#include "proto_wire.h"
+
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+
+namespace spine {
+
+static constexpr uint32_t RING_INDEX_MASK = EVENT_LOG_RECORDS_PER_CORE - 1u;
+
+struct EventRecord {
+    uint32_t time_us;
+    uint16_t event_id;
+    uint16_t reserved;
+    uint32_t arg0;
+    uint32_t arg1;
+};
+
+/*
+ * head counts records committed to this ring since boot; the record with
+ * index i lives in slot i & RING_INDEX_MASK. Only the owning core writes
+ * either, with its interrupts masked.
+ */
+struct EventRing {
+    EventRecord records[EVENT_LOG_RECORDS_PER_CORE];
+    volatile uint32_t head;
+};
+
+static EventRing s_rings[EVENT_LOG_CORE_COUNT];
+
+// Set by any core, cleared by core1 when it starts a dump.
+static volatile bool s_dump_pending = false;
+
+/*
+ * Dump progress. core1 only. The cursor moves only when a frame has been
+ * accepted by the link, so a refused frame is rebuilt from the same place.
+ */
+struct DumpState {
+    bool     active;
+    uint32_t core;
+    uint32_t next;          // next ring index to send
+    uint32_t end;           // ring head when this core's dump started
+    bool     gap;           // records were lost since the last frame sent
+    uint32_t dump_number;
+    uint16_t seq;
+    uint8_t  frame[proto::FRAMER_BUFFER_SIZE_BYTES];
+};
+
+static DumpState s_dump;
+
+static volatile uint32_t s_dump_count = 0;
+static volatile uint32_t s_dump_frame_count = 0;
+static volatile uint32_t s_dump_lost_record_count = 0;
+
+void spine_event_log_init() {
+    for (uint32_t c = 0; c < EVENT_LOG_CORE_COUNT; ++c) {
+        s_rings[c].head = 0;
+    }
+    s_dump_pending = false;
+    s_dump.active = false;
+}
+
+void spine_event_log_record(uint16_t event_id, uint32_t arg0, uint32_t arg1) {
+    EventRing* ring = &s_rings[get_core_num()];
+
+    // Masked only against this core's own IRQs; the other core never
+    // writes this ring.
+    const uint32_t irq_state = save_and_disable_interrupts();
+
+    const uint32_t index = ring->head;
+    EventRecord* record = &ring->records[index & RING_INDEX_MASK];
+    record->time_us = time_us_32();
+    record->event_id = event_id;
+    record->reserved = 0u;
+    record->arg0 = arg0;
+    record->arg1 = arg1;
+
+    // Record contents before the head that makes them visible.
+    __dmb();
+    ring->head = index + 1u;
+
+    restore_interrupts(irq_state);
+}
+
+void spine_event_log_request_dump() {
+    s_dump_pending = true;
+}
+
+static void dump_start_core(uint32_t core) {
+    const uint32_t head = s_rings[core].head;
+    __dmb();
+
+    // The slot of head - N is the one the next record overwrites, possibly
+    // right now, so the oldest record a dump can trust is head - N + 1.
+    s_dump.core = core;
+    s_dump.end = head;
+    s_dump.next = (head >= EVENT_LOG_RECORDS_PER_CORE) ? head - EVENT_LOG_RECORDS_PER_CORE + 1u : 0u;
+}
+
+/*
+ * Copy records [next, end) of the current core into the frame payload,
+ * up to EVENT_LOG_RECORDS_PER_FRAME. A record is kept only if the head
+ * read after copying shows its slot was not reused meanwhile. Overwritten
+ * records at the start of a frame are skipped (counted in *lost, *gap set);
+ * later in a frame they end it, so a frame's records are contiguous from
+ * first_index. Bounded by EVENT_LOG_RECORDS_PER_FRAME copies plus one
+ * skip per overrun.
+ */
+static uint32_t dump_fill_payload(uint8_t* records_out, uint32_t* next, uint32_t* lost, bool* gap) {
+    const EventRing* ring = &s_rings[s_dump.core];
+    uint32_t count = 0;
+
+    while (count < EVENT_LOG_RECORDS_PER_FRAME && *next != s_dump.end) {
+        const EventRecord record = ring->records[*next & RING_INDEX_MASK];
+        __dmb();
+        const uint32_t head = ring->head;
+
+        if (head - *next >= EVENT_LOG_RECORDS_PER_CORE) {
+            if (count > 0u) {
+                break;  // records in a frame stay contiguous; skip in the next one
+            }
+            // Overwritten. The oldest record still intact is head - N + 1.
+            const uint32_t oldest = head - EVENT_LOG_RECORDS_PER_CORE + 1u;
+            const uint32_t resume = (oldest - *next < s_dump.end - *next) ? oldest : s_dump.end;
+            *lost += resume - *next;
+            *next = resume;
+            *gap = true;
+            continue;
+        }
+
+        uint8_t* out = records_out + count * EVENT_LOG_RECORD_BYTES;
+        proto::put_u32_le(out + EVENT_LOG_RECORD_OFFSET_TIME_US, record.time_us);
+        proto::put_u16_le(out + EVENT_LOG_RECORD_OFFSET_EVENT_ID, record.event_id);
+        proto::put_u16_le(out + EVENT_LOG_RECORD_OFFSET_EVENT_ID + 2u, 0u);
+        proto::put_u32_le(out + EVENT_LOG_RECORD_OFFSET_ARG0, record.arg0);
+        proto::put_u32_le(out + EVENT_LOG_RECORD_OFFSET_ARG1, record.arg1);
+        count++;
+        (*next)++;
+    }
+    return count;
+}
+
+/*
+ * Build and send one frame. Returns false if the link refused it; the
+ * dump state is then unchanged.
+ */
+static bool dump_send_frame() {
+    uint8_t payload[EVENT_LOG_FRAME_HEADER_BYTES + EVENT_LOG_RECORDS_PER_FRAME * EVENT_LOG_RECORD_BYTES];
+
+    uint32_t next = s_dump.next;
+    uint32_t lost = 0;
+    bool gap = s_dump.gap;
+    const uint32_t count = dump_fill_payload(payload + EVENT_LOG_FRAME_HEADER_BYTES, &next, &lost, &gap);
+    const uint32_t first_index = next - count;
+    const bool last = (next == s_dump.end);
+
+    payload[EVENT_LOG_OFFSET_LAYOUT_VERSION] = EVENT_LOG_LAYOUT_VERSION;
+    payload[EVENT_LOG_OFFSET_CORE] = static_cast<uint8_t>(s_dump.core);
+    payload[EVENT_LOG_OFFSET_RECORD_COUNT] = static_cast<uint8_t>(count);
+    payload[EVENT_LOG_OFFSET_FLAGS] = static_cast<uint8_t>((last ? EVENT_LOG_FLAG_LAST_FRAME : 0u) |
+                                                           (gap ? EVENT_LOG_FLAG_GAP : 0u));
+    proto::put_u32_le(payload + EVENT_LOG_OFFSET_FIRST_INDEX, first_index);
+
+    std::size_t frame_len = 0;
+    const proto::EncodeStatus status =
+        proto::proto_packet_encode(s_dump.frame, sizeof(s_dump.frame), &frame_len,
+                                   proto::MSG_ID_S2B_EVENT_LOG, 0u, s_dump.seq, payload,
+                                   EVENT_LOG_FRAME_HEADER_BYTES + count * EVENT_LOG_RECORD_BYTES);
+    if (status != proto::EncodeStatus::OK || !spine_link_tx_send(s_dump.frame, frame_len)) {
+        return false;
+    }
+
+    s_dump.seq++;
+    s_dump.next = next;
+    s_dump.gap = false;
+    s_dump_frame_count = s_dump_frame_count + 1u;
+    s_dump_lost_record_count = s_dump_lost_record_count + lost;
+
+    if (last) {
+        if (s_dump.core + 1u < EVENT_LOG_CORE_COUNT) {
+            dump_start_core(s_dump.core + 1u);
+        } else {
+            s_dump.active = false;
+            s_dump_count = s_dump_count + 1u;
+        }
+    }
+    return true;
+}
+
+void spine_event_log_service_dump() {
+    if (!s_dump.active) {
+        if (!s_dump_pending) {
+            return;
+        }
+        s_dump_pending = false;
+        s_dump.active = true;
+        s_dump.gap = false;
+        s_dump.dump_number++;
+        spine_event_log_record(EVENT_LOG_DUMP, s_dump.dump_number, 0u);
+        dump_start_core(0u);
+    }
+
+    for (uint32_t i = 0; i < EVENT_LOG_DUMP_FRAMES_PER_RUN && s_dump.active; ++i) {
+        if (!dump_send_frame()) {
+            return;  // link full; retried next run
+        }
+    }
+}
+
+static void run_event_log_dump(void* ctx) {
+    (void)ctx;
+    spine_event_log_service_dump();
+}
+
+static PeriodicTask s_dump_task = {
+    "event_log_dump", EVENT_LOG_DUMP_PERIOD_US, EVENT_LOG_DUMP_BUDGET_US, run_event_log_dump, nullptr, 1u
+};
+
+bool spine_event_log_start_dump_task() {
+    return spine_timing_add_periodic_task(&s_dump_task);
+}
+
+void spine_event_log_get_counters(EventLogCounters* out) {
+    if (out == nullptr) {
+        return;
+    }
+    for (uint32_t c = 0; c < EVENT_LOG_CORE_COUNT; ++c) {
+        out->recorded_count[c] = s_rings[c].head;
+    }
+    out->dump_count = s_dump_count;
+    out->dump_frame_count = s_dump_frame_count;
+    out->dump_lost_record_count = s_dump_lost_record_count;
+}
+
+} // namespace spine
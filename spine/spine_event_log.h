@@ -0,0 +1,134 @@
+#ifndef SPINE_EVENT_LOG_H
+#define SPINE_EVENT_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "proto_constants.h"
+#include "spine_link_tx.h"
+#include "spine_timing.h"
+
+namespace spine {
+
+/*
+ * In-RAM event log (flight recorder).
+ *
+ * Fixed 16-byte binary records: timestamp, event ID, two arguments. No
+ * formatting on the Spine; names and meaning live on the Brain
+ * (link_event_log). Recording costs a timer read and a handful of stores.
+ *
+ * One ring per core, written only by that core (thread code and its IRQs),
+ * so the cores never contend. The M0+ has no exclusive load/store, so a
+ * record is written with the core's interrupts masked for those few
+ * stores; nothing is ever waited on. When a ring is full the oldest
+ * record is overwritten.
+ *
+ * Dump: B2S_EVENT_LOG_REQUEST (diagnostic extension) marks a dump
+ * pending. The core1 task "event_log_dump" then sends both rings, oldest
+ * record first (the newest EVENT_LOG_RECORDS_PER_CORE - 1 records of each:
+ * the slot after the head may be mid-write), as consecutive S2B_EVENT_LOG frames of
+ * EVENT_LOG_RECORDS_PER_FRAME records, a few frames per run. A frame the
+ * link refuses is retried next run. Records overwritten while the dump is
+ * in progress are skipped and counted; the frame flags say so.
+ */
+
+// Records per core. Power of two: the slot is index & (count - 1).
+static constexpr uint32_t EVENT_LOG_RECORDS_PER_CORE = 128u;
+static constexpr uint32_t EVENT_LOG_CORE_COUNT = 2u;
+
+static_assert((EVENT_LOG_RECORDS_PER_CORE & (EVENT_LOG_RECORDS_PER_CORE - 1u)) == 0u,
+              "EVENT_LOG_RECORDS_PER_CORE must be a power of two");
+
+// Event IDs. Stable once released: the Brain decodes by number.
+enum EventId : uint16_t {
+    EVENT_NONE            = 0u,
+    EVENT_BOOT            = 1u,   // arg0: hold timeout us
+    EVENT_STATE_CHANGE    = 2u,   // arg0: old state, arg1: new state
+    EVENT_FORCED_SAFE     = 3u,   // arg0: fault code, arg1: forced-safe count
+    EVENT_HOLD_TIMEOUT    = 4u,   // arg0: deadline -> SAFE latency us, arg1: state
+    EVENT_TASK_OVERRUN    = 5u,   // arg0: task index, arg1: run time us
+    EVENT_MAILBOX_DROP    = 6u,   // arg0: packet length, arg1: slots in use
+    EVENT_UNKNOWN_MSG     = 7u,   // arg0: msg_type, arg1: seq
+    EVENT_MISADDRESSED    = 8u,   // arg0: src, arg1: dst
+    EVENT_LOG_DUMP        = 9u,   // arg0: dump number
+};
+
+/*
+ * S2B_EVENT_LOG payload, layout version 1 (little-endian):
+ *
+ *   0  layout_version  u8
+ *   1  core            u8   ring being dumped
+ *   2  record_count    u8
+ *   3  flags           u8   EVENT_LOG_FLAG_*
+ *   4  first_index     u32  ring index of the first record (free-running)
+ *   8  records         record_count x 16 bytes:
+ *        0 time_us u32, 4 event_id u16, 6 reserved u16 (0),
+ *        8 arg0 u32, 12 arg1 u32
+ */
+static constexpr uint8_t EVENT_LOG_LAYOUT_VERSION = 1u;
+
+static constexpr std::size_t EVENT_LOG_OFFSET_LAYOUT_VERSION = 0u;
+static constexpr std::size_t EVENT_LOG_OFFSET_CORE           = 1u;
+static constexpr std::size_t EVENT_LOG_OFFSET_RECORD_COUNT   = 2u;
+static constexpr std::size_t EVENT_LOG_OFFSET_FLAGS          = 3u;
+static constexpr std::size_t EVENT_LOG_OFFSET_FIRST_INDEX    = 4u;
+static constexpr std::size_t EVENT_LOG_FRAME_HEADER_BYTES    = 8u;
+
+static constexpr std::size_t EVENT_LOG_RECORD_OFFSET_TIME_US  = 0u;
+static constexpr std::size_t EVENT_LOG_RECORD_OFFSET_EVENT_ID = 4u;
+static constexpr std::size_t EVENT_LOG_RECORD_OFFSET_ARG0     = 8u;
+static constexpr std::size_t EVENT_LOG_RECORD_OFFSET_ARG1     = 12u;
+static constexpr std::size_t EVENT_LOG_RECORD_BYTES           = 16u;
+
+static constexpr uint8_t EVENT_LOG_FLAG_LAST_FRAME = 0x01u;  // end of this core's ring
+static constexpr uint8_t EVENT_LOG_FLAG_GAP        = 0x02u;  // records lost before this frame
+
+// As many records as fit the largest frame the link accepts whole.
+static constexpr uint32_t EVENT_LOG_RECORDS_PER_FRAME = static_cast<uint32_t>(
+    (LINK_TX_MAX_FRAME_BYTES - proto::MIN_PACKET_SIZE_BYTES - EVENT_LOG_FRAME_HEADER_BYTES) /
+    EVENT_LOG_RECORD_BYTES);
+
+static constexpr uint32_t EVENT_LOG_DUMP_PERIOD_US      = 5u * US_PER_MS;
+static constexpr uint32_t EVENT_LOG_DUMP_BUDGET_US      = 1u * US_PER_MS;
+static constexpr uint32_t EVENT_LOG_DUMP_FRAMES_PER_RUN = 4u;
+
+struct EventLogCounters {
+    uint32_t recorded_count[EVENT_LOG_CORE_COUNT];  // records written since boot
+    uint32_t dump_count;                            // dumps completed
+    uint32_t dump_frame_count;
+    uint32_t dump_lost_record_count;                // overwritten mid-dump
+};
+
+/*
+ * Reset both rings. Call once on core0 before anything records.
+ */
+void spine_event_log_init();
+
+/*
+ * Append one record to the calling core's ring. Any core, thread or IRQ
+ * context. Never blocks.
+ */
+void spine_event_log_record(uint16_t event_id, uint32_t arg0, uint32_t arg1);
+
+/*
+ * Ask for a dump of both rings. Any core. A request that arrives while a
+ * dump is in progress starts another dump once it completes.
+ */
+void spine_event_log_request_dump();
+
+/*
+ * Register the core1 dump task. Call from core0 after spine_timing_init()
+ * and before spine_runtime_start_link_core().
+ */
+bool spine_event_log_start_dump_task();
+
+/*
+ * Dump task body, exposed for host simulations. core1 only.
+ */
+void spine_event_log_service_dump();
+
+void spine_event_log_get_counters(EventLogCounters* out);
+
+} // namespace spine
+
+#endif // SPINE_EVENT_LOG_H
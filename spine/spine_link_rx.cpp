@@ -0,0 +1,203 @@
+#include "spine_link_rx.h"
+
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+#include "tusb.h"
+
+namespace spine {
+
+static constexpr uint32_t RING_INDEX_MASK  = LINK_RX_RING_BYTES - 1u;
+static constexpr uint32_t STAMP_INDEX_MASK = LINK_RX_STAMP_COUNT - 1u;
+
+// One CDC OUT packet; the discard size when the ring is full.
+static constexpr uint32_t USB_PACKET_BYTES = 64u;
+
+struct ArrivalStamp {
+    uint32_t end;      // ring byte counter just past the chunk
+    uint32_t time_us;
+};
+
+/*
+ * Byte ring and arrival stamps. Producer: tud_cdc_rx_cb (tud_task).
+ * Consumer: spine_link_rx_poll. Both run in the core1 loop (spine_runtime);
+ * the ring lets the callback empty the CDC FIFO at once while framing
+ * stays bounded per pass. Free-running counters; each head is written
+ * only by the producer, each tail only by the consumer.
+ */
+static uint8_t s_ring[LINK_RX_RING_BYTES];
+static volatile uint32_t s_ring_head = 0;
+static volatile uint32_t s_ring_tail = 0;
+
+static ArrivalStamp s_stamps[LINK_RX_STAMP_COUNT];
+static volatile uint32_t s_stamp_head = 0;
+static volatile uint32_t s_stamp_tail = 0;
+
+// Arrival of the newest chunk; covers bytes that found no free stamp.
+static volatile uint32_t s_last_arrival_us = 0;
+
+static volatile uint32_t s_rx_byte_count = 0;
+static volatile uint32_t s_overflow_byte_count = 0;
+
+// core1 only.
+static proto::Framer s_framer;
+static proto::FramerPacketCallback s_callback = nullptr;
+static void* s_callback_ctx = nullptr;
+static uint32_t s_segment_arrival_us = 0;
+static uint32_t s_packet_count = 0;
+static uint32_t s_latency_last_us = 0;
+static uint32_t s_latency_max_us = 0;
+static uint64_t s_latency_total_us = 0;
+
+} // namespace spine
+
+/*
+ * TinyUSB: data arrived on the CDC OUT endpoint. Runs in tud_task() on
+ * core1. Takes everything the CDC FIFO holds so TinyUSB can re-arm the
+ * endpoint at once.
+ */
+extern "C" void tud_cdc_rx_cb(uint8_t itf) {
+    using namespace spine;
+    (void)itf;
+
+    const uint32_t now_us = time_us_32();
+    const uint32_t tail = s_ring_tail;
+    uint32_t head = s_ring_head;
+    uint32_t taken = 0;
+    uint32_t dropped = 0;
+
+    while (tud_cdc_available() > 0u) {
+        const uint32_t space = LINK_RX_RING_BYTES - (head - tail);
+        uint32_t n;
+        if (space == 0u) {
+            uint8_t discard[USB_PACKET_BYTES];
+            n = tud_cdc_read(discard, sizeof(discard));
+            dropped += n;
+        } else {
+            const uint32_t offset = head & RING_INDEX_MASK;
+            const uint32_t contiguous = LINK_RX_RING_BYTES - offset;
+            n = tud_cdc_read(&s_ring[offset], (space < contiguous) ? space : contiguous);
+            head += n;
+            taken += n;
+        }
+        if (n == 0u) {
+            break;
+        }
+    }
+
+    if (dropped > 0u) {
+        s_overflow_byte_count = s_overflow_byte_count + dropped;
+    }
+    if (taken == 0u) {
+        return;
+    }
+
+    s_last_arrival_us = now_us;
+    // Publish the bytes before the index that makes them visible.
+    __dmb();
+    s_ring_head = head;
+    s_rx_byte_count = s_rx_byte_count + taken;
+
+    const uint32_t stamp_head = s_stamp_head;
+    if (stamp_head - s_stamp_tail < LINK_RX_STAMP_COUNT) {
+        ArrivalStamp* stamp = &s_stamps[stamp_head & STAMP_INDEX_MASK];
+        stamp->end = head;
+        stamp->time_us = now_us;
+        __dmb();
+        s_stamp_head = stamp_head + 1u;
+    }
+}
+
+namespace spine {
+
+// FramerPacketCallback between the framer and the user callback.
+static void on_packet(const uint8_t* packet, std::size_t packet_len, void* ctx) {
+    (void)ctx;
+
+    const uint32_t latency_us = time_us_32() - s_segment_arrival_us;
+    s_packet_count++;
+    s_latency_last_us = latency_us;
+    s_latency_total_us += latency_us;
+    if (latency_us > s_latency_max_us) {
+        s_latency_max_us = latency_us;
+    }
+
+    s_callback(packet, packet_len, s_callback_ctx);
+}
+
+void spine_link_rx_init(proto::FramerPacketCallback callback, void* callback_ctx) {
+    // The ring is left alone: tud_task() fills it, not this call.
+    proto::proto_framer_init(&s_framer);
+    s_callback = callback;
+    s_callback_ctx = callback_ctx;
+}
+
+uint32_t spine_link_rx_poll() {
+    if (s_callback == nullptr) {
+        return 0;
+    }
+
+    const uint32_t head = s_ring_head;
+    __dmb();
+    const uint32_t newest_us = s_last_arrival_us;
+    uint32_t tail = s_ring_tail;
+
+    uint32_t pending = head - tail;
+    if (pending > LINK_RX_MAX_BYTES_PER_POLL) {
+        pending = LINK_RX_MAX_BYTES_PER_POLL;
+    }
+    const uint32_t end = tail + pending;
+
+    // Frame one stamped segment at a time so every packet is charged to
+    // the chunk that completed it. Bounded: each pass consumes bytes.
+    while (tail != end) {
+        uint32_t segment_end = end;
+        s_segment_arrival_us = newest_us;
+
+        const uint32_t stamp_tail = s_stamp_tail;
+        bool stamp_done = false;
+        if (stamp_tail != s_stamp_head) {
+            __dmb();
+            const ArrivalStamp stamp = s_stamps[stamp_tail & STAMP_INDEX_MASK];
+            s_segment_arrival_us = stamp.time_us;
+            if (stamp.end - tail <= end - tail) {
+                segment_end = stamp.end;
+                stamp_done = true;
+            }
+        }
+
+        while (tail != segment_end) {
+            const uint32_t offset = tail & RING_INDEX_MASK;
+            const uint32_t contiguous = LINK_RX_RING_BYTES - offset;
+            const uint32_t n = (segment_end - tail < contiguous) ? (segment_end - tail) : contiguous;
+            proto::proto_framer_push(&s_framer, &s_ring[offset], n, on_packet, nullptr);
+            tail += n;
+        }
+
+        // Finish reading before handing the space back to the producer.
+        __dmb();
+        s_ring_tail = tail;
+        if (stamp_done) {
+            s_stamp_tail = stamp_tail + 1u;
+        }
+    }
+    return pending;
+}
+
+const proto::Framer* spine_link_rx_framer() {
+    return &s_framer;
+}
+
+void spine_link_rx_get_counters(LinkRxCounters* out) {
+    if (out == nullptr) {
+        return;
+    }
+    out->rx_byte_count = s_rx_byte_count;
+    out->overflow_byte_count = s_overflow_byte_count;
+    out->packet_count = s_packet_count;
+    out->latency_last_us = s_latency_last_us;
+    out->latency_max_us = s_latency_max_us;
+    out->latency_mean_us = (s_packet_count > 0u)
+        ? static_cast<uint32_t>(s_latency_total_us / s_packet_count) : 0u;
+}
+
+} // namespace spine
@@ -0,0 +1,70 @@
+#ifndef SPINE_LINK_RX_H
+#define SPINE_LINK_RX_H
+
+#include <cstdint>
+
+#include "proto_framer.h"
+
+namespace spine {
+
+/*
+ * USB CDC receive adapter (Backlog B-013).
+ *
+ * Transport provides bytes only. TinyUSB's CDC receive callback
+ * (tud_cdc_rx_cb, run from tud_task() in the core1 loop) copies each
+ * received USB packet in one read into a single-producer /
+ * single-consumer byte ring and stamps its arrival time.
+ * spine_link_rx_poll, later in the same loop, drains the ring in bulk
+ * into the protocol framer and hands validated packets to the given
+ * callback. stdio is not on the receive path; nothing on the Spine reads
+ * stdin.
+ *
+ * A full ring drops the newest bytes and counts them; the framer resyncs
+ * on the next frame. The USB side never waits on the framer.
+ *
+ * Latency: time from the arrival of the USB packet holding a frame's
+ * last byte to the packet callback being called for it.
+ */
+
+// Bytes buffered between the USB callback and core1. Power of two.
+static constexpr uint32_t LINK_RX_RING_BYTES = 1024u;
+
+// Arrival stamps in flight. When full, the next chunk shares the newest
+// stamp's segment and its later time.
+static constexpr uint32_t LINK_RX_STAMP_COUNT = 16u;
+
+// Upper bound on bytes framed per poll; keeps each loop pass bounded.
+// One maximum-size frame.
+static constexpr uint32_t LINK_RX_MAX_BYTES_PER_POLL = 256u;
+
+static_assert((LINK_RX_RING_BYTES & (LINK_RX_RING_BYTES - 1u)) == 0u,
+              "LINK_RX_RING_BYTES must be a power of two");
+static_assert((LINK_RX_STAMP_COUNT & (LINK_RX_STAMP_COUNT - 1u)) == 0u,
+              "LINK_RX_STAMP_COUNT must be a power of two");
+
+struct LinkRxCounters {
+    uint32_t rx_byte_count;          // bytes taken from the CDC FIFO
+    uint32_t overflow_byte_count;    // dropped: ring full
+    uint32_t packet_count;           // packets handed to the callback
+    uint32_t latency_last_us;
+    uint32_t latency_max_us;
+    uint32_t latency_mean_us;
+};
+
+void spine_link_rx_init(proto::FramerPacketCallback callback, void* callback_ctx);
+
+/*
+ * core1. Non-blocking. Returns the number of bytes consumed this call.
+ */
+uint32_t spine_link_rx_poll();
+
+const proto::Framer* spine_link_rx_framer();
+
+/*
+ * core1 (the latency fields are written there).
+ */
+void spine_link_rx_get_counters(LinkRxCounters* out);
+
+} // namespace spine
+
+#endif // SPINE_LINK_RX_H
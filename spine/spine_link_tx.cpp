@@ -0,0 +1,43 @@
+#include "spine_link_tx.h"
+
+#include "tusb.h"
+
+namespace spine {
+
+static_assert(LINK_TX_MAX_FRAME_BYTES <= CFG_TUD_CDC_TX_BUFSIZE,
+              "a frame must fit the CDC TX FIFO to be sent all or nothing");
+
+static volatile uint32_t s_frame_sent_count = 0;
+static volatile uint32_t s_frame_refused_count = 0;
+static volatile uint32_t s_byte_sent_count = 0;
+
+bool spine_link_tx_send(const uint8_t* frame, std::size_t frame_len) {
+    if (frame == nullptr || frame_len == 0u) {
+        return false;
+    }
+
+    if (!tud_cdc_connected() || tud_cdc_write_available() < frame_len) {
+        s_frame_refused_count = s_frame_refused_count + 1u;
+        return false;
+    }
+
+    // Space was checked above and only this core writes, so this takes
+    // the whole frame.
+    const uint32_t written = tud_cdc_write(frame, static_cast<uint32_t>(frame_len));
+    tud_cdc_write_flush();
+
+    s_frame_sent_count = s_frame_sent_count + 1u;
+    s_byte_sent_count = s_byte_sent_count + written;
+    return true;
+}
+
+void spine_link_tx_get_counters(LinkTxCounters* out) {
+    if (out == nullptr) {
+        return;
+    }
+    out->frame_sent_count = s_frame_sent_count;
+    out->frame_refused_count = s_frame_refused_count;
+    out->byte_sent_count = s_byte_sent_count;
+}
+
+} // namespace spine
@@ -0,0 +1,42 @@
+#ifndef SPINE_LINK_TX_H
+#define SPINE_LINK_TX_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace spine {
+
+/*
+ * USB CDC transmit adapter, the counterpart of spine_link_rx.
+ *
+ * Frames go straight to the TinyUSB CDC TX FIFO, all or nothing: a frame
+ * is written only if the FIFO has room for every byte, so a backed-up
+ * link never leaves half a frame on the wire and the caller never waits.
+ * A refused frame is the caller's to drop and count.
+ *
+ * core1 only. TinyUSB does no locking of its own; core1 runs tud_task()
+ * in the same loop that sends (spine_runtime), so the FIFO and the IN
+ * endpoint have a single user and need no lock. No stdio goes over USB.
+ */
+
+// Largest frame spine_link_tx_send can ever accept: the whole CDC TX FIFO
+// (CFG_TUD_CDC_TX_BUFSIZE, tusb_config.h). Senders of bulk data size
+// their frames to this rather than to the protocol maximum.
+static constexpr std::size_t LINK_TX_MAX_FRAME_BYTES = 256u;
+
+struct LinkTxCounters {
+    uint32_t frame_sent_count;
+    uint32_t frame_refused_count;   // no host or not enough FIFO space
+    uint32_t byte_sent_count;
+};
+
+/*
+ * Non-blocking. Returns true if the whole frame was queued for transmit.
+ */
+bool spine_link_tx_send(const uint8_t* frame, std::size_t frame_len);
+
+void spine_link_tx_get_counters(LinkTxCounters* out);
+
+} // namespace spine
+
+#endif // SPINE_LINK_TX_H
@@ -0,0 +1,239 @@
+#include "spine_log.h"
+#include "proto_crc.h"
+#include "proto_encoder.h"
+#include "proto_framer.h"
+#include "proto_wire.h"
+
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+
+extern "C" const char __stop_spine_log_fmt[];
+
+namespace spine {
+
+static constexpr uint32_t RING_INDEX_MASK = LOG_RECORDS_PER_CORE - 1u;
+
+struct LogRecord {
+    uint32_t time_us;
+    uint16_t fmt_id;
+    uint8_t  arg_count;
+    uint8_t  reserved;
+    uint32_t args[SPINE_LOG_MAX_ARGS];
+};
+
+/*
+ * Same discipline as the event log: only the owning core writes a ring
+ * (IRQs masked), head counts committed records.
+ */
+struct LogRing {
+    LogRecord records[LOG_RECORDS_PER_CORE];
+    volatile uint32_t head;
+};
+
+static LogRing s_rings[LOG_CORE_COUNT];
+static volatile bool s_enabled = false;
+static uint32_t s_table_crc32 = 0;
+
+// Drain side: a single CDC writer at a time (core1, or core0 before it runs).
+static uint32_t s_read[LOG_CORE_COUNT];
+static bool     s_gap[LOG_CORE_COUNT];
+static uint16_t s_seq = 0;
+static uint8_t  s_frame[proto::FRAMER_BUFFER_SIZE_BYTES];
+
+static volatile uint32_t s_frame_count = 0;
+static volatile uint32_t s_lost_record_count = 0;
+
+static void log_append(uint32_t fmt_id, uint32_t arg_count,
+                       uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+    if (!s_enabled) {
+        return;
+    }
+
+    LogRing* ring = &s_rings[get_core_num()];
+    const uint32_t irq_state = save_and_disable_interrupts();
+
+    const uint32_t index = ring->head;
+    LogRecord* record = &ring->records[index & RING_INDEX_MASK];
+    record->time_us = time_us_32();
+    record->fmt_id = static_cast<uint16_t>(fmt_id);
+    record->arg_count = static_cast<uint8_t>(arg_count);
+    record->args[0] = a0;
+    record->args[1] = a1;
+    record->args[2] = a2;
+    record->args[3] = a3;
+
+    __dmb();
+    ring->head = index + 1u;
+
+    restore_interrupts(irq_state);
+}
+
+bool spine_log_init() {
+    s_enabled = false;
+    for (uint32_t c = 0; c < LOG_CORE_COUNT; ++c) {
+        s_rings[c].head = 0;
+        s_read[c] = 0;
+        s_gap[c] = false;
+    }
+
+    const std::size_t table_len = static_cast<std::size_t>(__stop_spine_log_fmt - __start_spine_log_fmt);
+    if (table_len > LOG_MAX_TABLE_BYTES) {
+        return false;
+    }
+    s_table_crc32 = proto::proto_crc32_iso_hdlc(reinterpret_cast<const uint8_t*>(__start_spine_log_fmt),
+                                                table_len);
+    s_enabled = true;
+
+    SPINE_LOG("spine.log.table_bytes=%u spine.log.table_crc32=0x%08x",
+              static_cast<uint32_t>(table_len), s_table_crc32);
+    return true;
+}
+
+/*
+ * Build one frame from core `core`'s unread records, oldest first.
+ * Records are validated against the head after copying, as in the event
+ * log dump; records already lapped are skipped and counted. Returns false
+ * if there was nothing to send or the link refused the frame (the read
+ * cursor then stays put).
+ */
+static bool drain_core_frame(uint32_t core) {
+    const LogRing* ring = &s_rings[core];
+    uint8_t payload[LOG_MAX_PAYLOAD_BYTES];
+
+    uint32_t next = s_read[core];
+    uint32_t lost = 0;
+    bool gap = s_gap[core];
+    uint32_t count = 0;
+    std::size_t fill = LOG_FRAME_HEADER_BYTES;
+
+    const uint32_t end = ring->head;
+    __dmb();
+
+    while (next != end) {
+        const LogRecord record = ring->records[next & RING_INDEX_MASK];
+        __dmb();
+        const uint32_t head = ring->head;
+
+        if (head - next >= LOG_RECORDS_PER_CORE) {
+            if (count > 0u) {
+                break;  // records in a frame stay contiguous
+            }
+            const uint32_t oldest = head - LOG_RECORDS_PER_CORE + 1u;
+            lost += oldest - next;
+            next = oldest;
+            gap = true;
+            // end may now be behind next; re-read on the next frame.
+            if (end - next > LOG_RECORDS_PER_CORE) {
+                break;
+            }
+            continue;
+        }
+
+        const uint32_t arg_count = (record.arg_count <= SPINE_LOG_MAX_ARGS) ? record.arg_count : 0u;
+        const std::size_t record_len = LOG_RECORD_HEADER_BYTES + arg_count * 4u;
+        if (fill + record_len > sizeof(payload) || count == UINT8_MAX) {
+            break;
+        }
+
+        uint8_t* out = payload + fill;
+        proto::put_u32_le(out + LOG_RECORD_OFFSET_TIME_US, record.time_us);
+        proto::put_u16_le(out + LOG_RECORD_OFFSET_FMT_ID, record.fmt_id);
+        out[LOG_RECORD_OFFSET_ARG_COUNT] = static_cast<uint8_t>(arg_count);
+        out[LOG_RECORD_OFFSET_ARG_COUNT + 1u] = 0u;
+        for (uint32_t i = 0; i < arg_count; ++i) {
+            proto::put_u32_le(out + LOG_RECORD_OFFSET_ARGS + i * 4u, record.args[i]);
+        }
+        fill += record_len;
+        count++;
+        next++;
+    }
+
+    if (count == 0u) {
+        // Only skipped records: remember the loss for the next frame.
+        s_read[core] = next;
+        s_gap[core] = gap;
+        s_lost_record_count = s_lost_record_count + lost;
+        return false;
+    }
+
+    payload[LOG_OFFSET_LAYOUT_VERSION] = LOG_LAYOUT_VERSION;
+    payload[LOG_OFFSET_CORE] = static_cast<uint8_t>(core);
+    payload[LOG_OFFSET_RECORD_COUNT] = static_cast<uint8_t>(count);
+    payload[LOG_OFFSET_FLAGS] = gap ? LOG_FLAG_GAP : 0u;
+    proto::put_u32_le(payload + LOG_OFFSET_TABLE_CRC32, s_table_crc32);
+    proto::put_u32_le(payload + LOG_OFFSET_FIRST_INDEX, next - count);
+
+    std::size_t frame_len = 0;
+    if (proto::proto_packet_encode(s_frame, sizeof(s_frame), &frame_len, proto::MSG_ID_S2B_LOG,
+                                   0u, s_seq, payload, fill) != proto::EncodeStatus::OK ||
+        !spine_link_tx_send(s_frame, frame_len)) {
+        return false;
+    }
+
+    s_seq++;
+    s_read[core] = next;
+    s_gap[core] = false;
+    s_frame_count = s_frame_count + 1u;
+    s_lost_record_count = s_lost_record_count + lost;
+    return true;
+}
+
+void spine_log_drain() {
+    uint32_t frames = 0;
+    for (uint32_t core = 0; core < LOG_CORE_COUNT; ++core) {
+        while (frames < LOG_DRAIN_FRAMES_PER_RUN && drain_core_frame(core)) {
+            frames++;
+        }
+    }
+}
+
+static void run_log_drain(void* ctx) {
+    (void)ctx;
+    spine_log_drain();
+}
+
+static PeriodicTask s_drain_task = {
+    "log_drain", LOG_DRAIN_PERIOD_US, LOG_DRAIN_BUDGET_US, run_log_drain, nullptr, 1u
+};
+
+bool spine_log_start_drain_task() {
+    return spine_timing_add_periodic_task(&s_drain_task);
+}
+
+void spine_log_get_counters(LogCounters* out) {
+    if (out == nullptr) {
+        return;
+    }
+    for (uint32_t c = 0; c < LOG_CORE_COUNT; ++c) {
+        out->recorded_count[c] = s_rings[c].head;
+    }
+    out->frame_count = s_frame_count;
+    out->lost_record_count = s_lost_record_count;
+    out->table_crc32 = s_table_crc32;
+}
+
+} // namespace spine
+
+extern "C" {
+
+void spine_log_write0(uint32_t fmt_id) {
+    spine::log_append(fmt_id, 0u, 0u, 0u, 0u, 0u);
+}
+
+void spine_log_write1(uint32_t fmt_id, uint32_t a0) {
+    spine::log_append(fmt_id, 1u, a0, 0u, 0u, 0u);
+}
+
+void spine_log_write2(uint32_t fmt_id, uint32_t a0, uint32_t a1) {
+    spine::log_append(fmt_id, 2u, a0, a1, 0u, 0u);
+}
+
+void spine_log_write3(uint32_t fmt_id, uint32_t a0, uint32_t a1, uint32_t a2) {
+    spine::log_append(fmt_id, 3u, a0, a1, a2, 0u);
+}
+
+void spine_log_write4(uint32_t fmt_id, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+    spine::log_append(fmt_id, 4u, a0, a1, a2, a3);
+}
+
+} // extern "C"
@@ -0,0 +1,162 @@
+#ifndef SPINE_LOG_H
+#define SPINE_LOG_H
+
+#include <stdint.h>
+
+/*
+ * Deferred-format logging (C and C++).
+ *
+ *   SPINE_LOG("spine.link.mailbox_dropped_count=%u", count);
+ *
+ * The format string never reaches the Spine's CPU at run time. The macro
+ * places it in the spine_log_fmt section; its offset there is the format
+ * ID. A call stores the ID, a timestamp and up to SPINE_LOG_MAX_ARGS raw
+ * 32-bit arguments in the calling core's log ring: a timer read and a
+ * handful of stores with that core's interrupts masked. It never formats,
+ * never touches USB and never blocks.
+ *
+ * The core1 task "log_drain" streams new records as S2B_LOG frames
+ * (diagnostic extension) whenever the link has room. If a ring laps its
+ * reader the oldest records are lost, counted and flagged in the next
+ * frame; logging itself never waits for the link.
+ *
+ * Text is rebuilt on the Brain (link_log_tool) from the section bytes,
+ * extracted at build time next to the firmware as scout_spine.logfmt.
+ * Every frame carries the CRC32 of the table so a stale table is
+ * detected, not misdecoded.
+ *
+ * Arguments: integers only (%d %i %u %x %X %o %c, with flags and width).
+ * There is no %s: a string's bytes are not in the table. Any core, thread
+ * or IRQ context. GNU toolchains only (section attribute, __start_ symbol).
+ */
+
+#define SPINE_LOG_MAX_ARGS 4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Start of the format section (linker-provided).
+extern const char __start_spine_log_fmt[];
+
+void spine_log_write0(uint32_t fmt_id);
+void spine_log_write1(uint32_t fmt_id, uint32_t a0);
+void spine_log_write2(uint32_t fmt_id, uint32_t a0, uint32_t a1);
+void spine_log_write3(uint32_t fmt_id, uint32_t a0, uint32_t a1, uint32_t a2);
+void spine_log_write4(uint32_t fmt_id, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define SPINE_LOG_CALL_(n, fmt, ...)                                                  \
+    do {                                                                              \
+        static const char spine_log_fmt_[]                                            \
+            __attribute__((section("spine_log_fmt"), used)) = fmt;                    \
+        spine_log_write##n((uint32_t)(spine_log_fmt_ - __start_spine_log_fmt), ##__VA_ARGS__); \
+    } while (0)
+
+#define SPINE_LOG_0_(fmt)             SPINE_LOG_CALL_(0, fmt)
+#define SPINE_LOG_1_(fmt, a)          SPINE_LOG_CALL_(1, fmt, (uint32_t)(a))
+#define SPINE_LOG_2_(fmt, a, b)       SPINE_LOG_CALL_(2, fmt, (uint32_t)(a), (uint32_t)(b))
+#define SPINE_LOG_3_(fmt, a, b, c)    SPINE_LOG_CALL_(3, fmt, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c))
+#define SPINE_LOG_4_(fmt, a, b, c, d) SPINE_LOG_CALL_(4, fmt, (uint32_t)(a), (uint32_t)(b), (uint32_t)(c), (uint32_t)(d))
+
+#define SPINE_LOG_PICK_(fmt, a, b, c, d, name, ...) name
+
+// More than SPINE_LOG_MAX_ARGS arguments does not compile.
+#define SPINE_LOG(...) \
+    SPINE_LOG_PICK_(__VA_ARGS__, SPINE_LOG_4_, SPINE_LOG_3_, SPINE_LOG_2_, SPINE_LOG_1_, SPINE_LOG_0_, _)(__VA_ARGS__)
+
+#ifdef __cplusplus
+
+#include <cstddef>
+
+#include "proto_constants.h"
+#include "spine_link_tx.h"
+#include "spine_timing.h"
+
+namespace spine {
+
+// Records per core. Power of two: the slot is index & (count - 1).
+static constexpr uint32_t LOG_RECORDS_PER_CORE = 64u;
+static constexpr uint32_t LOG_CORE_COUNT = 2u;
+
+static_assert((LOG_RECORDS_PER_CORE & (LOG_RECORDS_PER_CORE - 1u)) == 0u,
+              "LOG_RECORDS_PER_CORE must be a power of two");
+
+/*
+ * S2B_LOG payload, layout version 1 (little-endian):
+ *
+ *   0   layout_version  u8
+ *   1   core            u8
+ *   2   record_count    u8
+ *   3   flags           u8   LOG_FLAG_*
+ *   4   table_crc32     u32  CRC32 (ISO-HDLC) of the format section
+ *   8   first_index     u32  ring index of the first record (free-running)
+ *   12  records, each:
+ *         0 time_us u32, 4 fmt_id u16, 6 arg_count u8, 7 reserved u8 (0),
+ *         8 args: arg_count x u32
+ */
+static constexpr uint8_t LOG_LAYOUT_VERSION = 1u;
+
+static constexpr std::size_t LOG_OFFSET_LAYOUT_VERSION = 0u;
+static constexpr std::size_t LOG_OFFSET_CORE           = 1u;
+static constexpr std::size_t LOG_OFFSET_RECORD_COUNT   = 2u;
+static constexpr std::size_t LOG_OFFSET_FLAGS          = 3u;
+static constexpr std::size_t LOG_OFFSET_TABLE_CRC32    = 4u;
+static constexpr std::size_t LOG_OFFSET_FIRST_INDEX    = 8u;
+static constexpr std::size_t LOG_FRAME_HEADER_BYTES    = 12u;
+
+static constexpr std::size_t LOG_RECORD_OFFSET_TIME_US   = 0u;
+static constexpr std::size_t LOG_RECORD_OFFSET_FMT_ID    = 4u;
+static constexpr std::size_t LOG_RECORD_OFFSET_ARG_COUNT = 6u;
+static constexpr std::size_t LOG_RECORD_OFFSET_ARGS      = 8u;
+static constexpr std::size_t LOG_RECORD_HEADER_BYTES     = 8u;
+
+static constexpr uint8_t LOG_FLAG_GAP = 0x02u;  // records lost before this frame
+
+// Format IDs travel as u16: the section must stay below 64 KiB.
+static constexpr std::size_t LOG_MAX_TABLE_BYTES = 0x10000u;
+
+static constexpr std::size_t LOG_MAX_PAYLOAD_BYTES =
+    LINK_TX_MAX_FRAME_BYTES - proto::MIN_PACKET_SIZE_BYTES;
+
+static constexpr uint32_t LOG_DRAIN_PERIOD_US      = 10u * US_PER_MS;
+static constexpr uint32_t LOG_DRAIN_BUDGET_US      = 1u * US_PER_MS;
+static constexpr uint32_t LOG_DRAIN_FRAMES_PER_RUN = 4u;
+
+struct LogCounters {
+    uint32_t recorded_count[LOG_CORE_COUNT];  // records written since boot
+    uint32_t frame_count;                     // S2B_LOG frames sent
+    uint32_t lost_record_count;               // overwritten before sent
+    uint32_t table_crc32;
+};
+
+/*
+ * Reset both rings and checksum the format table. Call once on core0
+ * before anything logs. Returns false (and logging stays off) if the
+ * table is too large for u16 IDs.
+ */
+bool spine_log_init();
+
+/*
+ * Register the core1 drain task. Call from core0 after spine_timing_init()
+ * and before spine_runtime_start_link_core().
+ */
+bool spine_log_start_drain_task();
+
+/*
+ * Send pending records, at most LOG_DRAIN_FRAMES_PER_RUN frames. The drain
+ * task body; also for a core0 that is the only CDC writer left (core1 not
+ * running, e.g. a failed boot).
+ */
+void spine_log_drain();
+
+void spine_log_get_counters(LogCounters* out);
+
+} // namespace spine
+
+#endif // __cplusplus
+
+#endif // SPINE_LOG_H
@@ -0,0 +1,169 @@
+#include "spine_runtime.h"
+#include "spine_ack.h"
+#include "spine_event_log.h"
+#include "spine_link_rx.h"
+#include "spine_timing.h"
+
+#include <cstring>
+
+#if defined(PROTO_CRC32_BACKEND_DMA)
+#include "proto_crc_dma.h"
+#endif
+
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+#include "pico/stdlib.h"
+#include "tusb.h"
+
+namespace spine {
+
+static constexpr uint32_t CORE_COUNT = 2u;
+
+struct MailboxSlot {
+    uint16_t packet_len;
+    uint8_t  packet[proto::FRAMER_BUFFER_SIZE_BYTES];
+};
+
+/*
+ * SPSC ring. head is written only by core1 (producer), tail only by
+ * core0 (consumer). Free-running counters; slot = counter % SLOT_COUNT.
+ */
+static MailboxSlot s_mailbox[MAILBOX_SLOT_COUNT];
+static volatile uint32_t s_mailbox_head = 0;
+static volatile uint32_t s_mailbox_tail = 0;
+
+static volatile uint32_t s_mailbox_posted_count = 0;
+static volatile uint32_t s_mailbox_dropped_count = 0;
+static volatile uint32_t s_mailbox_delivered_count = 0;
+
+struct CoreLoad {
+    uint32_t window_start_us;
+    uint32_t busy_us;
+    volatile uint32_t load_permille;
+};
+
+// Each entry is written only by its own core.
+static CoreLoad s_core_load[CORE_COUNT];
+
+/*
+ * core1: FramerPacketCallback. Copies the validated packet into the
+ * mailbox or drops it if core0 has not caught up.
+ */
+static void mailbox_post(const uint8_t* packet, std::size_t packet_len, void* ctx) {
+    (void)ctx;
+
+    const uint32_t head = s_mailbox_head;
+    const uint32_t tail = s_mailbox_tail;
+
+    if (head - tail >= MAILBOX_SLOT_COUNT || packet_len > proto::FRAMER_BUFFER_SIZE_BYTES) {
+        s_mailbox_dropped_count = s_mailbox_dropped_count + 1u;
+        spine_event_log_record(EVENT_MAILBOX_DROP, static_cast<uint32_t>(packet_len), head - tail);
+        return;
+    }
+
+    MailboxSlot* slot = &s_mailbox[head % MAILBOX_SLOT_COUNT];
+    std::memcpy(slot->packet, packet, packet_len);
+    slot->packet_len = static_cast<uint16_t>(packet_len);
+
+    // Publish the slot contents before the index that makes them visible.
+    __dmb();
+    s_mailbox_head = head + 1u;
+    s_mailbox_posted_count = s_mailbox_posted_count + 1u;
+}
+
+uint32_t spine_runtime_drain_mailbox(proto::FramerPacketCallback callback, void* callback_ctx) {
+    if (callback == nullptr) {
+        return 0;
+    }
+
+    uint32_t delivered = 0;
+
+    while (delivered < MAILBOX_SLOT_COUNT) {
+        const uint32_t tail = s_mailbox_tail;
+        if (tail == s_mailbox_head) {
+            break;
+        }
+        __dmb();
+
+        const MailboxSlot* slot = &s_mailbox[tail % MAILBOX_SLOT_COUNT];
+        callback(slot->packet, slot->packet_len, callback_ctx);
+
+        // Finish reading the slot before handing it back to the producer.
+        __dmb();
+        s_mailbox_tail = tail + 1u;
+        delivered++;
+    }
+
+    s_mailbox_delivered_count = s_mailbox_delivered_count + delivered;
+    return delivered;
+}
+
+void spine_runtime_account_pass(uint32_t busy_us) {
+    CoreLoad* load = &s_core_load[get_core_num()];
+    const uint32_t now_us = time_us_32();
+
+    load->busy_us += busy_us;
+
+    const uint32_t window_us = now_us - load->window_start_us;
+    if (window_us < CORE_LOAD_WINDOW_US) {
+        return;
+    }
+
+    const uint64_t permille =
+        (static_cast<uint64_t>(load->busy_us) * LOAD_PERMILLE_FULL) / window_us;
+    load->load_permille = (permille > LOAD_PERMILLE_FULL) ? LOAD_PERMILLE_FULL
+                                                          : static_cast<uint32_t>(permille);
+    load->busy_us = 0;
+    load->window_start_us = now_us;
+}
+
+/*
+ * core1 entry. Each pass is bounded: the USB device task (which runs
+ * tud_cdc_rx_cb), at most LINK_RX_MAX_BYTES_PER_POLL bytes of framing,
+ * the queued S2B_ACKs, then each due core1 task once. ACKs go every pass
+ * rather than from a periodic task so a round-trip probe measures the
+ * link, not a task period.
+ *
+ * This core is the only TinyUSB user: tusb_init() here routes the USB
+ * IRQ to core1, and every CDC read and write happens in this loop.
+ */
+static void link_core_main() {
+    s_core_load[1].window_start_us = time_us_32();
+    tusb_init();
+
+#if defined(PROTO_CRC32_BACKEND_DMA)
+    // Payload CRC32 runs on this core only, so the sniffer belongs here.
+    // On failure proto_crc32_iso_hdlc keeps using the software path.
+    proto::proto_crc32_dma_init();
+#endif
+
+    while (true) {
+        const uint32_t start_us = time_us_32();
+        tud_task();
+        const uint32_t rx_bytes = spine_link_rx_poll();
+        const uint32_t acks_sent = spine_ack_service();
+        const uint32_t tasks_run = spine_timing_run_due_tasks();
+        const uint32_t elapsed_us = time_us_32() - start_us;
+
+        spine_runtime_account_pass((rx_bytes > 0u || acks_sent > 0u || tasks_run > 0u) ? elapsed_us : 0u);
+    }
+}
+
+void spine_runtime_start_link_core() {
+    s_core_load[0].window_start_us = time_us_32();
+    spine_link_rx_init(mailbox_post, nullptr);
+    multicore_launch_core1(link_core_main);
+}
+
+void spine_runtime_get_counters(RuntimeCounters* out) {
+    if (out == nullptr) {
+        return;
+    }
+    out->mailbox_posted_count = s_mailbox_posted_count;
+    out->mailbox_dropped_count = s_mailbox_dropped_count;
+    out->mailbox_delivered_count = s_mailbox_delivered_count;
+    out->core0_load_permille = s_core_load[0].load_permille;
+    out->core1_load_permille = s_core_load[1].load_permille;
+}
+
+} // namespace spine
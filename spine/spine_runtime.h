@@ -0,0 +1,77 @@
+#ifndef SPINE_RUNTIME_H
+#define SPINE_RUNTIME_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "proto_framer.h"
+
+namespace spine {
+
+/*
+ * Dual-core runtime split.
+ *
+ * Core ownership (fixed at boot, never migrated):
+ *
+ *   core0 — safety and motion
+ *     - hold-timeout alarm pool and its IRQ (spine_timing)
+ *     - Spine state (spine_safety)
+ *     - dispatch of validated packets drained from the mailbox
+ *     - core0 periodic tasks
+ *
+ *   core1 — link and presentation
+ *     - transport receive, framing, header CRC16 and payload CRC32
+ *     - core1 periodic tasks (OLED status, telemetry, log drain)
+ *
+ * The only data crossing cores is:
+ *   - validated packets, core1 -> core0, through a single-producer /
+ *     single-consumer mailbox (copied; no shared ownership)
+ *   - PeriodicTask::due flags (single aligned word stores)
+ *   - read-only counters for telemetry
+ *
+ * A full mailbox drops the newest packet and counts it. core1 never waits
+ * on core0 and core0 never waits on core1. A dropped B2S_HEARTBEAT can only
+ * shorten the time to SAFE, never extend it.
+ */
+
+// Validated packets in flight between cores. At the contract heartbeat
+// rate one slot suffices; the rest absorb bursts while core0 runs a task.
+static constexpr uint32_t MAILBOX_SLOT_COUNT = 4u;
+
+// Window over which per-core utilization is computed.
+static constexpr uint32_t CORE_LOAD_WINDOW_US = 1000u * 1000u;
+
+// Utilization is reported in parts per thousand of wall time.
+static constexpr uint32_t LOAD_PERMILLE_FULL = 1000u;
+
+struct RuntimeCounters {
+    uint32_t mailbox_posted_count;
+    uint32_t mailbox_dropped_count;
+    uint32_t mailbox_delivered_count;
+    uint32_t core0_load_permille;
+    uint32_t core1_load_permille;
+};
+
+/*
+ * Launch core1 running the link receive loop. Call once from core0 after
+ * every core1 periodic task is registered.
+ */
+void spine_runtime_start_link_core();
+
+/*
+ * core0 only. Deliver every packet currently in the mailbox to `callback`
+ * in arrival order. Bounded by MAILBOX_SLOT_COUNT. Returns packets delivered.
+ */
+uint32_t spine_runtime_drain_mailbox(proto::FramerPacketCallback callback, void* callback_ctx);
+
+/*
+ * Account one loop pass for the calling core. `busy_us` is the part of the
+ * pass spent doing work (zero for an idle pass).
+ */
+void spine_runtime_account_pass(uint32_t busy_us);
+
+void spine_runtime_get_counters(RuntimeCounters* out);
+
+} // namespace spine
+
+#endif // SPINE_RUNTIME_H
@@ -0,0 +1,49 @@
+#include "spine_safety.h"
+#include "spine_event_log.h"
+#include "proto_constants.h"
+
+namespace spine {
+
+static volatile uint8_t  s_state = proto::SPINE_STATE_INIT;
+static volatile uint16_t s_last_fault_code = proto::FAULT_CODE_NONE;
+static volatile uint32_t s_forced_safe_count = 0;
+
+void spine_safety_init() {
+    s_state = proto::SPINE_STATE_INIT;
+    s_last_fault_code = proto::FAULT_CODE_NONE;
+    s_forced_safe_count = 0;
+}
+
+void spine_safety_mark_ready() {
+    if (s_state != proto::SPINE_STATE_INIT) {
+        return;
+    }
+    s_state = proto::SPINE_STATE_SAFE;
+    spine_event_log_record(EVENT_STATE_CHANGE, proto::SPINE_STATE_INIT, proto::SPINE_STATE_SAFE);
+}
+
+void spine_safety_force_safe(uint16_t fault_code) {
+    if (s_state != proto::SPINE_STATE_ENABLED) {
+        return;
+    }
+
+    // State first: motion is revoked before anything is recorded.
+    s_state = proto::SPINE_STATE_SAFE;
+    s_last_fault_code = fault_code;
+    s_forced_safe_count = s_forced_safe_count + 1u;
+    spine_event_log_record(EVENT_FORCED_SAFE, fault_code, s_forced_safe_count);
+}
+
+uint8_t spine_safety_state() {
+    return s_state;
+}
+
+uint16_t spine_safety_last_fault_code() {
+    return s_last_fault_code;
+}
+
+uint32_t spine_safety_forced_safe_count() {
+    return s_forced_safe_count;
+}
+
+} // namespace spine
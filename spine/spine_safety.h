@@ -0,0 +1,43 @@
+#ifndef SPINE_SAFETY_H
+#define SPINE_SAFETY_H
+
+#include <cstdint>
+
+namespace spine {
+
+/*
+ * Spine safety state (Contract v0.2 Section 7).
+ *
+ * Values are the wire-level SPINE_STATE_* constants so the state can be
+ * copied into HEARTBEAT / STATE_REPORT payloads without translation.
+ *
+ * Ownership: this module is the single owner of the Spine state. Every
+ * other module reads it or requests a transition; none writes it directly.
+ *
+ * Concurrency: spine_safety_force_safe() may be called from any IRQ or
+ * either core. Each transition is a single aligned byte store. No
+ * transition performed here can ENABLE motion.
+ */
+
+void spine_safety_init();
+
+/*
+ * INIT -> SAFE once local bring-up is complete. No effect in other states.
+ */
+void spine_safety_mark_ready();
+
+/*
+ * Revoke motion enable. ENABLED -> SAFE and records `fault_code`.
+ * Safe to call from IRQ context. No effect on INIT, SAFE or FAULT.
+ */
+void spine_safety_force_safe(uint16_t fault_code);
+
+uint8_t  spine_safety_state();
+uint16_t spine_safety_last_fault_code();
+
+// Number of ENABLED -> SAFE transitions forced since boot.
+uint32_t spine_safety_forced_safe_count();
+
+} // namespace spine
+
+#endif // SPINE_SAFETY_H
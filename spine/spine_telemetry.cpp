@@ -0,0 +1,208 @@
+#include "spine_telemetry.h"
+#include "spine_link_rx.h"
+#include "spine_link_tx.h"
+#include "spine_runtime.h"
+#include "spine_safety.h"
+#include "proto_constants.h"
+#include "proto_encoder.h"
+#include "proto_framer.h"
+#include "proto_wire.h"
+
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+
+namespace spine {
+
+static constexpr uint32_t SNAPSHOT_BUFFER_COUNT = 2u;
+
+struct StateSnapshot {
+    uint32_t time_us;
+    uint8_t  state;
+    uint16_t last_fault;
+    uint32_t keepalive_count;
+    uint32_t hold_timeout_count;
+    uint32_t forced_safe_count;
+    uint32_t packet_ok_count;
+    uint32_t dropped_byte_count;
+    uint32_t mailbox_dropped_count;
+    uint16_t core0_load_permille;
+    uint16_t core1_load_permille;
+};
+
+/*
+ * Double buffer. Only core0 writes a snapshot and its sequence word; only
+ * core0 advances s_snapshot_generation. Generation g lives in buffer
+ * g % SNAPSHOT_BUFFER_COUNT, so the writer never touches the buffer the
+ * latest generation points at.
+ */
+static StateSnapshot s_snapshot[SNAPSHOT_BUFFER_COUNT];
+static volatile uint32_t s_snapshot_seq[SNAPSHOT_BUFFER_COUNT];
+static volatile uint32_t s_snapshot_generation = 0;
+
+// core1 only.
+static uint32_t s_reported_generation = 0;
+static uint16_t s_report_seq = 0;
+static uint8_t  s_report_frame[proto::FRAMER_BUFFER_SIZE_BYTES];
+
+static volatile uint32_t s_report_sent_count = 0;
+static volatile uint32_t s_report_dropped_count = 0;
+static volatile uint32_t s_report_superseded_count = 0;
+static volatile uint32_t s_snapshot_torn_count = 0;
+
+void spine_telemetry_take_snapshot() {
+    const uint32_t generation = s_snapshot_generation + 1u;
+    const uint32_t index = generation % SNAPSHOT_BUFFER_COUNT;
+
+    TimingMetrics timing;
+    spine_timing_get_metrics(&timing);
+    RuntimeCounters runtime;
+    spine_runtime_get_counters(&runtime);
+    const proto::Framer* framer = spine_link_rx_framer();
+
+    // Odd: a reader that sees this (or sees it change) retries.
+    s_snapshot_seq[index] = s_snapshot_seq[index] + 1u;
+    __dmb();
+
+    StateSnapshot* snap = &s_snapshot[index];
+    snap->time_us = time_us_32();
+    snap->state = spine_safety_state();
+    snap->last_fault = spine_safety_last_fault_code();
+    snap->keepalive_count = timing.keepalive_count;
+    snap->hold_timeout_count = timing.hold_timeout_count;
+    snap->forced_safe_count = spine_safety_forced_safe_count();
+    snap->packet_ok_count = framer->packet_ok_count;
+    snap->dropped_byte_count = framer->dropped_byte_count;
+    snap->mailbox_dropped_count = runtime.mailbox_dropped_count;
+    snap->core0_load_permille = static_cast<uint16_t>(runtime.core0_load_permille);
+    snap->core1_load_permille = static_cast<uint16_t>(runtime.core1_load_permille);
+
+    __dmb();
+    s_snapshot_seq[index] = s_snapshot_seq[index] + 1u;
+
+    // Publish the generation only once its buffer is complete.
+    __dmb();
+    s_snapshot_generation = generation;
+}
+
+/*
+ * Copy the latest snapshot. Returns its generation, or 0 if nothing
+ * consistent could be read within STATE_SNAPSHOT_READ_MAX_ATTEMPTS.
+ */
+static uint32_t read_latest_snapshot(StateSnapshot* out) {
+    for (uint32_t attempt = 0; attempt < STATE_SNAPSHOT_READ_MAX_ATTEMPTS; ++attempt) {
+        const uint32_t generation = s_snapshot_generation;
+        __dmb();
+
+        const uint32_t index = generation % SNAPSHOT_BUFFER_COUNT;
+        const uint32_t seq_before = s_snapshot_seq[index];
+        if ((seq_before & 1u) != 0u) {
+            continue;
+        }
+        __dmb();
+
+        *out = s_snapshot[index];
+
+        __dmb();
+        if (s_snapshot_seq[index] == seq_before) {
+            return generation;
+        }
+    }
+    return 0u;
+}
+
+static void encode_payload(const StateSnapshot& snap, uint8_t* payload) {
+    payload[STATE_REPORT_OFFSET_LAYOUT_VERSION] = STATE_REPORT_LAYOUT_VERSION;
+    payload[STATE_REPORT_OFFSET_STATE] = snap.state;
+    proto::put_u16_le(payload + STATE_REPORT_OFFSET_LAST_FAULT, snap.last_fault);
+    proto::put_u32_le(payload + STATE_REPORT_OFFSET_SNAPSHOT_TIME_US, snap.time_us);
+    proto::put_u32_le(payload + STATE_REPORT_OFFSET_KEEPALIVE_COUNT, snap.keepalive_count);
+    proto::put_u32_le(payload + STATE_REPORT_OFFSET_HOLD_TIMEOUT_COUNT, snap.hold_timeout_count);
+    proto::put_u32_le(payload + STATE_REPORT_OFFSET_FORCED_SAFE_COUNT, snap.forced_safe_count);
+    proto::put_u32_le(payload + STATE_REPORT_OFFSET_PACKET_OK_COUNT, snap.packet_ok_count);
+    proto::put_u32_le(payload + STATE_REPORT_OFFSET_DROPPED_BYTE_COUNT, snap.dropped_byte_count);
+    proto::put_u32_le(payload + STATE_REPORT_OFFSET_MAILBOX_DROP_COUNT, snap.mailbox_dropped_count);
+    proto::put_u16_le(payload + STATE_REPORT_OFFSET_CORE0_LOAD_PERMILLE, snap.core0_load_permille);
+    proto::put_u16_le(payload + STATE_REPORT_OFFSET_CORE1_LOAD_PERMILLE, snap.core1_load_permille);
+    proto::put_u32_le(payload + STATE_REPORT_OFFSET_REPORT_DROP_COUNT, s_report_dropped_count);
+}
+
+void spine_telemetry_send_report() {
+    StateSnapshot snap;
+    const uint32_t generation = read_latest_snapshot(&snap);
+    if (generation == 0u) {
+        // Nothing published yet, or every attempt overlapped a write.
+        if (s_snapshot_generation != 0u) {
+            s_snapshot_torn_count = s_snapshot_torn_count + 1u;
+        }
+        return;
+    }
+    if (generation == s_reported_generation) {
+        return;  // core0 has not produced a new one yet
+    }
+    if (s_reported_generation != 0u && generation - s_reported_generation > 1u) {
+        s_report_superseded_count =
+            s_report_superseded_count + (generation - s_reported_generation - 1u);
+    }
+    s_reported_generation = generation;
+
+    uint8_t payload[STATE_REPORT_PAYLOAD_SIZE_BYTES];
+    encode_payload(snap, payload);
+
+    std::size_t frame_len = 0;
+    const proto::EncodeStatus status =
+        proto::proto_packet_encode(s_report_frame, sizeof(s_report_frame), &frame_len,
+                                   proto::MSG_ID_S2B_STATE_REPORT, 0u, s_report_seq,
+                                   payload, sizeof(payload));
+    s_report_seq++;
+    if (status != proto::EncodeStatus::OK) {
+        s_report_dropped_count = s_report_dropped_count + 1u;
+        return;
+    }
+
+    if (spine_link_tx_send(s_report_frame, frame_len)) {
+        s_report_sent_count = s_report_sent_count + 1u;
+    } else {
+        s_report_dropped_count = s_report_dropped_count + 1u;
+    }
+}
+
+static void run_state_snapshot(void* ctx) {
+    (void)ctx;
+    spine_telemetry_take_snapshot();
+}
+
+static void run_state_report(void* ctx) {
+    (void)ctx;
+    spine_telemetry_send_report();
+}
+
+static PeriodicTask s_snapshot_task = {
+    "state_snapshot", STATE_REPORT_PERIOD_US, STATE_SNAPSHOT_BUDGET_US, run_state_snapshot, nullptr, 0u
+};
+static PeriodicTask s_report_task = {
+    "state_report", STATE_REPORT_PERIOD_US, STATE_REPORT_BUDGET_US, run_state_report, nullptr, 1u
+};
+
+bool spine_telemetry_init(uint32_t period_us) {
+    if (period_us < STATE_REPORT_MIN_PERIOD_US) {
+        period_us = STATE_REPORT_MIN_PERIOD_US;
+    }
+    s_snapshot_task.period_us = period_us;
+    s_report_task.period_us = period_us;
+
+    return spine_timing_add_periodic_task(&s_snapshot_task) &&
+           spine_timing_add_periodic_task(&s_report_task);
+}
+
+void spine_telemetry_get_counters(TelemetryCounters* out) {
+    if (out == nullptr) {
+        return;
+    }
+    out->snapshot_count = s_snapshot_generation;
+    out->report_sent_count = s_report_sent_count;
+    out->report_dropped_count = s_report_dropped_count;
+    out->report_superseded_count = s_report_superseded_count;
+    out->snapshot_torn_count = s_snapshot_torn_count;
+}
+
+} // namespace spine
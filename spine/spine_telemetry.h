@@ -0,0 +1,101 @@
+#ifndef SPINE_TELEMETRY_H
+#define SPINE_TELEMETRY_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "spine_timing.h"
+
+namespace spine {
+
+/*
+ * S2B_STATE_REPORT streamer.
+ *
+ * Two periodic tasks at the same period:
+ *
+ *   core0 "state_snapshot"  copies the Spine state and counters into one
+ *                           half of a double buffer and publishes it.
+ *                           A few dozen loads and stores; never waits.
+ *
+ *   core1 "state_report"    takes the latest published snapshot, encodes
+ *                           S2B_STATE_REPORT (CRCs run on core1, which owns
+ *                           the CRC DMA channel) and hands it to
+ *                           spine_link_tx_send.
+ *
+ * Neither side blocks the other: the snapshot writer always writes the
+ * half the reader is not pointed at, and each half carries a sequence
+ * word (odd while being written) so a read that overlapped a write is
+ * detected and retried a bounded number of times.
+ *
+ * When the CDC TX FIFO has no room the report is dropped and counted;
+ * seq still advances, so the Brain sees the loss as a seq gap. A snapshot
+ * replaced before core1 got to it is counted as superseded.
+ *
+ * Period: Contract v0.2 fixes STATE_REPORT at 750 ms. Shorter periods (down
+ * to 1 ms, 1 kHz) are for tuning sessions with a Brain that expects them.
+ */
+
+// Contract v0.2 Section 9.
+static constexpr uint32_t STATE_REPORT_PERIOD_US = 750u * US_PER_MS;
+
+// Fastest supported rate (1 kHz).
+static constexpr uint32_t STATE_REPORT_MIN_PERIOD_US = 1u * US_PER_MS;
+
+static constexpr uint32_t STATE_SNAPSHOT_BUDGET_US = 50u;
+static constexpr uint32_t STATE_REPORT_BUDGET_US   = 200u;
+
+// Attempts to read a consistent snapshot before giving up on this period.
+static constexpr uint32_t STATE_SNAPSHOT_READ_MAX_ATTEMPTS = 3u;
+
+/*
+ * STATE_REPORT payload, layout version 1 (little-endian).
+ *
+ * The contract names the message but does not define its payload; this is
+ * the Spine's layout until it does. layout_version changes whenever a field
+ * moves. All counters wrap silently.
+ */
+static constexpr uint8_t STATE_REPORT_LAYOUT_VERSION = 1u;
+
+static constexpr std::size_t STATE_REPORT_OFFSET_LAYOUT_VERSION      = 0u;  // u8
+static constexpr std::size_t STATE_REPORT_OFFSET_STATE               = 1u;  // u8  SPINE_STATE_*
+static constexpr std::size_t STATE_REPORT_OFFSET_LAST_FAULT          = 2u;  // u16 FAULT_CODE_*
+static constexpr std::size_t STATE_REPORT_OFFSET_SNAPSHOT_TIME_US    = 4u;  // u32 time_us_32()
+static constexpr std::size_t STATE_REPORT_OFFSET_KEEPALIVE_COUNT     = 8u;  // u32
+static constexpr std::size_t STATE_REPORT_OFFSET_HOLD_TIMEOUT_COUNT  = 12u; // u32
+static constexpr std::size_t STATE_REPORT_OFFSET_FORCED_SAFE_COUNT   = 16u; // u32
+static constexpr std::size_t STATE_REPORT_OFFSET_PACKET_OK_COUNT     = 20u; // u32
+static constexpr std::size_t STATE_REPORT_OFFSET_DROPPED_BYTE_COUNT  = 24u; // u32
+static constexpr std::size_t STATE_REPORT_OFFSET_MAILBOX_DROP_COUNT  = 28u; // u32
+static constexpr std::size_t STATE_REPORT_OFFSET_CORE0_LOAD_PERMILLE = 32u; // u16
+static constexpr std::size_t STATE_REPORT_OFFSET_CORE1_LOAD_PERMILLE = 34u; // u16
+static constexpr std::size_t STATE_REPORT_OFFSET_REPORT_DROP_COUNT   = 36u; // u32
+static constexpr std::size_t STATE_REPORT_PAYLOAD_SIZE_BYTES         = 40u;
+
+struct TelemetryCounters {
+    uint32_t snapshot_count;           // snapshots published (core0)
+    uint32_t report_sent_count;        // reports accepted by the link
+    uint32_t report_dropped_count;     // reports refused: link backed up
+    uint32_t report_superseded_count;  // snapshots never reported
+    uint32_t snapshot_torn_count;      // periods skipped: no consistent read
+};
+
+/*
+ * Register the two streamer tasks. Call from core0 after
+ * spine_timing_init() and before spine_runtime_start_link_core().
+ * period_us below STATE_REPORT_MIN_PERIOD_US is raised to it.
+ */
+bool spine_telemetry_init(uint32_t period_us);
+
+/*
+ * The task bodies, exposed for host simulations that drive both sides
+ * directly. spine_telemetry_take_snapshot() is core0 only,
+ * spine_telemetry_send_report() core1 only.
+ */
+void spine_telemetry_take_snapshot();
+void spine_telemetry_send_report();
+
+void spine_telemetry_get_counters(TelemetryCounters* out);
+
+} // namespace spine
+
+#endif // SPINE_TELEMETRY_H
@@ -0,0 +1,175 @@
+#include "spine_timing.h"
+#include "spine_event_log.h"
+#include "spine_safety.h"
+#include "proto_constants.h"
+
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+
+namespace spine {
+
+static constexpr uint32_t MAX_PERIODIC_TASKS = TIMING_MAX_TIMERS - 1u;
+
+static alarm_pool_t* s_pool = nullptr;
+static uint32_t s_hold_timeout_us = DEFAULT_HOLD_TIMEOUT_US;
+
+// Written in thread context with IRQs disabled; read in the alarm IRQ.
+static volatile alarm_id_t s_hold_alarm_id = 0;
+static volatile uint64_t   s_hold_deadline_us = 0;
+
+static volatile uint32_t s_keepalive_count = 0;
+static volatile uint32_t s_hold_timeout_count = 0;
+static volatile uint32_t s_timeout_to_safe_last_us = 0;
+static volatile uint32_t s_timeout_to_safe_max_us = 0;
+
+static PeriodicTask* s_tasks[MAX_PERIODIC_TASKS];
+static uint32_t s_task_count = 0;
+
+/*
+ * Hold alarm expiry (alarm IRQ on the core that created the pool).
+ *
+ * SAFE is forced first; latency is measured after, so the measurement
+ * includes the transition itself.
+ */
+static int64_t on_hold_timeout(alarm_id_t id, void* user_data) {
+    (void)id;
+    (void)user_data;
+
+    spine_safety_force_safe(proto::FAULT_CODE_KEEPALIVE_TIMEOUT);
+
+    const uint64_t now_us = time_us_64();
+    const uint64_t deadline_us = s_hold_deadline_us;
+    const uint32_t latency_us =
+        (now_us > deadline_us) ? static_cast<uint32_t>(now_us - deadline_us) : 0u;
+
+    s_hold_alarm_id = 0;
+    s_hold_timeout_count = s_hold_timeout_count + 1u;
+    s_timeout_to_safe_last_us = latency_us;
+    if (latency_us > s_timeout_to_safe_max_us) {
+        s_timeout_to_safe_max_us = latency_us;
+    }
+    spine_event_log_record(EVENT_HOLD_TIMEOUT, latency_us, spine_safety_state());
+
+    return 0; // one-shot
+}
+
+static bool on_task_period(repeating_timer_t* rt) {
+    PeriodicTask* task = static_cast<PeriodicTask*>(rt->user_data);
+    if (task->due) {
+        task->skipped_count++;
+    }
+    task->due = true;
+    return true; // keep repeating
+}
+
+static void hold_alarm_rearm() {
+    const uint32_t irq_state = save_and_disable_interrupts();
+
+    if (s_hold_alarm_id > 0) {
+        alarm_pool_cancel_alarm(s_pool, s_hold_alarm_id);
+    }
+
+    const uint64_t deadline_us = time_us_64() + s_hold_timeout_us;
+    s_hold_deadline_us = deadline_us;
+    s_hold_alarm_id = alarm_pool_add_alarm_at(s_pool,
+                                              from_us_since_boot(deadline_us),
+                                              on_hold_timeout,
+                                              nullptr,
+                                              true);
+
+    restore_interrupts(irq_state);
+}
+
+bool spine_timing_init(uint32_t hold_timeout_us) {
+    if (s_pool != nullptr || hold_timeout_us == 0u) {
+        return false;
+    }
+
+    s_pool = alarm_pool_create(TIMING_HARDWARE_ALARM_NUM, TIMING_MAX_TIMERS);
+    if (s_pool == nullptr) {
+        return false;
+    }
+
+    // The hold alarm must never queue behind display or USB interrupts.
+    irq_set_priority(TIMER_IRQ_0 + TIMING_HARDWARE_ALARM_NUM, PICO_HIGHEST_IRQ_PRIORITY);
+
+    s_hold_timeout_us = hold_timeout_us;
+    hold_alarm_rearm();
+    return true;
+}
+
+void spine_timing_keepalive_received() {
+    if (s_pool == nullptr) {
+        return;
+    }
+    hold_alarm_rearm();
+    s_keepalive_count = s_keepalive_count + 1u;
+}
+
+bool spine_timing_add_periodic_task(PeriodicTask* task) {
+    if (s_pool == nullptr || task == nullptr || task->run == nullptr) {
+        return false;
+    }
+    if (task->period_us == 0u || task->core_num > 1u || s_task_count >= MAX_PERIODIC_TASKS) {
+        return false;
+    }
+
+    task->due = false;
+    task->run_count = 0;
+    task->skipped_count = 0;
+    task->overrun_count = 0;
+    task->last_run_us = 0;
+    task->max_run_us = 0;
+
+    // Negative delay: period is measured start-to-start, not end-to-start.
+    const int64_t delay_us = -static_cast<int64_t>(task->period_us);
+    if (!alarm_pool_add_repeating_timer_us(s_pool, delay_us, on_task_period, task, &task->timer)) {
+        return false;
+    }
+
+    s_tasks[s_task_count++] = task;
+    return true;
+}
+
+uint32_t spine_timing_run_due_tasks() {
+    const uint32_t core_num = get_core_num();
+    uint32_t tasks_run = 0;
+
+    for (uint32_t i = 0; i < s_task_count; ++i) {
+        PeriodicTask* task = s_tasks[i];
+        if (task->core_num != core_num || !task->due) {
+            continue;
+        }
+        task->due = false;
+
+        const uint32_t start_us = time_us_32();
+        task->run(task->ctx);
+        const uint32_t elapsed_us = time_us_32() - start_us;
+
+        task->run_count++;
+        task->last_run_us = elapsed_us;
+        if (elapsed_us > task->max_run_us) {
+            task->max_run_us = elapsed_us;
+        }
+        if (elapsed_us > task->budget_us) {
+            task->overrun_count++;
+            spine_event_log_record(EVENT_TASK_OVERRUN, i, elapsed_us);
+        }
+        tasks_run++;
+    }
+
+    return tasks_run;
+}
+
+void spine_timing_get_metrics(TimingMetrics* out) {
+    if (out == nullptr) {
+        return;
+    }
+    out->keepalive_count = s_keepalive_count;
+    out->hold_timeout_count = s_hold_timeout_count;
+    out->timeout_to_safe_last_us = s_timeout_to_safe_last_us;
+    out->timeout_to_safe_max_us = s_timeout_to_safe_max_us;
+}
+
+} // namespace spine
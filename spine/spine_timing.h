@@ -0,0 +1,108 @@
+#ifndef SPINE_TIMING_H
+#define SPINE_TIMING_H
+
+#include <cstdint>
+
+#include "pico/time.h"
+
+namespace spine {
+
+/*
+ * Spine timing engine.
+ *
+ * Two services, both driven by one dedicated RP2040 hardware alarm pool:
+ *
+ * 1) Hold timeout (Contract v0.2 Sections 3.1 and 9)
+ *    A one-shot alarm is re-armed on every valid B2S_HEARTBEAT. If it
+ *    fires, the alarm IRQ itself revokes motion enable via
+ *    spine_safety_force_safe(). Enforcement never waits on the main loop.
+ *
+ * 2) Periodic tasks
+ *    Repeating timers only mark a task as due (IRQ context, no work).
+ *    Each core's loop runs its own due tasks via
+ *    spine_timing_run_due_tasks(), so blocking peripherals (OLED over I2C)
+ *    never run inside an IRQ and no loop ever sleeps.
+ *
+ * Ownership: this module owns the alarm pool and the hold alarm.
+ * PeriodicTask objects are owned by the caller and must have static
+ * lifetime once registered.
+ */
+
+// Contract v0.2 Section 9.
+static constexpr uint32_t DEFAULT_HOLD_TIMEOUT_MS = 500u;
+static constexpr uint32_t US_PER_MS = 1000u;
+static constexpr uint32_t DEFAULT_HOLD_TIMEOUT_US = DEFAULT_HOLD_TIMEOUT_MS * US_PER_MS;
+
+// Hardware alarm used by the timing pool. Alarm 3 belongs to the SDK
+// default pool (sleep_ms, add_alarm_in_ms); 2 keeps us off its queue.
+static constexpr uint32_t TIMING_HARDWARE_ALARM_NUM = 2u;
+
+// Upper bound on concurrently armed timers in the pool
+// (hold alarm + periodic tasks). The firmware registers 7 tasks; the rest
+// is headroom. Only registered tasks are scanned, so spare slots cost a
+// pointer and a pool entry each.
+static constexpr uint32_t TIMING_MAX_TIMERS = 16u;
+
+/*
+ * One unit of periodic main-loop work.
+ *
+ * Every periodic task MUST declare a time budget. Overruns are counted,
+ * never enforced by preemption.
+ */
+struct PeriodicTask {
+    const char* name;
+    uint32_t    period_us;
+    uint32_t    budget_us;
+    void      (*run)(void* ctx);
+    void*       ctx;
+    uint32_t    core_num;      // core whose loop runs this task (0 or 1)
+
+    // Engine-owned state. Zero-initialize before registration.
+    repeating_timer_t timer;
+    volatile bool     due;
+    uint32_t          run_count;
+    uint32_t          skipped_count;   // periods that elapsed while still due
+    uint32_t          overrun_count;   // runs that exceeded budget_us
+    uint32_t          last_run_us;
+    uint32_t          max_run_us;
+};
+
+struct TimingMetrics {
+    uint32_t keepalive_count;          // hold alarm re-arms
+    uint32_t hold_timeout_count;       // hold alarm expiries (any state)
+    uint32_t timeout_to_safe_last_us;  // deadline -> SAFE forced, last expiry
+    uint32_t timeout_to_safe_max_us;   // worst case since boot
+};
+
+/*
+ * Create the alarm pool and arm the first hold deadline.
+ * Silence from boot is treated exactly like silence later on.
+ */
+bool spine_timing_init(uint32_t hold_timeout_us);
+
+/*
+ * Record one valid keepalive (B2S_HEARTBEAT) and push the hold deadline
+ * out by the hold timeout. Thread context only; never re-enables motion.
+ */
+void spine_timing_keepalive_received();
+
+/*
+ * Register a task. Call from core0 before spine_runtime_start_link_core():
+ * the task table is not modified after core1 starts reading it.
+ * Returns false (task never runs) if the table or the pool is full;
+ * boot treats that as fatal.
+ */
+bool spine_timing_add_periodic_task(PeriodicTask* task);
+
+/*
+ * Run every task owned by the calling core whose period has elapsed, in
+ * registration order. Bounded by the number of registered tasks.
+ * Returns the number of tasks run.
+ */
+uint32_t spine_timing_run_due_tasks();
+
+void spine_timing_get_metrics(TimingMetrics* out);
+
+} // namespace spine
+
+#endif // SPINE_TIMING_H
@@ -0,0 +1,40 @@
+#ifndef SPINE_TUSB_CONFIG_H
+#define SPINE_TUSB_CONFIG_H
+
+/*
+ * TinyUSB device configuration for scout_spine: one CDC interface, the
+ * Brain link. The firmware owns the device stack (pico_stdio_usb is not
+ * linked): core1 calls tusb_init() and then tud_task() every loop pass,
+ * so the CDC callbacks, FIFOs and endpoints are only ever touched from
+ * that one context. Descriptors are in spine_usb_descriptors.c.
+ *
+ * The FIFO sizes are the ones pico_stdio_usb uses; spine_link_tx sizes
+ * its largest frame to the TX FIFO. The host build's tusb.h reads the
+ * same values.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CFG_TUSB_RHPORT0_MODE
+#define CFG_TUSB_RHPORT0_MODE   (OPT_MODE_DEVICE)
+#endif
+
+#define CFG_TUD_ENDPOINT0_SIZE  64
+
+#define CFG_TUD_CDC             1
+#define CFG_TUD_MSC             0
+#define CFG_TUD_HID             0
+#define CFG_TUD_MIDI            0
+#define CFG_TUD_VENDOR          0
+
+#define CFG_TUD_CDC_RX_BUFSIZE  256
+#define CFG_TUD_CDC_TX_BUFSIZE  256
+#define CFG_TUD_CDC_EP_BUFSIZE  64
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SPINE_TUSB_CONFIG_H